@@ -23,6 +23,11 @@
     CONFIG_PROP(float, NearPlane, -1000.0f, "camera.nearPlane") \
     CONFIG_PROP(float, FarPlane, 1000.0f, "camera.farPlane") \
     CONFIG_PROP_OPTIONAL(unsigned int, DefaultSeed, "worldGeneration.defaultSeed") \
+    CONFIG_PROP(std::string, GeometryCacheDirectory, "", "worldGeneration.geometryCacheDirectory") \
+    CONFIG_PROP(int, PregeneratedWorlds, 0, "worldGeneration.pregeneratedWorlds") \
+    CONFIG_PROP(int, PregenerationMemoryMB, 1024, "worldGeneration.pregenerationMemoryMB") \
+    CONFIG_PROP(int, PregenerationThreads, 1, "worldGeneration.pregenerationThreads") \
+    CONFIG_PROP(std::string, PregenerationSnapshotDirectory, "", "worldGeneration.pregenerationSnapshotDirectory") \
     CONFIG_PROP(int, ChunkSize, 1000, "world.chunkSize") \
     CONFIG_PROP(float, TileSize, 20.0f, "world.tileSize") \
     CONFIG_PROP(float, TilesPerMeter, 1.0f, "world.tilesPerMeter") \
@@ -240,6 +240,7 @@ std::unique_ptr<ChunkData> ChunkGenerator::generateChunk(
                   << tilesProcessed << " tiles" << std::endl;
     }
     
+    chunk->sampleCount = samplesPerformed;
     chunk->isLoaded = true;
     chunk->isGenerating = false;
     
@@ -62,6 +62,7 @@ struct ChunkData {
     ChunkCoord coord;                                    // Position on sphere
     glm::mat3 localTangentBasis;                        // Basis vectors for local projection
     std::unordered_map<TileCoord, TerrainData> tiles;  // Local tile data
+    int sampleCount = 0;                                // World lookups made to fill the tiles (fewer when homogeneous)
     bool isLoaded = false;
     bool isGenerating = false;
     float lastAccessTime = 0.0f;
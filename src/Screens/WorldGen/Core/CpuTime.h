@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace WorldGen {
+namespace Core {
+
+/**
+ * @brief Get the CPU time consumed by the calling thread so far.
+ * 
+ * @return uint64_t Thread CPU time in nanoseconds (0 if the platform does not report it).
+ */
+uint64_t getThreadCpuTimeNanoseconds();
+
+} // namespace Core
+} // namespace WorldGen
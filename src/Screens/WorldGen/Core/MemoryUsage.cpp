@@ -0,0 +1,40 @@
+#include "MemoryUsage.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace WorldGen {
+namespace Core {
+
+size_t getPeakResidentMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<size_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss); // Reported in bytes on macOS
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024; // Reported in kilobytes on Linux
+#endif
+#endif
+}
+
+} // namespace Core
+} // namespace WorldGen
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace WorldGen {
+namespace Core {
+
+/**
+ * @brief Get the peak resident memory of this process so far.
+ * 
+ * @return size_t Peak resident set size in bytes (0 if the platform does not report it).
+ */
+size_t getPeakResidentMemoryBytes();
+
+} // namespace Core
+} // namespace WorldGen
@@ -0,0 +1,36 @@
+#include "ThreadPriority.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#else
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace WorldGen {
+namespace Core {
+
+bool lowerCurrentThreadPriority() {
+#ifdef _WIN32
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_IDLE) != 0;
+#elif defined(__APPLE__)
+    return pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0) == 0;
+#else
+    // Linux applies nice values per thread when given a thread id
+    const id_t threadId = static_cast<id_t>(syscall(SYS_gettid));
+    return setpriority(PRIO_PROCESS, threadId, 19) == 0;
+#endif
+}
+
+} // namespace Core
+} // namespace WorldGen
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace WorldGen {
+namespace Core {
+
+/**
+ * @brief Drop the calling thread to the lowest scheduling priority.
+ * 
+ * Used for speculative work that should only run on otherwise idle cores.
+ * 
+ * @return bool True if the platform accepted the change.
+ */
+bool lowerCurrentThreadPriority();
+
+} // namespace Core
+} // namespace WorldGen
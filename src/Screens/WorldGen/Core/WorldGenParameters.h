@@ -28,6 +28,11 @@ struct PlanetParameters {
     
     // Generator properties
     int resolution = 200000; // Terrain resolution (what units are these?)
+    float distortionFactor = 0.05f; // Tile grid irregularity (0-1)
+    uint64_t distortionSeed = 0;    // Seed for tile grid distortion, independent of the world seed so geometry can be reused
+    int peakMemoryTargetMB = 4096;  // Generation memory budget; generation fails if the estimate for the resolution exceeds it
+    
+    bool operator==(const PlanetParameters&) const = default;
 };
 
 // Other parameter structures can be added here
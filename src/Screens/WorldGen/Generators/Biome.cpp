@@ -1,104 +1,36 @@
 #include "Biome.h"
 #include "World.h"
 #include "Tile.h"
+#include "TaskGraph.h"
+#include "Classification.h"
 #include "../ProgressTracker.h"
 #include "../Core/WorldGenParameters.h"
 #include <iostream>
-#include <unordered_map>
 
 namespace WorldGen {
 namespace Generators {
 
+namespace {
+
+constexpr size_t kTerrainTypeCount = static_cast<size_t>(TerrainType::Volcano) + 1;
+constexpr size_t kBiomeTypeCount = static_cast<size_t>(BiomeType::Reef) + 1;
+
+/**
+ * @brief Tiles per terrain type and per biome
+ */
+struct ClassificationCounts {
+    Histogram<kTerrainTypeCount> terrain;
+    Histogram<kBiomeTypeCount> biome;
+};
+
+} // namespace
+
 TerrainType DetermineTerrainType(float elevation, float waterLevel) {
-    // Determine terrain type based on elevation in meters from planet center
-    // waterLevel = planet radius (sea level reference)
-    if (elevation < waterLevel - 1000.0f) {
-        return TerrainType::Ocean;      // Deep ocean (>1000m below sea level)
-    } else if (elevation < waterLevel - 50.0f) {
-        return TerrainType::Shallow;    // Shallow water (50-1000m below sea level)
-    } else if (elevation < waterLevel + 50.0f) {
-        return TerrainType::Beach;      // Beach/coastal (±50m of sea level)
-    } else if (elevation < waterLevel + 1000.0f) {
-        return TerrainType::Lowland;    // Lowlands (0-1000m above sea level)
-    } else if (elevation < waterLevel + 2000.0f) {
-        return TerrainType::Highland;   // Highlands (1000-2000m above sea level)
-    } else if (elevation < waterLevel + 4000.0f) {
-        return TerrainType::Mountain;   // Mountains (2000-4000m above sea level)
-    } else {
-        return TerrainType::Peak;       // High peaks (>4000m above sea level)
-    }
+    return TerrainClassifier(waterLevel, kMeterTerrainBands).Classify(elevation);
 }
 
 BiomeType DetermineBiomeType(float elevation, float temperature, float moisture, TerrainType terrainType) {
-    // Water biomes
-    if (terrainType == TerrainType::Ocean) {
-        return BiomeType::DeepOcean;
-    } else if (terrainType == TerrainType::Shallow) {
-        if (temperature > 0.8f && moisture > 0.7f) {
-            return BiomeType::Reef; // Coral reefs in warm shallow water
-        }
-        return BiomeType::Ocean;
-    }
-    
-    // Land biomes based on temperature and moisture
-    // Using a simplified Whittaker biome classification
-    
-    // Very cold regions (tundra/ice)
-    if (temperature < 0.2f) {
-        if (elevation > 0.8f) {
-            return BiomeType::AlpineTundra;
-        } else if (moisture < 0.2f) {
-            return BiomeType::PolarDesert;
-        } else {
-            return BiomeType::ArcticTundra;
-        }
-    }
-    
-    // Cold regions (boreal/taiga)
-    if (temperature < 0.4f) {
-        if (moisture > 0.4f) {
-            return BiomeType::BorealForest;
-        } else {
-            return BiomeType::ColdDesert;
-        }
-    }
-    
-    // Temperate regions
-    if (temperature < 0.6f) {
-        if (moisture > 0.7f) {
-            return BiomeType::TemperateRainforest;
-        } else if (moisture > 0.4f) {
-            return BiomeType::TemperateDeciduousForest;
-        } else if (moisture > 0.2f) {
-            return BiomeType::TemperateGrassland;
-        } else {
-            return BiomeType::XericShrubland;
-        }
-    }
-    
-    // Warm/subtropical regions
-    if (temperature < 0.8f) {
-        if (moisture > 0.6f) {
-            return BiomeType::TropicalSeasonalForest;
-        } else if (moisture > 0.3f) {
-            return BiomeType::TropicalSavanna;
-        } else if (moisture > 0.1f) {
-            return BiomeType::SemiDesert;
-        } else {
-            return BiomeType::HotDesert;
-        }
-    }
-    
-    // Tropical regions
-    if (moisture > 0.7f) {
-        return BiomeType::TropicalRainforest;
-    } else if (moisture > 0.4f) {
-        return BiomeType::TropicalSeasonalForest;
-    } else if (moisture > 0.2f) {
-        return BiomeType::TropicalSavanna;
-    } else {
-        return BiomeType::HotDesert;
-    }
+    return BiomeClassifier::GetInstance().Classify(elevation, temperature, moisture, terrainType);
 }
 
 void GenerateBiomes(World* world, std::shared_ptr<ProgressTracker> progressTracker) {
@@ -111,68 +43,79 @@ void GenerateBiomes(World* world, std::shared_ptr<ProgressTracker> progressTrack
         progressTracker->UpdateProgress(0.0f, "Generating biomes...");
     }
     
-    const auto& tiles = world->GetTiles();
+    auto& tiles = world->GetTiles();
     // Use planet's physical radius as sea level reference
     const float waterLevel = PlanetParameters().physicalRadiusMeters;
     
     std::cout << "Generating biomes for " << tiles.size() << " tiles..." << std::endl;
     
-    // Counters for statistics
-    std::unordered_map<TerrainType, int> terrainCounts;
-    std::unordered_map<BiomeType, int> biomeCounts;
+    const TerrainClassifier terrainClassifier(waterLevel, kMeterTerrainBands);
+    const BiomeClassifier& biomeClassifier = BiomeClassifier::GetInstance();
     
-    // Process each tile
-    for (size_t i = 0; i < tiles.size(); ++i) {
-        const auto& tile = tiles[i];
-        
-        // Get environmental factors
-        float elevation = tile.GetElevation();
-        float temperature = tile.GetTemperature();
-        float moisture = tile.GetMoisture();
-        
-        // Determine terrain type based on elevation
-        TerrainType terrainType = DetermineTerrainType(elevation, waterLevel);
-        const_cast<Tile&>(tile).SetTerrainType(terrainType);
-        terrainCounts[terrainType]++;
-        
-        // Determine biome type based on all factors
-        BiomeType biomeType = DetermineBiomeType(elevation, temperature, moisture, terrainType);
-        const_cast<Tile&>(tile).SetBiomeType(biomeType);
-        biomeCounts[biomeType]++;
-        
-        // Report progress periodically
-        if (progressTracker && i % 1000 == 0) {
-            float progress = static_cast<float>(i) / tiles.size();
-            std::string message = "Assigning biomes: " + std::to_string(i) + "/" + std::to_string(tiles.size());
-            progressTracker->UpdateProgress(progress, message);
-        }
-    }
+    // Classify every tile and count the results; each range only writes its
+    // own tiles and keeps its own histograms, which are summed at the end
+    ClassificationCounts counts = ThreadPool::GetInstance().ParallelReduce(tiles.size(), ClassificationCounts{},
+        [&](size_t begin, size_t end, ClassificationCounts& local) {
+            // Gather the range's environmental factors into columns
+            const size_t count = end - begin;
+            std::vector<float> elevations(count), temperatures(count), moistures(count);
+            for (size_t i = 0; i < count; ++i) {
+                const auto& tile = tiles[begin + i];
+                elevations[i] = tile.GetElevation();
+                temperatures[i] = tile.GetTemperature();
+                moistures[i] = tile.GetMoisture();
+            }
+            
+            // Terrain type from elevation, then biome from all factors
+            std::vector<TerrainType> terrainTypes(count);
+            std::vector<BiomeType> biomeTypes(count);
+            terrainClassifier.Classify(elevations, terrainTypes);
+            biomeClassifier.Classify(elevations, temperatures, moistures, terrainTypes, biomeTypes);
+            
+            for (size_t i = 0; i < count; ++i) {
+                auto& tile = tiles[begin + i];
+                tile.SetTerrainType(terrainTypes[i]);
+                tile.SetBiomeType(biomeTypes[i]);
+                local.terrain.Add(static_cast<size_t>(terrainTypes[i]));
+                local.biome.Add(static_cast<size_t>(biomeTypes[i]));
+            }
+        },
+        [](ClassificationCounts& total, const ClassificationCounts& range) {
+            total.terrain += range.terrain;
+            total.biome += range.biome;
+        },
+        [&](float fraction) {
+            if (progressTracker) {
+                progressTracker->UpdateProgress(fraction * 0.9f, "Assigning biomes...");
+            }
+        });
+    
+    auto terrainCount = [&counts](TerrainType type) { return counts.terrain[static_cast<size_t>(type)]; };
     
     // Log terrain distribution
     std::cout << "\n============ TERRAIN TYPE DISTRIBUTION ============" << std::endl;
-    std::cout << "Ocean: " << terrainCounts[TerrainType::Ocean] << " tiles" << std::endl;
-    std::cout << "Shallow: " << terrainCounts[TerrainType::Shallow] << " tiles" << std::endl;
-    std::cout << "Beach: " << terrainCounts[TerrainType::Beach] << " tiles" << std::endl;
-    std::cout << "Lowland: " << terrainCounts[TerrainType::Lowland] << " tiles" << std::endl;
-    std::cout << "Highland: " << terrainCounts[TerrainType::Highland] << " tiles" << std::endl;
-    std::cout << "Mountain: " << terrainCounts[TerrainType::Mountain] << " tiles" << std::endl;
-    std::cout << "Peak: " << terrainCounts[TerrainType::Peak] << " tiles" << std::endl;
+    std::cout << "Ocean: " << terrainCount(TerrainType::Ocean) << " tiles" << std::endl;
+    std::cout << "Shallow: " << terrainCount(TerrainType::Shallow) << " tiles" << std::endl;
+    std::cout << "Beach: " << terrainCount(TerrainType::Beach) << " tiles" << std::endl;
+    std::cout << "Lowland: " << terrainCount(TerrainType::Lowland) << " tiles" << std::endl;
+    std::cout << "Highland: " << terrainCount(TerrainType::Highland) << " tiles" << std::endl;
+    std::cout << "Mountain: " << terrainCount(TerrainType::Mountain) << " tiles" << std::endl;
+    std::cout << "Peak: " << terrainCount(TerrainType::Peak) << " tiles" << std::endl;
     std::cout << "Total: " << tiles.size() << " tiles" << std::endl;
     std::cout << "==================================================" << std::endl;
     
     // Log biome distribution summary
     std::cout << "\n============ BIOME DISTRIBUTION ============" << std::endl;
-    int landBiomes = 0, waterBiomes = 0;
-    for (const auto& [biome, count] : biomeCounts) {
-        if (count > 0) {
-            // Check if it's a water biome
-            if (biome == BiomeType::Ocean || 
-                biome == BiomeType::DeepOcean || 
-                biome == BiomeType::Reef) {
-                waterBiomes += count;
-            } else {
-                landBiomes += count;
-            }
+    size_t landBiomes = 0, waterBiomes = 0;
+    for (size_t bin = 0; bin < kBiomeTypeCount; ++bin) {
+        BiomeType biome = static_cast<BiomeType>(bin);
+        // Check if it's a water biome
+        if (biome == BiomeType::Ocean || 
+            biome == BiomeType::DeepOcean || 
+            biome == BiomeType::Reef) {
+            waterBiomes += counts.biome[bin];
+        } else {
+            landBiomes += counts.biome[bin];
         }
     }
     std::cout << "Land biomes: " << landBiomes << " tiles" << std::endl;
@@ -28,8 +28,11 @@ void GenerateBiomes(World* world, std::shared_ptr<ProgressTracker> progressTrack
 /**
  * @brief Determine terrain type based on elevation
  * 
- * @param elevation The tile's elevation (0.0 to 1.0)
- * @param waterLevel The water level threshold
+ * Convenience wrapper around TerrainClassifier with the meter bands; prefer
+ * a TerrainClassifier when classifying many tiles.
+ * 
+ * @param elevation The tile's elevation in meters from the planet center
+ * @param waterLevel The water level (sea level radius) in meters
  * @return The appropriate terrain type
  */
 TerrainType DetermineTerrainType(float elevation, float waterLevel = 0.4f);
@@ -37,7 +40,9 @@ TerrainType DetermineTerrainType(float elevation, float waterLevel = 0.4f);
 /**
  * @brief Determine biome type based on environmental factors
  * 
- * @param elevation The tile's elevation (0.0 to 1.0)
+ * Looks the biome up in the shared BiomeClassifier table.
+ * 
+ * @param elevation The tile's elevation
  * @param temperature The tile's temperature (0.0 to 1.0)
  * @param moisture The tile's moisture (0.0 to 1.0)
  * @param terrainType The tile's terrain type
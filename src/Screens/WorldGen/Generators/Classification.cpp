@@ -0,0 +1,163 @@
+#include "Classification.h"
+#include <iostream>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+/**
+ * @brief The biome rules the lookup table is built from
+ */
+BiomeType ApplyBiomeRules(float elevation, float temperature, float moisture, TerrainType terrainType) {
+    // Water biomes
+    if (terrainType == TerrainType::Ocean) {
+        return BiomeType::DeepOcean;
+    } else if (terrainType == TerrainType::Shallow) {
+        if (temperature > 0.8f && moisture > 0.7f) {
+            return BiomeType::Reef; // Coral reefs in warm shallow water
+        }
+        return BiomeType::Ocean;
+    }
+
+    // Land biomes based on temperature and moisture
+    // Using a simplified Whittaker biome classification
+
+    // Very cold regions (tundra/ice)
+    if (temperature < 0.2f) {
+        if (elevation > 0.8f) {
+            return BiomeType::AlpineTundra;
+        } else if (moisture < 0.2f) {
+            return BiomeType::PolarDesert;
+        } else {
+            return BiomeType::ArcticTundra;
+        }
+    }
+
+    // Cold regions (boreal/taiga)
+    if (temperature < 0.4f) {
+        if (moisture > 0.4f) {
+            return BiomeType::BorealForest;
+        } else {
+            return BiomeType::ColdDesert;
+        }
+    }
+
+    // Temperate regions
+    if (temperature < 0.6f) {
+        if (moisture > 0.7f) {
+            return BiomeType::TemperateRainforest;
+        } else if (moisture > 0.4f) {
+            return BiomeType::TemperateDeciduousForest;
+        } else if (moisture > 0.2f) {
+            return BiomeType::TemperateGrassland;
+        } else {
+            return BiomeType::XericShrubland;
+        }
+    }
+
+    // Warm/subtropical regions
+    if (temperature < 0.8f) {
+        if (moisture > 0.6f) {
+            return BiomeType::TropicalSeasonalForest;
+        } else if (moisture > 0.3f) {
+            return BiomeType::TropicalSavanna;
+        } else if (moisture > 0.1f) {
+            return BiomeType::SemiDesert;
+        } else {
+            return BiomeType::HotDesert;
+        }
+    }
+
+    // Tropical regions
+    if (moisture > 0.7f) {
+        return BiomeType::TropicalRainforest;
+    } else if (moisture > 0.4f) {
+        return BiomeType::TropicalSeasonalForest;
+    } else if (moisture > 0.2f) {
+        return BiomeType::TropicalSavanna;
+    } else {
+        return BiomeType::HotDesert;
+    }
+}
+
+/**
+ * @brief A value inside a quantization cell
+ *
+ * Every value in a cell compares the same way against every threshold, so
+ * the rules give the same answer for this value as for the whole cell.
+ */
+template <size_t N>
+float CellValue(size_t cell, const std::array<float, N>& thresholds) {
+    if (cell == 0) {
+        return thresholds.front() - 1.0f;
+    }
+    size_t threshold = (cell - 1) / 2;
+    if (cell % 2 == 1) {
+        return thresholds[threshold];
+    }
+    if (threshold + 1 == N) {
+        return thresholds.back() + 1.0f;
+    }
+    return (thresholds[threshold] + thresholds[threshold + 1]) * 0.5f;
+}
+
+} // namespace
+
+TerrainClassifier::TerrainClassifier(float waterLevel, const TerrainBands& bands) {
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        bounds[i] = waterLevel + bands.offsets[i];
+    }
+}
+
+void TerrainClassifier::Classify(std::span<const float> elevations, std::span<TerrainType> terrainTypes) const {
+    if (elevations.size() != terrainTypes.size()) {
+        std::cerr << "ERROR: Terrain classification columns differ in size" << std::endl;
+        return;
+    }
+
+    for (size_t i = 0; i < elevations.size(); ++i) {
+        terrainTypes[i] = Classify(elevations[i]);
+    }
+}
+
+const BiomeClassifier& BiomeClassifier::GetInstance() {
+    static BiomeClassifier instance;
+    return instance;
+}
+
+BiomeClassifier::BiomeClassifier()
+    : table(kTerrainCells * kElevationCells * kTemperatureCells * kMoistureCells) {
+    size_t cell = 0;
+    for (size_t terrain = 0; terrain < kTerrainCells; ++terrain) {
+        for (size_t e = 0; e < kElevationCells; ++e) {
+            float elevation = CellValue(e, kElevationThresholds);
+            for (size_t t = 0; t < kTemperatureCells; ++t) {
+                float temperature = CellValue(t, kTemperatureThresholds);
+                for (size_t m = 0; m < kMoistureCells; ++m) {
+                    float moisture = CellValue(m, kMoistureThresholds);
+                    BiomeType biome = ApplyBiomeRules(elevation, temperature, moisture, static_cast<TerrainType>(terrain));
+                    table[cell++] = static_cast<uint8_t>(biome);
+                }
+            }
+        }
+    }
+}
+
+void BiomeClassifier::Classify(std::span<const float> elevations, std::span<const float> temperatures,
+                               std::span<const float> moistures, std::span<const TerrainType> terrainTypes,
+                               std::span<BiomeType> biomeTypes) const {
+    const size_t count = biomeTypes.size();
+    if (elevations.size() != count || temperatures.size() != count ||
+        moistures.size() != count || terrainTypes.size() != count) {
+        std::cerr << "ERROR: Biome classification columns differ in size" << std::endl;
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        biomeTypes[i] = Classify(elevations[i], temperatures[i], moistures[i], terrainTypes[i]);
+    }
+}
+
+} // namespace Generators
+} // namespace WorldGen
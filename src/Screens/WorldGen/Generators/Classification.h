@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "../Core/TerrainTypes.h"
+
+namespace WorldGen {
+namespace Generators {
+
+/**
+ * @brief Elevation bands that separate the terrain types
+ *
+ * Each offset is the upper bound of a terrain type relative to the water
+ * level, in order Ocean, Shallow, Beach, Lowland, Highland and Mountain;
+ * anything at or above the last bound is a Peak.
+ */
+struct TerrainBands {
+    std::array<float, 6> offsets;
+};
+
+// Elevations in meters from the planet center (water level = planet radius)
+inline constexpr TerrainBands kMeterTerrainBands = {{-1000.0f, -50.0f, 50.0f, 1000.0f, 2000.0f, 4000.0f}};
+
+// Normalized elevations (0.0 to 1.0)
+inline constexpr TerrainBands kNormalizedTerrainBands = {{-0.2f, -0.05f, 0.05f, 0.3f, 0.6f, 0.8f}};
+
+/**
+ * @brief Maps elevations to terrain types
+ *
+ * The terrain type is the number of band bounds the elevation is not below,
+ * so classifying a tile is six compares and adds with no branches, and a
+ * column of elevations is classified in a loop the compiler can vectorize.
+ */
+class TerrainClassifier {
+public:
+    /**
+     * @brief Create a classifier for one water level
+     *
+     * @param waterLevel Sea level in the same units as the elevations
+     * @param bands Band bounds relative to the water level
+     */
+    TerrainClassifier(float waterLevel, const TerrainBands& bands);
+
+    /**
+     * @brief Classify one elevation
+     *
+     * @param elevation Elevation in the units of the water level
+     * @return TerrainType The terrain type (never Volcano)
+     */
+    TerrainType Classify(float elevation) const {
+        int type = 0;
+        for (float bound : bounds) {
+            type += !(elevation < bound);
+        }
+        return static_cast<TerrainType>(type);
+    }
+
+    /**
+     * @brief Classify a column of elevations
+     *
+     * @param elevations Elevation per tile
+     * @param terrainTypes Output terrain type per tile, the same size as elevations
+     */
+    void Classify(std::span<const float> elevations, std::span<TerrainType> terrainTypes) const;
+
+private:
+    std::array<float, 6> bounds;
+};
+
+/**
+ * @brief Biome lookup table over terrain type, elevation, temperature and moisture
+ *
+ * The biome rules (a simplified Whittaker classification) only compare each
+ * input against a few fixed thresholds. Each input is quantized into cells
+ * that separate the values below, at and above every threshold, and the
+ * rules are evaluated once per combination of cells when the table is built.
+ * Looking up a biome is then a handful of compares and one table read, and
+ * gives exactly the biome the rules would for any finite inputs.
+ */
+class BiomeClassifier {
+public:
+    /**
+     * @brief Get the shared classifier, building its table on first use
+     *
+     * @return const BiomeClassifier& The classifier
+     */
+    static const BiomeClassifier& GetInstance();
+
+    /**
+     * @brief Classify one tile
+     *
+     * @param elevation The tile's elevation
+     * @param temperature The tile's temperature (0.0 to 1.0)
+     * @param moisture The tile's moisture (0.0 to 1.0)
+     * @param terrainType The tile's terrain type
+     * @return BiomeType The biome
+     */
+    BiomeType Classify(float elevation, float temperature, float moisture, TerrainType terrainType) const {
+        size_t cell = static_cast<size_t>(terrainType);
+        cell = cell * kElevationCells + QuantizeElevation(elevation);
+        cell = cell * kTemperatureCells + QuantizeTemperature(temperature);
+        cell = cell * kMoistureCells + QuantizeMoisture(moisture);
+        return static_cast<BiomeType>(table[cell]);
+    }
+
+    /**
+     * @brief Classify columns of tiles
+     *
+     * @param elevations Elevation per tile
+     * @param temperatures Temperature per tile
+     * @param moistures Moisture per tile
+     * @param terrainTypes Terrain type per tile
+     * @param biomeTypes Output biome per tile; every column must be the same size
+     */
+    void Classify(std::span<const float> elevations, std::span<const float> temperatures,
+                  std::span<const float> moistures, std::span<const TerrainType> terrainTypes,
+                  std::span<BiomeType> biomeTypes) const;
+
+private:
+    BiomeClassifier();
+
+    // Thresholds the biome rules compare against, ascending
+    static constexpr std::array<float, 1> kElevationThresholds = {0.8f};
+    static constexpr std::array<float, 4> kTemperatureThresholds = {0.2f, 0.4f, 0.6f, 0.8f};
+    static constexpr std::array<float, 6> kMoistureThresholds = {0.1f, 0.2f, 0.3f, 0.4f, 0.6f, 0.7f};
+
+    // Below, at and between every threshold, and above the last
+    static constexpr size_t kTerrainCells = static_cast<size_t>(TerrainType::Volcano) + 1;
+    static constexpr size_t kElevationCells = kElevationThresholds.size() * 2 + 1;
+    static constexpr size_t kTemperatureCells = kTemperatureThresholds.size() * 2 + 1;
+    static constexpr size_t kMoistureCells = kMoistureThresholds.size() * 2 + 1;
+
+    // Cell 2i+1 holds values equal to threshold i; even cells lie between thresholds
+    template <size_t N>
+    static size_t Quantize(float value, const std::array<float, N>& thresholds) {
+        size_t cell = 0;
+        for (float threshold : thresholds) {
+            cell += (value > threshold) + (value >= threshold);
+        }
+        return cell;
+    }
+
+    static size_t QuantizeElevation(float value) { return Quantize(value, kElevationThresholds); }
+    static size_t QuantizeTemperature(float value) { return Quantize(value, kTemperatureThresholds); }
+    static size_t QuantizeMoisture(float value) { return Quantize(value, kMoistureThresholds); }
+
+    std::vector<uint8_t> table;
+};
+
+} // namespace Generators
+} // namespace WorldGen
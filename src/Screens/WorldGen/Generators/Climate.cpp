@@ -0,0 +1,345 @@
+#include "Climate.h"
+#include "World.h"
+#include "Tile.h"
+#include "TaskGraph.h"
+#include "../ProgressTracker.h"
+#include "../Core/WorldGenParameters.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+// Solver blocks are latitude strips this many degrees high, so the wind
+// bands (which change every 30 degrees) never share a strip
+constexpr int kStripDegrees = 10;
+constexpr size_t kStripCount = 180 / kStripDegrees;
+
+// Inflow weight of a tile in steady wind (about 2 on the hexagonal tiling);
+// tiles with less upwind weight than this take the rest from dry, sinking air
+constexpr float kMinInflowWeight = 1.0f;
+
+/**
+ * @brief Water vapour air at a temperature can hold, relative to the warmest air
+ *
+ * Roughly exponential in temperature, like the real saturation curve.
+ */
+float SaturationVapor(float temperature) {
+    return std::exp(2.5f * (temperature - 0.8f));
+}
+
+/**
+ * @brief The vapour balance as a sparse system, with rows in solver order
+ *
+ * Row k is the tile sweepOrder[k]. The vapour leaving it is
+ *
+ *   v_k = keep_k * min(sum(w_kj * v_j), saturation_k) + refill_k
+ *
+ * Land keeps what does not rain out; the ocean keeps part of the air and
+ * refills the rest of it to saturation.
+ */
+struct VaporSystem {
+    std::vector<int> sweepOrder;     // Tile index of every row
+    std::vector<uint32_t> offsets;   // Row offsets into neighbors and weights
+    std::vector<uint32_t> neighbors; // Row index of every neighbour
+    std::vector<float> weights;      // Share of the row's inflow from that neighbour
+    std::vector<float> saturation;   // Per row: vapour capacity of the air
+    std::vector<float> keep;         // Per row: fraction of the (capped) inflow passed on
+    std::vector<float> refill;       // Per row: vapour evaporated into the air
+};
+
+/**
+ * @brief Vapour flowing into a row, given the vapour leaving every row
+ */
+inline float Inflow(const VaporSystem& system, const float* vapor, size_t row) {
+    float inflow = 0.0f;
+    for (uint32_t e = system.offsets[row]; e < system.offsets[row + 1]; ++e) {
+        inflow += system.weights[e] * vapor[system.neighbors[e]];
+    }
+    return inflow;
+}
+
+/**
+ * @brief One solver iteration over the rows [begin, end) of a block
+ *
+ * Sweeps the block downwind, updating in place, while rows of other blocks
+ * are read from the previous iterate.
+ *
+ * @param east true to sweep west to east, false for east to west
+ * @return float The largest change of any row in the block
+ */
+float SweepBlock(const VaporSystem& system, const float* current, float* next, size_t begin, size_t end, bool east) {
+    std::copy(current + begin, current + end, next + begin);
+
+    auto update = [&](size_t row) {
+        float inflow = 0.0f;
+        for (uint32_t e = system.offsets[row]; e < system.offsets[row + 1]; ++e) {
+            uint32_t neighbor = system.neighbors[e];
+            inflow += system.weights[e] * (neighbor >= begin && neighbor < end ? next[neighbor] : current[neighbor]);
+        }
+        next[row] = system.keep[row] * std::min(inflow, system.saturation[row]) + system.refill[row];
+    };
+    if (east) {
+        for (size_t row = begin; row < end; ++row) {
+            update(row);
+        }
+    } else {
+        for (size_t row = end; row-- > begin;) {
+            update(row);
+        }
+    }
+
+    float maxChange = 0.0f;
+    for (size_t row = begin; row < end; ++row) {
+        maxChange = std::max(maxChange, std::abs(next[row] - current[row]));
+    }
+    return maxChange;
+}
+
+} // namespace
+
+void GenerateClimate(World* world, const ClimateParams& params, std::shared_ptr<ProgressTracker> progressTracker) {
+    if (!world) {
+        std::cerr << "Error: Invalid world for climate generation" << std::endl;
+        return;
+    }
+
+    auto& tiles = world->GetTiles();
+    const size_t tileCount = tiles.size();
+    if (tileCount == 0) {
+        return;
+    }
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.0f, "Setting up climate...");
+    }
+
+    // Use planet's physical radius as sea level reference
+    const float seaLevel = PlanetParameters().physicalRadiusMeters;
+    const float radiusKm = seaLevel / 1000.0f;
+    const float pi = 3.14159265f;
+    ThreadPool& pool = ThreadPool::GetInstance();
+
+    // Step 1: Temperature and wind of every tile. Wind bands reverse every
+    // 30°: easterly trade winds blowing towards the equator, westerlies
+    // blowing towards the poles, then polar easterlies
+    std::vector<float> temperatures(tileCount);
+    std::vector<float> latitudes(tileCount);
+    std::vector<float> longitudes(tileCount);
+    std::vector<float> heights(tileCount);
+    std::vector<uint8_t> strips(tileCount);
+    std::vector<glm::vec3> winds(tileCount);
+    const float stripRadians = kStripDegrees * pi / 180.0f;
+    pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            glm::vec3 pos = tiles[i].GetCenter();
+            float latitude = std::asin(glm::clamp(pos.y, -1.0f, 1.0f));
+            float normalizedLatitude = std::abs(latitude) / (pi / 2.0f);
+            heights[i] = std::max(0.0f, tiles[i].GetElevation() - seaLevel);
+
+            float temperature = params.equatorTemperature -
+                                (params.equatorTemperature - params.poleTemperature) * normalizedLatitude -
+                                params.lapseRatePerKm * heights[i] / 1000.0f;
+            temperatures[i] = glm::clamp(temperature, 0.0f, 1.0f);
+            latitudes[i] = latitude;
+            longitudes[i] = std::atan2(pos.x, pos.z);
+            int strip = static_cast<int>((latitude + pi / 2.0f) / stripRadians);
+            strips[i] = static_cast<uint8_t>(std::clamp(strip, 0, static_cast<int>(kStripCount) - 1));
+
+            float band = std::sin(6.0f * std::abs(latitude)) >= 0.0f ? 1.0f : -1.0f;
+            glm::vec3 east(pos.z, 0.0f, -pos.x);
+            glm::vec3 towardEquator = glm::vec3(0.0f, pos.y > 0.0f ? -1.0f : 1.0f, 0.0f) + pos * std::abs(pos.y);
+            float eastLength = glm::length(east);
+            float equatorLength = glm::length(towardEquator);
+            winds[i] = glm::vec3(0.0f);
+            if (eastLength > 1e-6f) {
+                winds[i] -= band * east / eastLength;
+            }
+            if (equatorLength > 1e-6f) {
+                winds[i] += params.meridionalWind * band * towardEquator / equatorLength;
+            }
+        }
+    });
+
+    // Step 2: Order the rows. Winds are mostly east-west, so solver blocks
+    // are latitude strips, each kept in west-to-east order: sweeping a strip
+    // in the direction of its wind visits every tile after the tiles upwind
+    // of it, as long as the air stays in the strip
+    VaporSystem system;
+    system.sweepOrder.resize(tileCount);
+    std::iota(system.sweepOrder.begin(), system.sweepOrder.end(), 0);
+    std::sort(system.sweepOrder.begin(), system.sweepOrder.end(), [&](int a, int b) {
+        if (strips[a] != strips[b]) {
+            return strips[a] < strips[b];
+        }
+        return longitudes[a] != longitudes[b] ? longitudes[a] < longitudes[b] : a < b;
+    });
+
+    std::vector<size_t> stripBegin(kStripCount + 1, tileCount);
+    for (size_t row = tileCount; row-- > 0;) {
+        stripBegin[strips[system.sweepOrder[row]]] = row;
+    }
+    for (size_t strip = kStripCount; strip-- > 0;) {
+        stripBegin[strip] = std::min(stripBegin[strip], stripBegin[strip + 1]);
+    }
+
+    std::vector<uint8_t> sweepsEast(kStripCount);
+    for (size_t strip = 0; strip < kStripCount; ++strip) {
+        float eastward = 0.0f;
+        for (size_t row = stripBegin[strip]; row < stripBegin[strip + 1]; ++row) {
+            const int i = system.sweepOrder[row];
+            const glm::vec3& pos = tiles[i].GetCenter();
+            eastward += glm::dot(winds[i], glm::vec3(pos.z, 0.0f, -pos.x));
+        }
+        sweepsEast[strip] = eastward >= 0.0f;
+    }
+
+    std::vector<uint32_t> rowOf(tileCount);
+    system.offsets.resize(tileCount + 1);
+    system.offsets[0] = 0;
+    for (size_t row = 0; row < tileCount; ++row) {
+        int tileIdx = system.sweepOrder[row];
+        rowOf[tileIdx] = static_cast<uint32_t>(row);
+        system.offsets[row + 1] = system.offsets[row] + static_cast<uint32_t>(tiles[tileIdx].GetNeighbors().size());
+    }
+
+    // Step 3: Inflow weights and rainout of every row
+    system.neighbors.resize(system.offsets.back());
+    system.weights.resize(system.offsets.back());
+    system.saturation.resize(tileCount);
+    system.keep.resize(tileCount);
+    system.refill.resize(tileCount);
+    std::vector<float> rainout(tileCount);
+    std::vector<float> flatRainout(tileCount);
+    pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            const int i = system.sweepOrder[row];
+            const glm::vec3 pos = tiles[i].GetCenter();
+            const auto& tileNeighbors = tiles[i].GetNeighbors();
+
+            // Air arrives from the neighbours upwind (by the wind along the edge,
+            // so no air flows both ways where the bands part), plus some mixing
+            // from every side
+            float totalWeight = 0.0f;
+            float totalSpacing = 0.0f;
+            float climb = 0.0f;
+            uint32_t e = system.offsets[row];
+            for (int neighborIdx : tileNeighbors) {
+                glm::vec3 offset = pos - tiles[neighborIdx].GetCenter();
+                glm::vec3 edgeWind = 0.5f * (winds[i] + winds[neighborIdx]);
+                float spacing = glm::length(offset);
+                float upwind = spacing > 0.0f ? std::max(0.0f, glm::dot(edgeWind, offset / spacing)) : 0.0f;
+                float weight = upwind + params.windDiffusion;
+
+                system.neighbors[e] = rowOf[neighborIdx];
+                system.weights[e] = weight;
+                totalWeight += weight;
+                totalSpacing += spacing;
+                climb += weight * std::max(0.0f, heights[i] - heights[neighborIdx]);
+                e++;
+            }
+
+            // Where the winds diverge too little air arrives sideways; the rest
+            // sinks from aloft and is dry, which gives the subtropical deserts
+            const float inflowWeight = std::max(totalWeight, kMinInflowWeight);
+            for (e = system.offsets[row]; e < system.offsets[row + 1]; ++e) {
+                system.weights[e] /= inflowWeight;
+            }
+            climb /= inflowWeight;
+
+            // Rainout scales with tile size so moisture travels the same distance at any resolution
+            float spacingKm = tileNeighbors.empty() ? 0.0f : totalSpacing / tileNeighbors.size() * radiusKm;
+            float flat = 1.0f - std::exp(-spacingKm / params.rainoutDistanceKm);
+            float convergence = 1.0f + params.convergenceRain * std::cos(6.0f * latitudes[i]);
+            float saturation = SaturationVapor(temperatures[i]);
+            flatRainout[row] = flat;
+            system.saturation[row] = saturation;
+            if (tiles[i].GetElevation() < seaLevel) {
+                rainout[row] = 0.0f;
+                system.keep[row] = 1.0f - params.oceanEvaporation;
+                system.refill[row] = params.oceanEvaporation * saturation;
+            } else {
+                rainout[row] = glm::clamp(flat * convergence + params.orographicRainPerKm * climb / 1000.0f, 0.0f, 1.0f);
+                system.keep[row] = 1.0f - rainout[row] * (1.0f - params.landRecycling);
+                system.refill[row] = 0.0f;
+            }
+        }
+    });
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.1f, "Carrying moisture inland...");
+    }
+
+    // Step 4: Solve for the vapour leaving every row, starting from saturated air
+    std::vector<float> current = system.saturation;
+    std::vector<float> next(tileCount);
+
+    auto start = std::chrono::steady_clock::now();
+    int iteration = 0;
+    float residual = 0.0f;
+    bool converged = false;
+    while (iteration < params.maxIterations) {
+        if (IsGenerationCancelled()) {
+            return;
+        }
+        residual = pool.ParallelReduce(kStripCount, 0.0f, [&](size_t firstStrip, size_t lastStrip, float& maxChange) {
+            for (size_t strip = firstStrip; strip < lastStrip; ++strip) {
+                maxChange = std::max(maxChange, SweepBlock(system, current.data(), next.data(), stripBegin[strip],
+                                                               stripBegin[strip + 1], sweepsEast[strip]));
+            }
+        }, [](float& total, float range) { total = std::max(total, range); }, nullptr, 1);
+
+        std::swap(current, next);
+        iteration++;
+
+        if (residual < params.tolerance) {
+            converged = true;
+            break;
+        }
+
+        if (progressTracker && iteration % 16 == 0) {
+            // The residual falls roughly geometrically, so its log tracks progress towards the tolerance
+            float fraction = residual > 0.0f ? std::clamp(std::log(residual) / std::log(params.tolerance), 0.0f, 1.0f) : 1.0f;
+            progressTracker->UpdateProgress(0.1f + 0.8f * fraction, "Carrying moisture inland...");
+        }
+    }
+
+    float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (converged) {
+        std::cout << "Climate solver converged after " << iteration << " iterations (" << elapsedMs << " ms)" << std::endl;
+    } else {
+        std::cerr << "WARNING: Climate solver stopped at its iteration cap"
+                  << " after " << iteration << " iterations (largest change " << residual << ", tolerance "
+                  << params.tolerance << ")" << std::endl;
+    }
+
+    // Step 5: Moisture on land is the rain that falls (recycled rain included),
+    // relative to what saturated equatorial air drops on flat ground; over the
+    // ocean it is the humidity of the air
+    pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            const int i = system.sweepOrder[row];
+            float moisture = current[row];
+            if (rainout[row] > 0.0f) {
+                float inflow = Inflow(system, current.data(), row);
+                float rainfall = inflow - std::min(inflow, system.saturation[row]) * (1.0f - rainout[row]);
+                moisture = rainfall / flatRainout[row];
+            }
+            tiles[i].SetTemperature(temperatures[i]);
+            tiles[i].SetMoisture(glm::clamp(moisture, 0.0f, 1.0f));
+        }
+    });
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(1.0f, "Climate complete");
+    }
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+
+namespace WorldGen {
+
+// Forward declarations
+class ProgressTracker;
+
+namespace Generators {
+
+// Forward declarations
+class World;
+
+/**
+ * @brief Parameters for the climate phase
+ *
+ * Temperatures and moistures are normalized (0-1), as the biome rules expect.
+ */
+struct ClimateParams {
+    float equatorTemperature = 0.8f;    // Sea-level temperature at the equator
+    float poleTemperature = 0.2f;       // Sea-level temperature at the poles
+    float lapseRatePerKm = 0.08f;       // Temperature drop per km above sea level
+    float meridionalWind = 0.3f;        // North-south wind strength relative to the east-west bands
+    float windDiffusion = 0.02f;        // Weight every neighbour gets regardless of the wind (mixing)
+    float oceanEvaporation = 0.3f;      // Fraction of its saturation deficit an ocean tile refills per step
+    float rainoutDistanceKm = 2500.0f;  // Distance over flat land in which air drops 1 - 1/e of its water
+    float landRecycling = 0.6f;         // Fraction of the rain on land that evaporates back into the air
+    float orographicRainPerKm = 0.5f;   // Extra fraction of the air's water dropped per km it is lifted
+    float convergenceRain = 0.6f;       // How much wetter the equator and 60° bands are than 30° and the poles
+    float tolerance = 1e-3f;            // Converged once no tile's vapour changes by more than this per iteration
+    int maxIterations = 2000;           // Iteration cap
+};
+
+/**
+ * @brief Compute temperature and moisture for every tile
+ *
+ * Temperature falls off with latitude and with height above sea level.
+ * Moisture comes from a steady-state water vapour budget on the tile graph:
+ * ocean tiles evaporate towards their saturation vapour, prevailing winds
+ * (trade winds, westerlies and polar easterlies) carry the vapour inland,
+ * and land tiles rain out a fraction of what reaches them, more where the
+ * air is forced uphill, so windward slopes are wet and lee sides dry.
+ *
+ * The vapour balance is a sparse linear system (with a saturation cap)
+ * solved iteratively. Tiles are split into latitude strips, sorted west to
+ * east; each iteration sweeps every strip downwind, updating in place
+ * (Gauss-Seidel), while reading the neighbouring strips from the previous
+ * iterate (Jacobi). Air is carried across a whole strip in one sweep, so the
+ * iteration count barely grows with resolution, strips run in parallel and
+ * the result does not depend on the thread count. The solver stops when the
+ * largest change drops below the tolerance or at the iteration cap (logged
+ * as a warning), never on wall time, so the climate depends only on the seed
+ * and parameters. Its time budget (3 ms per thousand tiles) is checked by
+ * the WorldGen benchmarks.
+ *
+ * @param world The world to update; elevations are in meters from the planet center
+ * @param params Climate and solver parameters
+ * @param progressTracker Optional progress tracker for UI updates
+ */
+void GenerateClimate(World* world, const ClimateParams& params = {},
+                     std::shared_ptr<ProgressTracker> progressTracker = nullptr);
+
+} // namespace Generators
+} // namespace WorldGen
@@ -2,6 +2,8 @@
 #include "World.h"
 #include "Plate.h"
 #include "Tile.h"
+#include "TaskGraph.h"
+#include "TileDistanceField.h"
 #include "../ProgressTracker.h"
 #include <glm/geometric.hpp>
 #include <algorithm>
@@ -11,6 +13,38 @@
 namespace WorldGen {
 namespace Generators {
 
+MarginBand FindMarginBand(World* world, const std::vector<Plate>& plates, int maxRings) {
+    const auto& tiles = world->GetTiles();
+    
+    // Flag the tiles touching the other kind of plate in parallel, then collect them in tile order
+    std::vector<uint8_t> isBoundary(tiles.size(), 0);
+    ThreadPool::GetInstance().ParallelFor(tiles.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            int plateId = tiles[i].GetPlateId();
+            if (plateId < 0 || plateId >= plates.size()) continue;
+            
+            for (int neighborIdx : tiles[i].GetNeighbors()) {
+                int neighborPlateId = tiles[neighborIdx].GetPlateId();
+                if (neighborPlateId >= 0 && neighborPlateId < plates.size() &&
+                    plates[neighborPlateId].isOceanic != plates[plateId].isOceanic) {
+                    isBoundary[i] = 1;
+                    break;
+                }
+            }
+        }
+    });
+    
+    MarginBand band;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (isBoundary[i]) {
+            band.boundaryTiles.push_back(static_cast<int>(i));
+        }
+    }
+    
+    band.rings = ComputeTileHopField(*world, band.boundaryTiles, maxRings);
+    return band;
+}
+
 void CreateRealisticContinentalMargins(World* world, const std::vector<Plate>& plates, 
                                      const ContinentalMarginParams& params, uint64_t seed,
                                      std::shared_ptr<ProgressTracker> progressTracker) {
@@ -18,7 +52,7 @@ void CreateRealisticContinentalMargins(World* world, const std::vector<Plate>& p
     
     std::cout << "Creating realistic continental margins..." << std::endl;
     
-    const auto& tiles = world->GetTiles();
+    auto& tiles = world->GetTiles();
     if (tiles.empty()) return;
     
     if (progressTracker) {
@@ -30,123 +64,76 @@ void CreateRealisticContinentalMargins(World* world, const std::vector<Plate>& p
     
     const float transitionDistance = 0.6f; // Distance for transition zone (hundreds of tiles)
     
-    // Find distance to nearest oceanic-continental boundary for each tile
-    std::vector<float> distanceToBoundary(tiles.size(), 999.0f); // Start with very high distance
-    std::vector<float> targetElevation(tiles.size(), 0.0f);
-    
-    // First pass: identify boundary tiles and calculate target elevations
-    for (size_t i = 0; i < tiles.size(); ++i) {
-        const auto& tile = tiles[i];
-        int plateId = tile.GetPlateId();
-        
-        if (plateId >= 0 && plateId < plates.size()) {
-            const auto& plate = plates[plateId];
-            
-            // Check if this tile is near an oceanic-continental boundary
-            bool nearOceanicContinentalBoundary = false;
-            
-            for (int neighborIdx : tile.GetNeighbors()) {
-                if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
-                    const auto& neighborTile = tiles[neighborIdx];
-                    int neighborPlateId = neighborTile.GetPlateId();
-                    
-                    if (neighborPlateId >= 0 && neighborPlateId < plates.size()) {
-                        const auto& neighborPlate = plates[neighborPlateId];
-                        
-                        // Check for oceanic-continental boundary
-                        if (neighborPlate.isOceanic != plate.isOceanic) {
-                            nearOceanicContinentalBoundary = true;
-                            break;
-                        }
-                    }
-                }
-            }
-            
-            if (nearOceanicContinentalBoundary) {
-                distanceToBoundary[i] = 0.0f; // This tile is at boundary
-                
-                // Calculate realistic transition target based on plate type
-                float currentElevation = tile.GetElevation();
-                if (plate.isOceanic) {
-                    // Oceanic tiles: transition upward toward continental shelf
-                    targetElevation[i] = currentElevation + 0.08f; // Stronger raise ocean floor near continents
-                } else {
-                    // Continental tiles: transition downward toward shelf depth  
-                    targetElevation[i] = currentElevation - 0.1f;  // Stronger lower continental edges to create shelf
-                }
-            }
-        }
-    }
+    // Find the oceanic-continental boundary tiles and the rings around them
+    const int maxTransitionWaves = 5; // Affect boundary tiles + 5 waves outward
+    MarginBand band = FindMarginBand(world, plates, maxTransitionWaves);
     
-    // Second pass: propagate boundary effects outward in waves (limited)
-    const int maxWaves = 10; // Limit propagation to 10 waves
+    // First pass: calculate target elevations at the boundary tiles
+    std::vector<float> targetElevation(band.boundaryTiles.size(), 0.0f);
     
-    for (int wave = 0; wave < maxWaves; ++wave) {
-        std::vector<bool> affected(tiles.size(), false);
-        
-        for (size_t i = 0; i < tiles.size(); ++i) {
-            if (distanceToBoundary[i] == wave) { // This tile is at current wave distance
-                const auto& tile = tiles[i];
-                
-                // Propagate to all neighbors
-                for (int neighborIdx : tile.GetNeighbors()) {
-                    if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
-                        if (distanceToBoundary[neighborIdx] > wave + 1) {
-                            distanceToBoundary[neighborIdx] = wave + 1;
-                            targetElevation[neighborIdx] = targetElevation[i];
-                            affected[neighborIdx] = true;
-                        }
-                    }
-                }
+    ThreadPool::GetInstance().ParallelFor(band.boundaryTiles.size(), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            const auto& tile = tiles[band.boundaryTiles[b]];
+            const auto& plate = plates[tile.GetPlateId()];
+            
+            // Calculate realistic transition target based on plate type
+            float currentElevation = tile.GetElevation();
+            if (plate.isOceanic) {
+                // Oceanic tiles: transition upward toward continental shelf
+                targetElevation[b] = currentElevation + 0.08f; // Stronger raise ocean floor near continents
+            } else {
+                // Continental tiles: transition downward toward shelf depth  
+                targetElevation[b] = currentElevation - 0.1f;  // Stronger lower continental edges to create shelf
             }
         }
-        
-        // If no tiles were affected, we're done
-        bool anyAffected = false;
-        for (bool a : affected) {
-            if (a) { anyAffected = true; break; }
-        }
-        if (!anyAffected) break;
-    }
+    });
     
-    // Third pass: apply gradual elevation transitions
-    int tilesAffected = 0;
-    const int maxTransitionWaves = 5; // Affect boundary tiles + 5 waves outward
+    // Second pass: apply gradual elevation transitions to the band only; each
+    // tile blends towards the target of the boundary tile whose wave reached it
+    const std::vector<int>& bandTiles = band.rings.reached;
+    int tilesAffected = static_cast<int>(bandTiles.size());
     
-    for (size_t i = 0; i < tiles.size(); ++i) {
-        if (distanceToBoundary[i] <= maxTransitionWaves) {
-            tilesAffected++;
-            const auto& tile = tiles[i];
+    ThreadPool::GetInstance().ParallelFor(bandTiles.size(), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            int i = bandTiles[b];
+            auto& tile = tiles[i];
             float currentElevation = tile.GetElevation();
             
             // Calculate blend factor based on wave number (1.0 at boundary, 0.0 at max waves)
-            float blendFactor = 1.0f - (distanceToBoundary[i] / (float)maxTransitionWaves);
+            float blendFactor = 1.0f - (band.rings.distance[i] / (float)maxTransitionWaves);
             blendFactor = glm::clamp(blendFactor, 0.0f, 1.0f);
             
             // Apply smooth exponential transition (more gradual)
             blendFactor = 1.0f - exp(-2.0f * blendFactor); // Exponential curve for smoother transition
             
             // Blend current elevation with target elevation
-            float smoothedElevation = currentElevation * (1.0f - blendFactor) + targetElevation[i] * blendFactor;
-            const_cast<Tile&>(tile).SetElevation(glm::clamp(smoothedElevation, 0.0f, 1.0f));
+            float target = targetElevation[band.rings.nearestSource[i]];
+            float smoothedElevation = currentElevation * (1.0f - blendFactor) + target * blendFactor;
+            tile.SetElevation(glm::clamp(smoothedElevation, 0.0f, 1.0f));
         }
-    }
+    });
     
     std::cout << "Continental margin smoothing affected " << tilesAffected << " tiles out of " << tiles.size() << std::endl;
+    if (IsGenerationCancelled()) {
+        return;
+    }
     
     if (progressTracker) {
         progressTracker->UpdateProgress(0.3f, "Forming passive margin continental shelves...");
     }
     
     // Phase 2: Form continental shelves for passive margins
-    FormPassiveMarginShelves(world, plates, params, seed);
+    FormPassiveMarginShelves(world, plates, band, params, seed);
+    if (IsGenerationCancelled()) {
+        return;
+    }
     
     if (progressTracker) {
         progressTracker->UpdateProgress(0.7f, "Creating active margin subduction features...");
     }
     
     // Phase 3: Create subduction zone features for active margins  
-    FormActiveMarginTrenches(world, plates, params, seed + 1);
+    FormActiveMarginTrenches(world, plates, band, params, seed + 1);
     
     if (progressTracker) {
         progressTracker->UpdateProgress(1.0f, "Continental margin formation complete!");
@@ -226,135 +213,142 @@ MarginType DetermineMarginType(World* world, const std::vector<Plate>& plates, i
     return MarginType::Passive;
 }
 
-void FormPassiveMarginShelves(World* world, const std::vector<Plate>& plates,
+void FormPassiveMarginShelves(World* world, const std::vector<Plate>& plates, const MarginBand& band,
                             const ContinentalMarginParams& params, uint64_t seed) {
-    const auto& tiles = world->GetTiles();
-    
-    // Find ocean-continent boundaries for shelf formation
-    for (size_t i = 0; i < tiles.size(); ++i) {
-        const auto& tile = tiles[i];
-        int plateId = tile.GetPlateId();
-        
-        if (plateId >= 0 && plateId < plates.size()) {
-            const auto& plate = plates[plateId];
+    auto& tiles = world->GetTiles();
+    
+    // Only tiles touching an oceanic plate can form a shelf, and those are the band's boundary tiles
+    ThreadPool::GetInstance().ParallelFor(band.boundaryTiles.size(), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            int i = band.boundaryTiles[b];
+            auto& tile = tiles[i];
+            int plateId = tile.GetPlateId();
             
-            // Only process continental tiles near oceanic boundaries
-            if (!plate.isOceanic && DetermineMarginType(world, plates, i) == MarginType::Passive) {
+            if (plateId >= 0 && plateId < plates.size()) {
+                const auto& plate = plates[plateId];
                 
-                // Calculate distance to nearest oceanic plate
-                float minDistanceToOcean = 1.0f;
-                for (const auto& neighborIdx : tile.GetNeighbors()) {
-                    if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
-                        const auto& neighborTile = tiles[neighborIdx];
-                        int neighborPlateId = neighborTile.GetPlateId();
-                        
-                        if (neighborPlateId >= 0 && neighborPlateId < plates.size() &&
-                            plates[neighborPlateId].isOceanic) {
+                // Only process continental tiles near oceanic boundaries
+                if (!plate.isOceanic && DetermineMarginType(world, plates, i) == MarginType::Passive) {
+                    
+                    // Calculate distance to nearest oceanic plate
+                    float minDistanceToOcean = 1.0f;
+                    for (const auto& neighborIdx : tile.GetNeighbors()) {
+                        if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
+                            const auto& neighborTile = tiles[neighborIdx];
+                            int neighborPlateId = neighborTile.GetPlateId();
                             
-                            float distance = glm::distance(tile.GetCenter(), neighborTile.GetCenter());
-                            minDistanceToOcean = std::min(minDistanceToOcean, distance);
+                            if (neighborPlateId >= 0 && neighborPlateId < plates.size() &&
+                                plates[neighborPlateId].isOceanic) {
+                                
+                                float distance = glm::distance(tile.GetCenter(), neighborTile.GetCenter());
+                                minDistanceToOcean = std::min(minDistanceToOcean, distance);
+                            }
                         }
                     }
-                }
-                
-                // Apply continental shelf profile if near ocean
-                if (minDistanceToOcean < params.maxShelfWidth) {
-                    float shelfFactor = minDistanceToOcean / params.maxShelfWidth;
-                    
-                    // Create gradual slope from land to shelf break
-                    float currentElevation = tile.GetElevation();
-                    float shelfElevation = 0.4f - params.shelfBreakDepth * (1.0f - shelfFactor);
-                    
-                    // Blend between current elevation and shelf profile
-                    float blendFactor = 1.0f - shelfFactor;
-                    float newElevation = currentElevation * shelfFactor + shelfElevation * blendFactor;
                     
-                    // Add thermal subsidence for cooling lithosphere
-                    glm::vec3 pos = tile.GetCenter();
-                    float thermalAge = sin(pos.x * 5.0f + pos.y * 7.0f) * 0.5f + 0.5f;
-                    newElevation -= params.thermalSubsidenceRate * thermalAge;
-                    
-                    // Add sediment loading subsidence
-                    float sedimentThickness = params.sedimentationRate * (1.0f - shelfFactor);
-                    newElevation -= sedimentThickness * params.sedimentLoadingFactor;
-                    
-                    const_cast<Tile&>(tile).SetElevation(glm::clamp(newElevation, 0.0f, 1.0f));
+                    // Apply continental shelf profile if near ocean
+                    if (minDistanceToOcean < params.maxShelfWidth) {
+                        float shelfFactor = minDistanceToOcean / params.maxShelfWidth;
+                        
+                        // Create gradual slope from land to shelf break
+                        float currentElevation = tile.GetElevation();
+                        float shelfElevation = 0.4f - params.shelfBreakDepth * (1.0f - shelfFactor);
+                        
+                        // Blend between current elevation and shelf profile
+                        float blendFactor = 1.0f - shelfFactor;
+                        float newElevation = currentElevation * shelfFactor + shelfElevation * blendFactor;
+                        
+                        // Add thermal subsidence for cooling lithosphere
+                        glm::vec3 pos = tile.GetCenter();
+                        float thermalAge = sin(pos.x * 5.0f + pos.y * 7.0f) * 0.5f + 0.5f;
+                        newElevation -= params.thermalSubsidenceRate * thermalAge;
+                        
+                        // Add sediment loading subsidence
+                        float sedimentThickness = params.sedimentationRate * (1.0f - shelfFactor);
+                        newElevation -= sedimentThickness * params.sedimentLoadingFactor;
+                        
+                        tile.SetElevation(glm::clamp(newElevation, 0.0f, 1.0f));
+                    }
                 }
             }
         }
-    }
+    });
 }
 
-void FormActiveMarginTrenches(World* world, const std::vector<Plate>& plates,
+void FormActiveMarginTrenches(World* world, const std::vector<Plate>& plates, const MarginBand& band,
                             const ContinentalMarginParams& params, uint64_t seed) {
-    const auto& tiles = world->GetTiles();
-    
-    // Create subduction trenches and associated features
-    for (size_t i = 0; i < tiles.size(); ++i) {
-        const auto& tile = tiles[i];
-        int plateId = tile.GetPlateId();
-        
-        if (plateId >= 0 && plateId < plates.size()) {
-            const auto& plate = plates[plateId];
+    auto& tiles = world->GetTiles();
+    
+    // Create subduction trenches and associated features; active margins
+    // need an oceanic-continental neighbour, so only boundary tiles qualify
+    ThreadPool::GetInstance().ParallelFor(band.boundaryTiles.size(), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            int i = band.boundaryTiles[b];
+            auto& tile = tiles[i];
+            int plateId = tile.GetPlateId();
             
-            if (DetermineMarginType(world, plates, i) == MarginType::Active) {
-                
-                // Find distance to active plate boundary
-                float minDistanceToConvergentBoundary = 1.0f;
-                bool isSubductingPlate = false;
+            if (plateId >= 0 && plateId < plates.size()) {
+                const auto& plate = plates[plateId];
                 
-                for (const auto& neighborIdx : tile.GetNeighbors()) {
-                    if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
-                        const auto& neighborTile = tiles[neighborIdx];
-                        int neighborPlateId = neighborTile.GetPlateId();
-                        
-                        if (neighborPlateId >= 0 && neighborPlateId < plates.size() &&
-                            neighborPlateId != plateId) {
-                            
-                            const auto& neighborPlate = plates[neighborPlateId];
+                if (DetermineMarginType(world, plates, i) == MarginType::Active) {
+                    
+                    // Find distance to active plate boundary
+                    float minDistanceToConvergentBoundary = 1.0f;
+                    bool isSubductingPlate = false;
+                    
+                    for (const auto& neighborIdx : tile.GetNeighbors()) {
+                        if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
+                            const auto& neighborTile = tiles[neighborIdx];
+                            int neighborPlateId = neighborTile.GetPlateId();
                             
-                            // Check for oceanic plate subducting under continental
-                            if (plate.isOceanic && !neighborPlate.isOceanic) {
-                                isSubductingPlate = true;
-                                float distance = glm::distance(tile.GetCenter(), neighborTile.GetCenter());
-                                minDistanceToConvergentBoundary = std::min(minDistanceToConvergentBoundary, distance);
+                            if (neighborPlateId >= 0 && neighborPlateId < plates.size() &&
+                                neighborPlateId != plateId) {
+                                
+                                const auto& neighborPlate = plates[neighborPlateId];
+                                
+                                // Check for oceanic plate subducting under continental
+                                if (plate.isOceanic && !neighborPlate.isOceanic) {
+                                    isSubductingPlate = true;
+                                    float distance = glm::distance(tile.GetCenter(), neighborTile.GetCenter());
+                                    minDistanceToConvergentBoundary = std::min(minDistanceToConvergentBoundary, distance);
+                                }
                             }
                         }
                     }
-                }
-                
-                // Apply subduction zone features
-                if (minDistanceToConvergentBoundary < params.forearcBasinWidth) {
-                    float distanceFactor = minDistanceToConvergentBoundary / params.forearcBasinWidth;
                     
-                    if (isSubductingPlate) {
-                        // Create deep oceanic trench
-                        float trenchDepth = params.trenchDepth * (1.0f - distanceFactor);
-                        float currentElevation = tile.GetElevation();
-                        float newElevation = currentElevation - trenchDepth;
+                    // Apply subduction zone features
+                    if (minDistanceToConvergentBoundary < params.forearcBasinWidth) {
+                        float distanceFactor = minDistanceToConvergentBoundary / params.forearcBasinWidth;
                         
-                        const_cast<Tile&>(tile).SetElevation(glm::clamp(newElevation, 0.0f, 1.0f));
-                    } else {
-                        // Continental side: create forearc basin and potential uplift
-                        float currentElevation = tile.GetElevation();
-                        
-                        // Close to trench: forearc basin (slight depression)
-                        if (distanceFactor < 0.3f) {
-                            float basinDepression = 0.05f * (1.0f - distanceFactor / 0.3f);
-                            currentElevation -= basinDepression;
-                        }
-                        // Further inland: accretionary wedge uplift
-                        else if (distanceFactor < 0.7f) {
-                            float uplift = 0.1f * ((distanceFactor - 0.3f) / 0.4f);
-                            currentElevation += uplift;
+                        if (isSubductingPlate) {
+                            // Create deep oceanic trench
+                            float trenchDepth = params.trenchDepth * (1.0f - distanceFactor);
+                            float currentElevation = tile.GetElevation();
+                            float newElevation = currentElevation - trenchDepth;
+                            
+                            tile.SetElevation(glm::clamp(newElevation, 0.0f, 1.0f));
+                        } else {
+                            // Continental side: create forearc basin and potential uplift
+                            float currentElevation = tile.GetElevation();
+                            
+                            // Close to trench: forearc basin (slight depression)
+                            if (distanceFactor < 0.3f) {
+                                float basinDepression = 0.05f * (1.0f - distanceFactor / 0.3f);
+                                currentElevation -= basinDepression;
+                            }
+                            // Further inland: accretionary wedge uplift
+                            else if (distanceFactor < 0.7f) {
+                                float uplift = 0.1f * ((distanceFactor - 0.3f) / 0.4f);
+                                currentElevation += uplift;
+                            }
+                            
+                            tile.SetElevation(glm::clamp(currentElevation, 0.0f, 1.0f));
                         }
-                        
-                        const_cast<Tile&>(tile).SetElevation(glm::clamp(currentElevation, 0.0f, 1.0f));
                     }
                 }
             }
         }
-    }
+    });
 }
 
 } // namespace Generators
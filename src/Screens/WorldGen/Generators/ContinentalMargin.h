@@ -3,6 +3,7 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include <memory>
+#include "TileDistanceField.h"
 
 namespace WorldGen {
 
@@ -50,6 +51,27 @@ struct ContinentalMarginParams {
     float forearcBasinWidth = 0.08f;      // Distance from trench to arc
 };
 
+/**
+ * @brief Band of tiles around the ocean-continent plate boundaries
+ * 
+ * Found once with a frontier BFS and shared by the margin passes, which then
+ * only visit tiles in the band instead of scanning the whole world.
+ */
+struct MarginBand {
+    std::vector<int> boundaryTiles; // Tiles touching a plate of the other kind (oceanic vs continental), in tile order
+    TileDistanceField rings;        // Ring number and owning boundary tile (index into boundaryTiles) of every tile in the band
+};
+
+/**
+ * @brief Find the tiles within a number of rings of an ocean-continent boundary
+ * 
+ * @param world The world containing tiles with plate assignments
+ * @param plates The tectonic plates
+ * @param maxRings Number of rings around the boundary tiles to include
+ * @return MarginBand The boundary tiles and the rings around them
+ */
+MarginBand FindMarginBand(World* world, const std::vector<Plate>& plates, int maxRings);
+
 /**
  * @brief Create realistic continental margins with geological processes
  * 
@@ -103,10 +125,11 @@ MarginType DetermineMarginType(World* world, const std::vector<Plate>& plates, i
  * 
  * @param world The world containing tiles
  * @param plates The tectonic plates
+ * @param band Ocean-continent boundary band from FindMarginBand
  * @param params Formation parameters
  * @param seed Random seed
  */
-void FormPassiveMarginShelves(World* world, const std::vector<Plate>& plates,
+void FormPassiveMarginShelves(World* world, const std::vector<Plate>& plates, const MarginBand& band,
                             const ContinentalMarginParams& params, uint64_t seed);
 
 /**
@@ -119,10 +142,11 @@ void FormPassiveMarginShelves(World* world, const std::vector<Plate>& plates,
  * 
  * @param world The world containing tiles  
  * @param plates The tectonic plates
+ * @param band Ocean-continent boundary band from FindMarginBand
  * @param params Formation parameters
  * @param seed Random seed
  */
-void FormActiveMarginTrenches(World* world, const std::vector<Plate>& plates,
+void FormActiveMarginTrenches(World* world, const std::vector<Plate>& plates, const MarginBand& band,
                             const ContinentalMarginParams& params, uint64_t seed);
 
 } // namespace Generators
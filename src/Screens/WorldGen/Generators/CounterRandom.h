@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+
+namespace WorldGen {
+namespace Generators {
+
+/**
+ * @brief Independent random streams, one per use of CounterRandom
+ *
+ * The stream is part of every key, so two stages given the same seed still
+ * draw unrelated values. Append new streams at the end: renumbering changes
+ * every world generated from a seed.
+ */
+enum class RandomStream : uint64_t {
+    GridDistortion = 1,      ///< Midpoint offsets of the subdivided icosahedron
+    PlateCenters,            ///< Jitter of the plate centers
+    PlateProperties,         ///< Plate type, movement and rotation
+    LithospherePlateCenters, ///< Candidate plate centers of the (deprecated) Lithosphere
+    LithospherePlateTypes,   ///< Continental or oceanic, per Lithosphere plate
+    LithosphereCrust,        ///< Crust thickness noise, per Lithosphere vertex
+    LithosphereMovements,    ///< Movement and rotation, per Lithosphere plate
+    Stars                    ///< Background star field of the world generation screen
+};
+
+/**
+ * @brief SplitMix64 finalizer: a bijective 64-bit mix with full avalanche
+ */
+constexpr uint64_t SplitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Stateless random numbers keyed by (seed, stream, element, draw)
+ *
+ * Every value is a pure function of its key, so a generator can hand out
+ * elements (tiles, plates, edges) to any number of threads in any order and
+ * still produce the same world. Use the element's stable id (tile index,
+ * plate id, edge key) as the element, and number the values drawn for one
+ * element 0, 1, 2, ...
+ */
+class CounterRandom {
+public:
+    constexpr CounterRandom(uint64_t seed, RandomStream stream)
+        : key(SplitMix64(seed ^ SplitMix64(static_cast<uint64_t>(stream)))) {}
+
+    /**
+     * @brief 64 random bits
+     */
+    constexpr uint64_t Bits(uint64_t element, uint64_t draw = 0) const {
+        return SplitMix64(SplitMix64(key ^ element) ^ draw);
+    }
+
+    /**
+     * @brief Uniform float in [0, 1), with 24 bits of precision
+     */
+    constexpr float Uniform01(uint64_t element, uint64_t draw = 0) const {
+        return static_cast<float>(Bits(element, draw) >> 40) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * @brief Uniform float in [low, high)
+     */
+    constexpr float Uniform(uint64_t element, uint64_t draw, float low, float high) const {
+        return low + (high - low) * Uniform01(element, draw);
+    }
+
+private:
+    uint64_t key;
+};
+
+/**
+ * @brief Successive draws for one element, for code that reads like a sequential generator
+ *
+ * The values depend only on the element and how many were drawn before, never
+ * on other elements.
+ */
+class RandomSequence {
+public:
+    constexpr RandomSequence(const CounterRandom& random, uint64_t element)
+        : random(random), element(element) {}
+
+    constexpr uint64_t Bits() { return random.Bits(element, draw++); }
+    constexpr float Uniform01() { return random.Uniform01(element, draw++); }
+    constexpr float Uniform(float low, float high) { return random.Uniform(element, draw++, low, high); }
+
+private:
+    CounterRandom random;
+    uint64_t element;
+    uint64_t draw = 0;
+};
+
+} // namespace Generators
+} // namespace WorldGen
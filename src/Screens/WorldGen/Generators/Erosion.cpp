@@ -0,0 +1,236 @@
+#include "Erosion.h"
+#include "World.h"
+#include "Tile.h"
+#include "TaskGraph.h"
+#include "GraphSmoothing.h"
+#include "../ProgressTracker.h"
+#include "../Core/WorldGenParameters.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+// Thermal fluxes are scaled by this many neighbours, so a tile can never
+// lose more than half of its excess height in one step (hexagons have six)
+constexpr float kMaxNeighbors = 6.0f;
+
+/**
+ * @brief x^exponent, without std::pow for the usual stream power exponents
+ */
+inline float Power(float x, float exponent) {
+    if (exponent == 1.0f) {
+        return x;
+    }
+    if (exponent == 0.5f) {
+        return std::sqrt(x);
+    }
+    return std::pow(x, exponent);
+}
+
+} // namespace
+
+void ErodeTerrain(World* world, const ErosionParams& params, std::shared_ptr<ProgressTracker> progressTracker) {
+    if (!world) {
+        std::cerr << "Error: Invalid world for erosion" << std::endl;
+        return;
+    }
+
+    auto& tiles = world->GetTiles();
+    const size_t tileCount = tiles.size();
+    if (tileCount == 0 || params.iterations <= 0) {
+        return;
+    }
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.0f, "Setting up erosion...");
+    }
+
+    // Use planet's physical radius as sea level reference
+    const float seaLevel = PlanetParameters().physicalRadiusMeters;
+    const float radiusKm = seaLevel / 1000.0f;
+    const float pi = 3.14159265f;
+    const float tileAreaKm2 = 4.0f * pi * radiusKm * radiusKm / static_cast<float>(tileCount);
+    const float thermalFlux = params.thermalRate / (2.0f * kMaxNeighbors);
+    ThreadPool& pool = ThreadPool::GetInstance();
+
+    // Step 1: Flat columns. Heights are relative to sea level; ocean tiles
+    // are held at sea level, which is the base level everything drains to.
+    TileAdjacency adjacency = TileAdjacency::Build(*world);
+    std::vector<float> height(tileCount);
+    std::vector<float> next(tileCount);
+    std::vector<uint8_t> isLand(tileCount);
+    std::vector<float> inverseEdgeLength(adjacency.neighbors.size());
+    std::vector<float> talusHeight(adjacency.neighbors.size());
+    pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float elevation = tiles[i].GetElevation();
+            isLand[i] = elevation >= seaLevel;
+            height[i] = isLand[i] ? elevation - seaLevel : 0.0f;
+            for (uint32_t edge = adjacency.offsets[i]; edge < adjacency.offsets[i + 1]; ++edge) {
+                float length =
+                    glm::distance(tiles[i].GetCenter(), tiles[adjacency.neighbors[edge]].GetCenter()) * seaLevel;
+                inverseEdgeLength[edge] = 1.0f / length;
+                talusHeight[edge] = params.talusSlope * length;
+            }
+        }
+    });
+
+    std::vector<int> receiver(tileCount);
+    std::vector<float> slope(tileCount);
+    std::vector<float> area(tileCount);
+    std::vector<float> incision(tileCount);
+    std::vector<float> capacity(tileCount);
+    std::vector<float> sediment(tileCount);
+    std::vector<float> deposit(tileCount);
+    std::vector<uint8_t> steep(tileCount);
+    std::vector<uint32_t> donorCount(tileCount);
+    std::vector<int> order;
+    order.reserve(tileCount);
+
+    auto start = std::chrono::steady_clock::now();
+    double totalIncision = 0.0;
+    double totalDeposition = 0.0;
+    for (int iteration = 0; iteration < params.iterations; ++iteration) {
+        if (IsGenerationCancelled()) {
+            return;
+        }
+
+        // Step 2: Every land tile drains to its steepest lower neighbor.
+        // Tiles without one (ocean, and pits on land) are outlets. Also flag
+        // land next to slopes steeper than the talus slope.
+        pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                area[i] = tileAreaKm2;
+                sediment[i] = 0.0f;
+                int lowest = -1;
+                float steepestDrop = 0.0f;
+                bool overTalus = false;
+                if (isLand[i]) {
+                    const float h = height[i];
+                    for (uint32_t edge = adjacency.offsets[i]; edge < adjacency.offsets[i + 1]; ++edge) {
+                        int neighborIdx = adjacency.neighbors[edge];
+                        float difference = h - height[neighborIdx];
+                        float drop = difference * inverseEdgeLength[edge];
+                        bool steeper = drop > steepestDrop;
+                        steepestDrop = steeper ? drop : steepestDrop;
+                        lowest = steeper ? neighborIdx : lowest;
+                        overTalus |= std::abs(difference) > talusHeight[edge];
+                    }
+                }
+                receiver[i] = lowest;
+                slope[i] = steepestDrop;
+                steep[i] = overTalus;
+            }
+        });
+
+        // Step 3: Drainage area. Tiles are taken once all of their donors
+        // have been, so the order runs donors before receivers (Kahn's algorithm).
+        std::fill(donorCount.begin(), donorCount.end(), 0);
+        for (size_t i = 0; i < tileCount; ++i) {
+            if (receiver[i] >= 0) {
+                donorCount[receiver[i]]++;
+            }
+        }
+        order.clear();
+        for (size_t i = 0; i < tileCount; ++i) {
+            if (donorCount[i] == 0) {
+                order.push_back(static_cast<int>(i));
+            }
+        }
+        for (size_t head = 0; head < order.size(); ++head) {
+            int downstream = receiver[order[head]];
+            if (downstream >= 0) {
+                area[downstream] += area[order[head]];
+                if (--donorCount[downstream] == 0) {
+                    order.push_back(downstream);
+                }
+            }
+        }
+
+        // Step 4: Stream power incision and carrying capacity
+        pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                incision[i] = 0.0f;
+                capacity[i] = 0.0f;
+                if (receiver[i] < 0) {
+                    continue;
+                }
+                float streamPower = params.streamPowerK * Power(area[i], params.areaExponent) *
+                                    Power(slope[i], params.slopeExponent);
+                incision[i] = std::min(streamPower, height[i] - height[receiver[i]]);
+                capacity[i] = params.sedimentCapacity * streamPower;
+            }
+        });
+
+        // Step 5: Carry sediment downstream. Rivers drop part of whatever
+        // they cannot carry; pits keep everything and the sea takes the rest.
+        for (int i : order) {
+            float load = sediment[i] + incision[i];
+            totalIncision += incision[i];
+            if (receiver[i] < 0) {
+                deposit[i] = isLand[i] ? load : 0.0f;
+            } else {
+                deposit[i] = params.depositionRate * std::max(0.0f, load - capacity[i]);
+                sediment[receiver[i]] += load - deposit[i];
+            }
+            totalDeposition += deposit[i];
+        }
+
+        // Step 6: Apply the hydraulic change and slump slopes steeper than the
+        // talus slope. Each pair's thermal flux depends only on the previous
+        // heights, so gathering it per tile moves material without races.
+        pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (!isLand[i]) {
+                    next[i] = 0.0f;
+                    continue;
+                }
+                float h = height[i] - incision[i] + deposit[i];
+                if (steep[i]) {
+                    for (uint32_t edge = adjacency.offsets[i]; edge < adjacency.offsets[i + 1]; ++edge) {
+                        int neighborIdx = adjacency.neighbors[edge];
+                        float talus = talusHeight[edge];
+                        float difference = height[i] - height[neighborIdx];
+                        if (difference > talus) {
+                            h -= thermalFlux * (difference - talus);
+                        } else if (-difference > talus && isLand[neighborIdx]) {
+                            h += thermalFlux * (-difference - talus);
+                        }
+                    }
+                }
+                next[i] = std::max(h, 0.0f);
+            }
+        });
+        std::swap(height, next);
+
+        if (progressTracker) {
+            progressTracker->UpdateProgress(static_cast<float>(iteration + 1) / params.iterations, "Eroding terrain...");
+        }
+    }
+
+    float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Erosion: " << params.iterations << " iterations in " << elapsedMs << " ms, "
+              << totalIncision << " m incised, " << totalDeposition << " m deposited" << std::endl;
+
+    // Step 7: Write the land columns back
+    pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (isLand[i]) {
+                tiles[i].SetElevation(seaLevel + height[i]);
+            }
+        }
+    });
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(1.0f, "Erosion complete");
+    }
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+
+namespace WorldGen {
+
+// Forward declarations
+class ProgressTracker;
+
+namespace Generators {
+
+// Forward declarations
+class World;
+
+/**
+ * @brief Parameters for the erosion phase
+ *
+ * Stream power incision per iteration is K * A^m * S^n meters, with A the
+ * drainage area in km² and S the slope (rise over run) to the receiver.
+ */
+struct ErosionParams {
+    int iterations = 20;                        // Erosion steps to run
+    float streamPowerK = 0.2f;                  // Incision coefficient K
+    float areaExponent = 0.5f;                  // Drainage area exponent m
+    float slopeExponent = 1.0f;                 // Slope exponent n
+    float sedimentCapacity = 1.5f;              // Sediment a river can carry, relative to its incision rate
+    float depositionRate = 0.5f;                // Fraction of the sediment above capacity that settles per tile
+    float talusSlope = 0.6f;                    // Steepest stable slope (about 30°); steeper ground slumps
+    float thermalRate = 0.5f;                   // Fraction of the excess height above the talus slope moved per step
+};
+
+/**
+ * @brief Carve drainage into land elevations with hydraulic and thermal erosion
+ *
+ * Each iteration:
+ * - routes every land tile to its steepest lower neighbor and accumulates
+ *   drainage area downstream (in an O(N) receiver-before-donor order),
+ * - cuts each tile towards its receiver by the stream power law, never
+ *   below the receiver, so no new pits appear,
+ * - carries the eroded sediment downstream and settles part of whatever
+ *   exceeds a river's capacity where its slope flattens out; pits and lakes
+ *   keep all of it,
+ * - slumps ground steeper than the talus slope into its lower neighbors.
+ *
+ * Heights are worked on as flat columns relative to sea level, so that
+ * increments far below a meter are not lost to float precision at the
+ * planet radius. The per-tile steps read the previous iterate and write the
+ * next (double buffering) and run in parallel; thermal slumping is gathered
+ * per tile from pairwise fluxes, so it conserves material on land and the
+ * result does not depend on the thread count. Only the drainage order and the
+ * area/sediment accumulation are sequential O(N) passes.
+ *
+ * Ocean tiles (below the planet radius) are fixed base level at sea level:
+ * sediment reaching them leaves the system and they are never modified.
+ *
+ * Cost is 30-45 ms per million tiles per iteration on one core (the
+ * upper end once the columns no longer fit in cache), so the default 20
+ * iterations take under 1 s per million tiles. The phase always runs every
+ * iteration, so the terrain depends only on the seed and parameters; the
+ * budget of 2 s per million tiles is checked by the WorldGen benchmarks.
+ *
+ * @param world The world to update; elevations are in meters from the planet center
+ * @param params Erosion parameters
+ * @param progressTracker Optional progress tracker for UI updates
+ */
+void ErodeTerrain(World* world, const ErosionParams& params = {},
+                  std::shared_ptr<ProgressTracker> progressTracker = nullptr);
+
+} // namespace Generators
+} // namespace WorldGen
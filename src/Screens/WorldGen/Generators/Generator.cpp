@@ -2,90 +2,281 @@
 #include "Plate.h"
 #include "ContinentalMargin.h"
 #include "Mountain.h"
+#include "Climate.h"
+#include "Erosion.h"
 #include "Biome.h"
+#include "Hydrology.h"
+#include "TileOrdering.h"
+#include "GeometryCache.h"
+#include "TaskGraph.h"
+#include "PhaseCache.h"
+#include "../Core/MemoryUsage.h"
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <cmath>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 namespace WorldGen {
 namespace Generators {
 
-std::unique_ptr<World> Generator::CreateWorld(const PlanetParameters& params, uint64_t seed, std::shared_ptr<ProgressTracker> progressTracker) {
+std::unique_ptr<World> Generator::CreateWorld(const PlanetParameters& params, uint64_t seed,
+                                              std::shared_ptr<ProgressTracker> progressTracker,
+                                              const CancellationToken* cancellation,
+                                              const WorldPreviewCallback& onPreview) {
     std::cout << "Starting complete world generation pipeline..." << std::endl;
     
-    // Phase 1: Create geometric world (icosahedral subdivision)
+    // Every phase, and every pool task they start, polls this token
+    CancellationScope cancellationScope(cancellation);
+    
     if (progressTracker) {
         progressTracker->UpdateProgress(0.0f, "Creating world geometry...");
     }
     
-    auto world = std::make_unique<World>(params, seed, progressTracker);
-    
     // Calculate appropriate subdivision level based on resolution
-    int subdivisionLevel = GetSubdivisionLevel(params.resolution);
+    const int subdivisionLevel = GetSubdivisionLevel(params.resolution);
     
-    // Calculate distortion factor (can be a parameter later)
-    float distortionFactor = 0.05f; 
+    // Refuse a world whose estimated peak exceeds the memory target rather
+    // than generating a coarser one than the caller asked for
+    const size_t bytesPerMB = 1024 * 1024;
+    const size_t memoryTarget = static_cast<size_t>(params.peakMemoryTargetMB) * bytesPerMB;
+    const size_t estimatedPeak = EstimatePeakMemoryBytes(subdivisionLevel);
+    if (estimatedPeak > memoryTarget) {
+        std::ostringstream message;
+        message << "Resolution " << params.resolution << " (subdivision level " << subdivisionLevel << ") needs an estimated "
+                << estimatedPeak / bytesPerMB << " MB, more than the " << params.peakMemoryTargetMB
+                << " MB memory target allows (highest level that fits: " << GetMaxSubdivisionLevel(params.peakMemoryTargetMB)
+                << ")";
+        throw std::invalid_argument(message.str());
+    }
     
-    // Generate the world geometry (this should take us to ~50% progress)
-    world->Generate(subdivisionLevel, distortionFactor, progressTracker);
+    auto world = std::make_unique<World>(params, seed, progressTracker);
     
-    std::cout << "World geometry complete. Generated " << world->GetTileCount() << " tiles." << std::endl;
+    std::cout << "Subdivision level " << subdivisionLevel << ": estimated peak memory " << estimatedPeak / bytesPerMB
+              << " MB (target " << params.peakMemoryTargetMB << " MB)" << std::endl;
     
-    // Phase 2: Generate tectonic plates
-    if (progressTracker) {
-        progressTracker->UpdateProgress(0.5f, "Generating tectonic plates...");
-    }
+    // Base geometry depends only on these inputs, so it is shared across seeds
+    GeometryKey geometryKey{subdivisionLevel, params.distortionFactor, params.distortionSeed};
+    GeometryCache& geometryCache = GeometryCache::GetInstance();
     
-    std::vector<Plate> plates = GeneratePlates(world.get(), params.numTectonicPlates, seed + 1, progressTracker);
+    // The pipeline runs as a graph of phases on the shared thread pool. Plate
+    // generation only needs the seed, so it overlaps with the geometry phase;
+    // every later phase reads the previous phase's tiles and runs in order.
+    std::vector<Plate> plates;
+    TaskGraph pipeline;
     
-    if (progressTracker) {
-        progressTracker->UpdateProgress(0.7f, "Assigning tiles to plates...");
+    // Key every phase on the inputs it consumes, chained through the phases it
+    // reads from, so a parameter change only reruns the phases it reaches
+    ContinentalMarginParams marginParams; // Use default realistic parameters
+    const uint64_t geometryHash = PhaseKey().Add(subdivisionLevel).Add(params.distortionFactor).Add(params.distortionSeed).Get();
+    const uint64_t plateGenerationKey =
+        PhaseKey().Add(PipelinePhase::PlateGeneration).Add(params.numTectonicPlates).Add(seed + 1).Get();
+    const uint64_t plateAssignmentKey = PhaseKey().Add(PipelinePhase::PlateAssignment).Add(geometryHash)
+                                            .Add(plateGenerationKey).Add(params.numTectonicPlates).Add(seed + 2).Get();
+    const uint64_t marginKey =
+        PhaseKey().Add(PipelinePhase::ContinentalMargins).Add(plateAssignmentKey).Add(marginParams).Add(seed + 3).Get();
+    const uint64_t mountainKey = PhaseKey().Add(PipelinePhase::Mountains).Add(marginKey).Add(seed + 4).Get();
+    ErosionParams erosionParams;
+    const uint64_t erosionKey = PhaseKey().Add(PipelinePhase::Erosion).Add(mountainKey).Add(erosionParams).Get();
+    ClimateParams climateParams;
+    const uint64_t climateKey = PhaseKey().Add(PipelinePhase::Climate).Add(erosionKey).Add(climateParams).Get();
+    const uint64_t biomeKey = PhaseKey().Add(PipelinePhase::Biomes).Add(climateKey).Get();
+    HydrologyParams hydrologyParams;
+    const uint64_t hydrologyKey = PhaseKey().Add(PipelinePhase::Hydrology).Add(climateKey).Add(hydrologyParams).Get();
+    
+    // Previews share the geometry column, so they cost one extra copy of the
+    // tiles (10 * 4^n + 2 of them); skip them when that would not fit the memory target
+    std::shared_ptr<const WorldPreview> latestPreview;
+    const size_t previewBytes = ((static_cast<size_t>(10) << (2 * subdivisionLevel)) + 2) * sizeof(Tile);
+    const bool publishPreviews = onPreview && estimatedPeak + previewBytes <= memoryTarget;
+    if (onPreview && !publishPreviews) {
+        std::cerr << "WARNING: World previews do not fit the memory target and are disabled" << std::endl;
     }
+    auto publishPreview = [&](std::shared_ptr<const WorldPreview> preview) {
+        latestPreview = std::move(preview);
+        onPreview(latestPreview);
+    };
     
-    AssignTilesToPlates(world.get(), plates, params.numTectonicPlates, seed + 2, progressTracker);
+    // Run a phase unless its cached output is still valid, then remember its
+    // output if the extra columns fit in the memory target. Phases run on pool
+    // threads, so whether this run may use the cache is read here.
+    PhaseCache& phaseCache = PhaseCache::GetInstance();
+    const bool usePhaseCache = PhaseCache::IsEnabledOnThisThread();
+    auto runCachedPhase = [&](PipelinePhase phase, uint64_t key, uint32_t outputs, const std::function<void()>& work) {
+        if (usePhaseCache && phaseCache.Restore(phase, key, *world, plates)) {
+            return;
+        }
+        work();
+        if (!usePhaseCache || IsGenerationCancelled()) {
+            return; // Partial output must not be cached either
+        }
+        constexpr size_t kPhaseCacheBytesPerTile = 24;
+        bool hasTileColumns = outputs != PhaseOutputPlates;
+        if (!hasTileColumns ||
+            estimatedPeak + world->GetTileCount() * (sizeof(Tile) + kPhaseCacheBytesPerTile) <= memoryTarget) {
+            phaseCache.Store(phase, key, outputs, *world, plates);
+        }
+    };
     
-    std::cout << "Plate generation complete. Created " << plates.size() << " plates." << std::endl;
+    // Phase 1: Create geometric world (icosahedral subdivision)
+    auto geometryPhase = pipeline.AddPhase("Geometry", [&]() {
+        if (geometryCache.Restore(geometryKey, *world)) {
+            std::cout << "World geometry restored from cache. " << world->GetTileCount() << " tiles." << std::endl;
+            if (publishPreviews) {
+                publishPreview(MakeGeometryPreview(*world));
+            }
+            return;
+        }
+        
+        // Generate the world geometry (this should take us to ~50% progress)
+        world->Generate(subdivisionLevel, params.distortionFactor, progressTracker);
+        
+        std::cout << "World geometry complete. Generated " << world->GetTileCount() << " tiles." << std::endl;
+        
+        // Lay tiles out along a Hilbert curve so neighbour walks in later phases stay cache-local
+        RenumberTilesAlongHilbertCurve(world.get());
+        if (IsGenerationCancelled()) {
+            return;
+        }
+        
+        // Only keep a second copy of the tiles in memory if it still fits the target
+        bool keepInMemory = estimatedPeak + world->GetTileCount() * sizeof(Tile) <= memoryTarget;
+        geometryCache.Store(geometryKey, *world, keepInMemory);
+        
+        if (publishPreviews) {
+            publishPreview(MakeGeometryPreview(*world));
+        }
+    });
     
-    // Phase 3: Create realistic continental margins with wide-area smoothing
-    if (progressTracker) {
-        progressTracker->UpdateProgress(0.75f, "Forming continental margins...");
-    }
+    // Phase 2: Generate tectonic plates (runs alongside the geometry phase, so
+    // it does not report progress)
+    auto plateGenerationPhase = pipeline.AddPhase("Plate generation", [&]() {
+        runCachedPhase(PipelinePhase::PlateGeneration, plateGenerationKey, PhaseOutputPlates, [&]() {
+            plates = GeneratePlates(world.get(), params.numTectonicPlates, seed + 1, nullptr);
+        });
+    });
     
-    ContinentalMarginParams marginParams; // Use default realistic parameters
-    CreateRealisticContinentalMargins(world.get(), plates, marginParams, seed + 3, progressTracker);
+    auto plateAssignmentPhase = pipeline.AddPhase("Plate assignment", [&]() {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(0.7f, "Assigning tiles to plates...");
+        }
+        
+        runCachedPhase(PipelinePhase::PlateAssignment, plateAssignmentKey,
+                       PhaseOutputPlates | PhaseOutputPlateIds | PhaseOutputElevations, [&]() {
+            AssignTilesToPlates(world.get(), plates, params.numTectonicPlates, seed + 2, progressTracker);
+        });
+        
+        if (latestPreview && !IsGenerationCancelled()) {
+            publishPreview(MakePlatePreview(*latestPreview, *world, plates));
+        }
+        
+        std::cout << "Plate generation complete. Created " << plates.size() << " plates." << std::endl;
+    }, {geometryPhase, plateGenerationPhase});
     
-    std::cout << "Continental margin formation complete." << std::endl;
+    // Phase 3: Create realistic continental margins with wide-area smoothing
+    auto marginPhase = pipeline.AddPhase("Continental margins", [&]() {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(0.75f, "Forming continental margins...");
+        }
+        
+        runCachedPhase(PipelinePhase::ContinentalMargins, marginKey, PhaseOutputElevations, [&]() {
+            CreateRealisticContinentalMargins(world.get(), plates, marginParams, seed + 3, progressTracker);
+        });
+        
+        std::cout << "Continental margin formation complete." << std::endl;
+    }, {plateAssignmentPhase});
     
     // Phase 4: Generate mountains based on plate interactions
-    if (progressTracker) {
-        progressTracker->UpdateProgress(0.8f, "Generating comprehensive mountain systems...");
-    }
+    auto mountainPhase = pipeline.AddPhase("Mountains", [&]() {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(0.8f, "Generating comprehensive mountain systems...");
+        }
+        
+        runCachedPhase(PipelinePhase::Mountains, mountainKey, PhaseOutputElevations, [&]() {
+            GenerateComprehensiveMountains(world.get(), plates, seed + 4, progressTracker);
+        });
+        
+        if (latestPreview && !IsGenerationCancelled()) {
+            publishPreview(MakeElevationPreview(*latestPreview, *world));
+        }
+        
+        std::cout << "Mountain generation complete." << std::endl;
+    }, {marginPhase});
     
-    GenerateComprehensiveMountains(world.get(), plates, progressTracker);
+    // Phase 5: Carve drainage with hydraulic and thermal erosion
+    auto erosionPhase = pipeline.AddPhase("Erosion", [&]() {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(0.82f, "Eroding terrain...");
+        }
+        
+        runCachedPhase(PipelinePhase::Erosion, erosionKey, PhaseOutputElevations, [&]() {
+            ErodeTerrain(world.get(), erosionParams, progressTracker);
+        });
+        
+        std::cout << "Erosion complete." << std::endl;
+    }, {mountainPhase});
     
-    std::cout << "Mountain generation complete." << std::endl;
+    // Phase 6: Simulate climate (temperature, and moisture carried by the prevailing winds)
+    auto climatePhase = pipeline.AddPhase("Climate", [&]() {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(0.85f, "Simulating climate...");
+        }
+        
+        runCachedPhase(PipelinePhase::Climate, climateKey, PhaseOutputClimate, [&]() {
+            GenerateClimate(world.get(), climateParams, progressTracker);
+        });
+        
+        std::cout << "Climate simulation complete." << std::endl;
+    }, {erosionPhase});
     
-    // Phase 5: Generate biomes based on environmental factors
-    if (progressTracker) {
-        progressTracker->UpdateProgress(0.9f, "Generating biomes...");
-    }
+    // Phase 7: Generate biomes based on environmental factors
+    pipeline.AddPhase("Biomes", [&]() {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(0.9f, "Generating biomes...");
+        }
+        
+        runCachedPhase(PipelinePhase::Biomes, biomeKey, PhaseOutputClassification, [&]() {
+            GenerateBiomes(world.get(), progressTracker);
+        });
+        
+        std::cout << "Biome generation complete." << std::endl;
+    }, {climatePhase});
+    
+    // Phase 8: Route rivers and fill lakes. It only reads elevation and
+    // moisture, so it runs alongside the biome phase (and does not report progress)
+    pipeline.AddPhase("Hydrology", [&]() {
+        runCachedPhase(PipelinePhase::Hydrology, hydrologyKey, PhaseOutputHydrology, [&]() {
+            world->SetHydrology(GenerateHydrology(*world, hydrologyParams, nullptr));
+        });
+        
+        std::cout << "Hydrology generation complete." << std::endl;
+    }, {climatePhase});
     
-    GenerateBiomes(world.get(), progressTracker);
+    pipeline.Run();
+    pipeline.LogTimings();
     
-    std::cout << "Biome generation complete." << std::endl;
+    // A cancelled run's world is incomplete; dropping it frees its memory right away
+    if (IsGenerationCancelled()) {
+        std::cout << "World generation cancelled." << std::endl;
+        return nullptr;
+    }
     
     // Store plate data in the world for visualization
     world->SetPlates(plates);
+    world->SetPhaseTimings(pipeline.GetTimings());
     
     // TODO: Future phases
-    // Phase 6: Climate simulation (refine temperature/moisture)
-    // Phase 7: River generation
-    // Phase 8: Final terrain smoothing
+    // Phase 9: Final terrain smoothing
     
     if (progressTracker) {
         progressTracker->UpdateProgress(1.0f, "World generation complete!");
     }
     
     std::cout << "Complete world generation pipeline finished successfully." << std::endl;
+    std::cout << "Process peak resident memory: " << Core::getPeakResidentMemoryBytes() / bytesPerMB
+              << " MB (generation target " << params.peakMemoryTargetMB << " MB)" << std::endl;
     
     return world;
 }
@@ -104,11 +295,41 @@ int Generator::GetSubdivisionLevel(int resolution) {
     return static_cast<int>(std::ceil(subdivisions));
 }
 
+int Generator::GetMaxSubdivisionLevel(int peakMemoryTargetMB) {
+    const size_t memoryTarget = static_cast<size_t>(std::max(peakMemoryTargetMB, 0)) * 1024 * 1024;
+    int level = -1;
+    while (level < kMaxSubdivisionLevel && EstimatePeakMemoryBytes(level + 1) <= memoryTarget) {
+        level++;
+    }
+    return level;
+}
+
 int Generator::CalculateTileCount(int subdivisionLevel) {
     // Each subdivision increases the number of tiles by factor of ~4
     // Starting with 20 faces on the icosahedron
     return static_cast<int>(20 * std::pow(4, subdivisionLevel));
 }
 
+size_t Generator::EstimatePeakMemoryBytes(int subdivisionLevel) {
+    // Subdividing n times yields 10 * 4^n + 2 vertices (one tile each) and 20 * 4^n faces
+    const size_t faces = static_cast<size_t>(20) << (2 * subdivisionLevel);
+    const size_t tiles = faces / 2 + 2;
+    const size_t vec3Bytes = sizeof(glm::vec3);
+    const size_t faceBytes = sizeof(std::array<int, 3>);
+    
+    // Last subdivision pass: vertices, parent faces, edge keys and child faces
+    size_t subdivisionPeak = tiles * vec3Bytes + (faces / 4) * faceBytes + (faces / 4) * 3 * sizeof(uint64_t) + faces * faceBytes;
+    
+    // Dual construction: mesh, face centers, vertex-to-face rows and the tiles being built
+    size_t tileConstructionPeak = tiles * vec3Bytes + faces * faceBytes + faces * vec3Bytes +
+                                  (tiles + 1) * 2 * sizeof(uint32_t) + faces * 3 * sizeof(uint32_t) + tiles * sizeof(Tile);
+    
+    // Later phases keep only the tiles resident plus a few per-tile columns of scratch data
+    constexpr size_t kPhaseScratchBytesPerTile = 64;
+    size_t pipelinePeak = tiles * (sizeof(Tile) + kPhaseScratchBytesPerTile);
+    
+    return std::max({subdivisionPeak, tileConstructionPeak, pipelinePeak});
+}
+
 } // namespace Generators
-} // namespace WorldGen
\ No newline at end of file
+} // namespace WorldGen
@@ -3,10 +3,14 @@
 #include <memory>
 #include "../Core/WorldGenParameters.h"
 #include "World.h"
+#include "WorldPreview.h"
 
 namespace WorldGen {
 namespace Generators {
 
+// Forward declarations
+class CancellationToken;
+
 /**
  * @brief Factory class for creating World objects.
  * 
@@ -15,14 +19,24 @@ namespace Generators {
  * and distortion factor based on the desired resolution.
  */
 class Generator {
-public:    /**
+public:
+    static constexpr int kMaxSubdivisionLevel = 12; ///< Highest level GetMaxSubdivisionLevel considers
+
+    /**
      * @brief Create a new world using the specified parameters.
      * 
      * @param params The parameters to use for world generation.
      * @param progressTracker Optional progress tracker to report generation progress.
-     * @return std::unique_ptr<World> A unique pointer to the newly created World.
+     * @param cancellation Optional token; once cancelled, every phase stops at its next check
+     * @param onPreview Optional callback for the snapshots published after the geometry, plate and elevation phases
+     * @return std::unique_ptr<World> A unique pointer to the newly created World, or nullptr if cancelled.
+     * @throws std::invalid_argument if the resolution's estimated peak memory exceeds params.peakMemoryTargetMB
+     *         (see GetMaxSubdivisionLevel)
      */
-    static std::unique_ptr<World> CreateWorld(const PlanetParameters& params, uint64_t seed, std::shared_ptr<ProgressTracker> progressTracker = nullptr);
+    static std::unique_ptr<World> CreateWorld(const PlanetParameters& params, uint64_t seed,
+                                              std::shared_ptr<ProgressTracker> progressTracker = nullptr,
+                                              const CancellationToken* cancellation = nullptr,
+                                              const WorldPreviewCallback& onPreview = nullptr);
 
     /**
      * @brief Get the appropriate subdivision level for a given resolution.
@@ -32,6 +46,17 @@ public:    /**
      */
     static int GetSubdivisionLevel(int resolution);
 
+    /**
+     * @brief Get the highest subdivision level whose estimated peak memory fits a target.
+     * 
+     * CreateWorld refuses resolutions above this level, so callers can clamp
+     * the resolution they request up front.
+     * 
+     * @param peakMemoryTargetMB The memory target, as in PlanetParameters::peakMemoryTargetMB.
+     * @return int The highest level that fits, or -1 if not even level 0 does.
+     */
+    static int GetMaxSubdivisionLevel(int peakMemoryTargetMB);
+
     /**
      * @brief Calculate the number of tiles that will be generated for a given subdivision level.
      * 
@@ -39,6 +64,18 @@ public:    /**
      * @return int The approximate number of tiles.
      */
     static int CalculateTileCount(int subdivisionLevel);
+
+    /**
+     * @brief Estimate the peak memory used while generating a world.
+     * 
+     * Covers the largest of the geometry stages (final subdivision pass, dual
+     * tile construction) and the resident tiles plus per-phase scratch data of
+     * the plate, margin, mountain and biome phases.
+     * 
+     * @param subdivisionLevel The subdivision level.
+     * @return size_t Estimated peak memory in bytes.
+     */
+    static size_t EstimatePeakMemoryBytes(int subdivisionLevel);
 };
 
 } // namespace Generators
@@ -0,0 +1,151 @@
+#include "GeometryCache.h"
+#include "World.h"
+#include "Plate.h"
+#include "WorldSnapshot.h"
+#include "../Core/WorldGenParameters.h"
+#include <bit>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+// Part of every cache file name; bump it whenever the geometry built for a
+// key or kWorldSnapshotVersion changes, so files written by older builds are ignored
+constexpr int kGeometryVersion = 4;
+
+} // namespace
+
+GeometryCache& GeometryCache::GetInstance() {
+    static GeometryCache instance;
+    return instance;
+}
+
+bool GeometryCache::Restore(const GeometryKey& key, World& world) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->key == key) {
+            // Move to the front to mark as most recently used
+            entries.splice(entries.begin(), entries, it);
+            world.tiles = it->tiles;
+            world.pentagonCount = it->pentagonCount;
+            std::cout << "Reusing cached geometry for subdivision level " << key.subdivisionLevel << " ("
+                      << world.tiles.size() << " tiles)" << std::endl;
+            return true;
+        }
+    }
+
+    if (diskDirectory.empty()) {
+        return false;
+    }
+
+    const std::string path = GetDiskPath(key);
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) {
+        return false;
+    }
+
+    auto snapshot = MappedWorldSnapshot::Open(path);
+    if (!snapshot || snapshot->GetTileCount() == 0 || snapshot->GetHeader().plateCount != 0) {
+        std::cerr << "WARNING: Ignoring unusable geometry cache file " << path << std::endl;
+        return false;
+    }
+
+    auto cachedWorld = CreateWorldFromSnapshot(*snapshot);
+    world.tiles = cachedWorld->tiles;
+    world.pentagonCount = cachedWorld->pentagonCount;
+    Insert(Entry{key, std::move(cachedWorld->tiles), cachedWorld->pentagonCount});
+
+    std::cout << "Loaded cached geometry from " << path << " (" << world.tiles.size() << " tiles)" << std::endl;
+    return true;
+}
+
+void GeometryCache::Store(const GeometryKey& key, const World& world, bool keepInMemory) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->key == key) {
+                entries.erase(it);
+                break;
+            }
+        }
+        if (keepInMemory && maxEntries > 0) {
+            Insert(Entry{key, world.GetTiles(), world.GetPentagonCount()});
+        }
+        if (!diskDirectory.empty()) {
+            path = GetDiskPath(key);
+        }
+    }
+
+    // Writing takes far longer than the LRU update, so it runs unlocked. The
+    // world belongs to the caller, and the file is renamed into place only
+    // once complete, so Restore never maps a partly written snapshot.
+    if (path.empty()) {
+        return;
+    }
+    const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "WARNING: Could not create geometry cache directory " << directory.string() << ": "
+                  << error.message() << std::endl;
+        return;
+    }
+    std::ostringstream tempPath;
+    tempPath << path << "." << std::this_thread::get_id() << ".tmp";
+    if (!SaveWorldSnapshot(world, PlanetParameters(), tempPath.str())) {
+        std::filesystem::remove(tempPath.str(), error);
+        return;
+    }
+    std::filesystem::rename(tempPath.str(), path, error);
+    if (error) {
+        std::cerr << "WARNING: Could not write geometry cache file " << path << ": " << error.message() << std::endl;
+        std::filesystem::remove(tempPath.str(), error);
+    }
+}
+
+void GeometryCache::SetDiskDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    diskDirectory = directory;
+}
+
+void GeometryCache::SetMaxMemoryEntries(size_t maxEntries) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->maxEntries = maxEntries;
+    while (entries.size() > maxEntries) {
+        entries.pop_back();
+    }
+}
+
+void GeometryCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+std::string GeometryCache::GetDiskPath(const GeometryKey& key) const {
+    // The distortion factor is stored by bit pattern so the name maps to exactly one key
+    std::ostringstream name;
+    name << "geometry_v" << kGeometryVersion << "_L" << key.subdivisionLevel << "_D" << std::hex << std::bit_cast<uint32_t>(key.distortionFactor)
+         << "_S" << key.distortionSeed << ".world";
+    return (std::filesystem::path(diskDirectory) / name.str()).string();
+}
+
+void GeometryCache::Insert(Entry entry) {
+    if (maxEntries == 0) {
+        return;
+    }
+    entries.push_front(std::move(entry));
+    while (entries.size() > maxEntries) {
+        entries.pop_back();
+    }
+}
+
+} // namespace Generators
+} // namespace WorldGen
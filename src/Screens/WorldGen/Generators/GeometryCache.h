@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Tile.h"
+
+namespace WorldGen {
+namespace Generators {
+
+// Forward declaration
+class World;
+
+/**
+ * @brief Inputs that fully determine the base tile geometry of a world
+ */
+struct GeometryKey {
+    int subdivisionLevel;
+    float distortionFactor;
+    uint64_t distortionSeed;
+
+    bool operator==(const GeometryKey& other) const {
+        return subdivisionLevel == other.subdivisionLevel && distortionFactor == other.distortionFactor &&
+               distortionSeed == other.distortionSeed;
+    }
+};
+
+/**
+ * @brief Cache of generated base geometry, shared by every world seed
+ *
+ * Icosphere subdivision, dual tile construction, neighbour setup and tile
+ * renumbering depend only on the GeometryKey, not on the plate, mountain or
+ * biome phases. The cache keeps the finished base tiles in memory and,
+ * when a directory is configured, as world snapshots on disk so regenerating
+ * a world can go straight to the plate phase.
+ */
+class GeometryCache {
+public:
+    /**
+     * @brief Get the process-wide geometry cache
+     *
+     * @return GeometryCache& The shared cache
+     */
+    static GeometryCache& GetInstance();
+
+    /**
+     * @brief Fill a world with cached base geometry
+     *
+     * Checks memory first, then the disk directory (promoting disk hits into memory).
+     *
+     * @param key Geometry inputs
+     * @param world World whose tiles should be replaced
+     * @return true if the geometry was found and copied into the world
+     */
+    bool Restore(const GeometryKey& key, World& world);
+
+    /**
+     * @brief Store a world's base geometry
+     *
+     * Must be called before any plate phase modifies the tiles.
+     *
+     * @param key Geometry inputs the world was generated with
+     * @param world World holding freshly generated base geometry
+     * @param keepInMemory Whether to keep a copy in memory (the disk copy is written either way)
+     */
+    void Store(const GeometryKey& key, const World& world, bool keepInMemory = true);
+
+    /**
+     * @brief Enable the on-disk cache
+     *
+     * @param directory Directory for cached geometry files (empty disables the disk cache)
+     */
+    void SetDiskDirectory(const std::string& directory);
+
+    /**
+     * @brief Set how many geometry levels are kept in memory
+     *
+     * @param maxEntries Maximum number of in-memory entries (least recently used are evicted)
+     */
+    void SetMaxMemoryEntries(size_t maxEntries);
+
+    /**
+     * @brief Drop all in-memory entries (files on disk are kept)
+     */
+    void Clear();
+
+private:
+    GeometryCache() = default;
+
+    struct Entry {
+        GeometryKey key;
+        std::vector<Tile> tiles;
+        size_t pentagonCount;
+    };
+
+    std::string GetDiskPath(const GeometryKey& key) const;
+    void Insert(Entry entry);
+
+    std::mutex mutex;
+    std::list<Entry> entries;  ///< Most recently used first
+    size_t maxEntries = 2;
+    std::string diskDirectory; ///< Empty when the disk cache is disabled
+};
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,109 @@
+#include "GraphSmoothing.h"
+#include "World.h"
+#include "Tile.h"
+#include "TaskGraph.h"
+#include <algorithm>
+#include <iostream>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+// Below this many tiles, handing a range to another thread costs more than it saves
+constexpr size_t kMinTilesPerRange = 4096;
+
+/**
+ * @brief Run one smoothing pass over tiles [begin, end)
+ *
+ * Templated on whether edge weights are present so the unweighted inner loop
+ * is a plain gather-and-add the compiler can unroll.
+ */
+template <bool Weighted>
+void SmoothRange(const TileAdjacency& adjacency, const float* source, float* destination,
+                 const SmoothingOptions& options, size_t begin, size_t end) {
+    const uint32_t* offsets = adjacency.offsets.data();
+    const int* neighbors = adjacency.neighbors.data();
+    const float* weights = options.edgeWeights.data();
+    const uint8_t* mask = options.mask.empty() ? nullptr : options.mask.data();
+
+    for (size_t i = begin; i < end; ++i) {
+        const float value = source[i];
+        if (mask && !mask[i]) {
+            destination[i] = value;
+            continue;
+        }
+
+        float sum = options.selfWeight * value;
+        float totalWeight = options.selfWeight;
+        for (uint32_t e = offsets[i]; e < offsets[i + 1]; ++e) {
+            if constexpr (Weighted) {
+                sum += weights[e] * source[neighbors[e]];
+                totalWeight += weights[e];
+            } else {
+                sum += source[neighbors[e]];
+                totalWeight += 1.0f;
+            }
+        }
+
+        // Interpolated rather than stepped towards the average, so a full
+        // blend yields the average itself, bit for bit
+        destination[i] = totalWeight > 0.0f ? value * (1.0f - options.blend) + (sum / totalWeight) * options.blend : value;
+    }
+}
+
+} // namespace
+
+TileAdjacency TileAdjacency::Build(const World& world) {
+    const auto& tiles = world.GetTiles();
+
+    TileAdjacency adjacency;
+    adjacency.offsets.resize(tiles.size() + 1);
+    adjacency.offsets[0] = 0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        adjacency.offsets[i + 1] = adjacency.offsets[i] + static_cast<uint32_t>(tiles[i].GetNeighbors().size());
+    }
+
+    adjacency.neighbors.reserve(adjacency.offsets.back());
+    for (const auto& tile : tiles) {
+        for (int neighborIdx : tile.GetNeighbors()) {
+            adjacency.neighbors.push_back(neighborIdx);
+        }
+    }
+    return adjacency;
+}
+
+void SmoothTileValues(const TileAdjacency& adjacency, std::span<float> values, const SmoothingOptions& options) {
+    const size_t tileCount = adjacency.GetTileCount();
+    if (values.size() != tileCount || (!options.mask.empty() && options.mask.size() != tileCount) ||
+        (!options.edgeWeights.empty() && options.edgeWeights.size() != adjacency.neighbors.size())) {
+        std::cerr << "ERROR: Smoothing columns do not match the adjacency graph (" << tileCount << " tiles)" << std::endl;
+        return;
+    }
+    if (tileCount == 0 || options.iterations <= 0) {
+        return;
+    }
+
+    auto pass = options.edgeWeights.empty() ? &SmoothRange<false> : &SmoothRange<true>;
+
+    // Double buffer: the first pass reads the caller's values, then the two
+    // buffers swap roles; an odd pass count leaves the result in scratch
+    std::vector<float> scratch(tileCount);
+    float* source = values.data();
+    float* destination = scratch.data();
+
+    ThreadPool& pool = ThreadPool::GetInstance();
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        pool.ParallelFor(tileCount, [&](size_t begin, size_t end) {
+            pass(adjacency, source, destination, options, begin, end);
+        }, nullptr, kMinTilesPerRange);
+        std::swap(source, destination);
+    }
+
+    if (source != values.data()) {
+        std::copy(scratch.begin(), scratch.end(), values.begin());
+    }
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+namespace WorldGen {
+namespace Generators {
+
+// Forward declaration
+class World;
+
+/**
+ * @brief Flat (CSR) copy of the tile adjacency graph
+ *
+ * The neighbours of tile i are neighbors[offsets[i], offsets[i + 1]). Keeping
+ * the graph in two flat arrays lets the smoothing kernel stream through it
+ * without touching the much larger Tile objects.
+ */
+struct TileAdjacency {
+    std::vector<uint32_t> offsets;  // tileCount + 1 row offsets into neighbors
+    std::vector<int> neighbors;     // Neighbour tile indices, row by row
+
+    /**
+     * @brief Build the adjacency graph of a world's tiles
+     *
+     * @param world The world to read neighbours from
+     * @return TileAdjacency The flattened graph
+     */
+    static TileAdjacency Build(const World& world);
+
+    size_t GetTileCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    std::span<const int> GetNeighbors(size_t tileIndex) const {
+        return std::span<const int>(neighbors.data() + offsets[tileIndex], offsets[tileIndex + 1] - offsets[tileIndex]);
+    }
+};
+
+/**
+ * @brief Options for SmoothTileValues
+ *
+ * Each iteration replaces a tile's value v with
+ *
+ *   v * (1 - blend) + average * blend,   average = (selfWeight * v + sum(w_ij * v_j)) / (selfWeight + sum(w_ij))
+ *
+ * where w_ij is the weight of the edge to neighbour j. Tiles whose total
+ * weight is zero keep their value. With the default options a pass gives
+ * exactly the float result of summing the tile and its neighbours in order
+ * and dividing by their count.
+ */
+struct SmoothingOptions {
+    int iterations = 1;                  // Number of smoothing passes
+    float selfWeight = 1.0f;             // Weight of the tile's own value in the average
+    float blend = 1.0f;                  // How far each pass moves a tile towards the average (0-1)
+    std::span<const uint8_t> mask;       // Per tile: non-zero to smooth (empty smooths every tile)
+    std::span<const float> edgeWeights;  // Per adjacency entry weight, parallel to TileAdjacency::neighbors (empty = 1)
+};
+
+/**
+ * @brief Smooth a per-tile value column over the tile adjacency graph
+ *
+ * Every pass reads from one buffer and writes to the other, so results never
+ * depend on tile order or thread count. Large worlds are split across the
+ * shared ThreadPool by tile range.
+ *
+ * @param adjacency Tile adjacency graph
+ * @param values Per-tile values, smoothed in place
+ * @param options Iterations, weights and mask
+ */
+void SmoothTileValues(const TileAdjacency& adjacency, std::span<float> values, const SmoothingOptions& options = {});
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,198 @@
+#include "Hydrology.h"
+#include "World.h"
+#include "Tile.h"
+#include "TaskGraph.h"
+#include "../ProgressTracker.h"
+#include "../Core/WorldGenParameters.h"
+#include <algorithm>
+#include <iostream>
+#include <queue>
+
+namespace WorldGen {
+namespace Generators {
+
+HydrologyData GenerateHydrology(const World& world, const HydrologyParams& params,
+                                std::shared_ptr<ProgressTracker> progressTracker) {
+    HydrologyData data;
+    const auto& tiles = world.GetTiles();
+    const size_t tileCount = tiles.size();
+    if (tileCount == 0) {
+        std::cerr << "Error: No tiles for hydrology generation" << std::endl;
+        return data;
+    }
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.0f, "Filling depressions...");
+    }
+
+    // Use planet's physical radius as sea level reference
+    const float seaLevel = PlanetParameters().physicalRadiusMeters;
+
+    data.flowDirection.assign(tileCount, -1);
+    data.discharge.assign(tileCount, 0.0f);
+    data.lakeId.assign(tileCount, -1);
+    data.waterSurface.resize(tileCount);
+    std::vector<float>& water = data.waterSurface;
+
+    // Step 1: Priority-flood from the ocean. A tile is reached at the lowest
+    // water level that can spill into it, which is the filled surface.
+    using QueueEntry = std::pair<float, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> frontier;
+    std::vector<int> pit;       // Tiles flooded at the current level, in FIFO order
+    size_t pitHead = 0;
+    std::vector<uint8_t> visited(tileCount, 0);
+    std::vector<int> order;     // Visiting order: receivers always come before their donors
+    std::vector<int> floodedFrom(tileCount, -1);
+    order.reserve(tileCount);
+
+    for (size_t i = 0; i < tileCount; ++i) {
+        float elevation = tiles[i].GetElevation();
+        water[i] = elevation;
+        if (elevation < seaLevel) {
+            visited[i] = 1;
+            frontier.emplace(elevation, static_cast<int>(i));
+        }
+    }
+
+    // A world without ocean drains through its lowest tile
+    if (frontier.empty()) {
+        int lowest = 0;
+        for (size_t i = 1; i < tileCount; ++i) {
+            if (water[i] < water[lowest]) {
+                lowest = static_cast<int>(i);
+            }
+        }
+        visited[lowest] = 1;
+        frontier.emplace(water[lowest], lowest);
+    }
+
+    while (pitHead < pit.size() || !frontier.empty()) {
+        int tileIdx;
+        if (pitHead < pit.size()) {
+            tileIdx = pit[pitHead++];
+        } else {
+            tileIdx = frontier.top().second;
+            frontier.pop();
+            pit.clear();
+            pitHead = 0;
+        }
+        order.push_back(tileIdx);
+        if ((order.size() & 0xFFFF) == 0 && IsGenerationCancelled()) {
+            return data;
+        }
+
+        for (int neighborIdx : tiles[tileIdx].GetNeighbors()) {
+            if (visited[neighborIdx]) {
+                continue;
+            }
+            visited[neighborIdx] = 1;
+            floodedFrom[neighborIdx] = tileIdx;
+
+            if (water[neighborIdx] <= water[tileIdx]) {
+                // In a depression: the water stands at the level it spilled in at
+                water[neighborIdx] = water[tileIdx];
+                pit.push_back(neighborIdx);
+            } else {
+                frontier.emplace(water[neighborIdx], neighborIdx);
+            }
+        }
+    }
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.5f, "Routing rivers...");
+    }
+
+    // Step 2: Flow directions. Where the filled surface slopes, water takes the
+    // lowest neighbor; across lakes and flats it follows the flood back to
+    // the outlet. Either way the receiver is visited earlier, so there are no cycles.
+    ThreadPool::GetInstance().ParallelFor(tileCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (floodedFrom[i] < 0) {
+                continue; // Ocean and outlet tiles
+            }
+
+            int receiver = floodedFrom[i];
+            float lowestWater = water[i];
+            for (int neighborIdx : tiles[i].GetNeighbors()) {
+                if (water[neighborIdx] < lowestWater) {
+                    lowestWater = water[neighborIdx];
+                    receiver = neighborIdx;
+                }
+            }
+            data.flowDirection[i] = receiver;
+        }
+    });
+
+    // Step 3: Accumulate runoff downstream, donors before receivers
+    for (size_t i = 0; i < tileCount; ++i) {
+        if (floodedFrom[i] >= 0) {
+            data.discharge[i] = tiles[i].GetMoisture();
+        }
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int receiver = data.flowDirection[*it];
+        if (receiver >= 0) {
+            data.discharge[receiver] += data.discharge[*it];
+        }
+    }
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.8f, "Finding lakes...");
+    }
+
+    // Step 4: Lakes are connected flooded tiles sharing one water level
+    std::fill(visited.begin(), visited.end(), 0);
+    std::vector<int> component;
+    size_t lakeTiles = 0;
+    for (size_t i = 0; i < tileCount; ++i) {
+        if (visited[i] || floodedFrom[i] < 0 || water[i] <= tiles[i].GetElevation()) {
+            continue;
+        }
+
+        const float level = water[i];
+        float maxDepth = 0.0f;
+        component.clear();
+        component.push_back(static_cast<int>(i));
+        visited[i] = 1;
+        for (size_t next = 0; next < component.size(); ++next) {
+            int tileIdx = component[next];
+            maxDepth = std::max(maxDepth, level - tiles[tileIdx].GetElevation());
+            for (int neighborIdx : tiles[tileIdx].GetNeighbors()) {
+                if (!visited[neighborIdx] && floodedFrom[neighborIdx] >= 0 && water[neighborIdx] == level &&
+                    level > tiles[neighborIdx].GetElevation()) {
+                    visited[neighborIdx] = 1;
+                    component.push_back(neighborIdx);
+                }
+            }
+        }
+
+        if (maxDepth >= params.minimumLakeDepth) {
+            for (int tileIdx : component) {
+                data.lakeId[tileIdx] = data.lakeCount;
+            }
+            data.lakeCount++;
+            lakeTiles += component.size();
+        }
+    }
+
+    size_t riverTiles = 0;
+    float maxDischarge = 0.0f;
+    for (size_t i = 0; i < tileCount; ++i) {
+        if (floodedFrom[i] >= 0 && data.lakeId[i] < 0 && data.discharge[i] >= params.riverDischarge) {
+            riverTiles++;
+        }
+        maxDischarge = std::max(maxDischarge, data.discharge[i]);
+    }
+
+    std::cout << "Hydrology: " << data.lakeCount << " lakes covering " << lakeTiles << " tiles, "
+              << riverTiles << " river tiles, largest discharge " << maxDischarge << std::endl;
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(1.0f, "Hydrology complete");
+    }
+
+    return data;
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+
+namespace WorldGen {
+
+// Forward declarations
+class ProgressTracker;
+
+namespace Generators {
+
+// Forward declarations
+class World;
+
+/**
+ * @brief Drainage of every tile, as flat per-tile arrays
+ *
+ * Water flows from each land tile to its receiver, so following
+ * flowDirection from any tile walks downhill (or across a lake) to the sea.
+ */
+struct HydrologyData {
+    std::vector<int> flowDirection;   // Per tile: receiving neighbor (-1 for ocean tiles and sinks)
+    std::vector<float> discharge;     // Per tile: runoff of the tile and everything upstream of it
+    std::vector<int> lakeId;          // Per tile: index of the lake it lies in (-1 if none)
+    std::vector<float> waterSurface;  // Per tile: elevation with depressions filled up to their spill level
+    int lakeCount = 0;
+
+    bool IsEmpty() const { return flowDirection.empty(); }
+};
+
+/**
+ * @brief Parameters for the hydrology phase
+ */
+struct HydrologyParams {
+    float riverDischarge = 50.0f;   // Discharge above which a tile counts as a river (in tiles of full runoff)
+    float minimumLakeDepth = 1.0f;  // Depressions shallower than this (meters) are treated as flats, not lakes
+};
+
+/**
+ * @brief Route water over the tile graph and find rivers and lakes
+ *
+ * Runs a priority-flood from the ocean inwards: tiles are visited in order
+ * of the water level needed to reach them, so every depression is filled up
+ * to its spill point on the way and each tile's receiver is the tile it was
+ * flooded from, or its steepest lower neighbor where the filled surface
+ * slopes. Tiles that flood at their own level go through a FIFO queue
+ * instead of the heap, which keeps filled depressions O(1) per tile.
+ * The visiting order is also a topological order of the drainage forest,
+ * so discharge is accumulated in one reverse pass. Total cost is
+ * O(N log N) for N tiles.
+ *
+ * Ocean tiles (below the planet radius) are the outlets. Each land tile
+ * contributes its moisture as runoff.
+ *
+ * @param world The world to route water over; elevations are in meters from the planet center
+ * @param params Thresholds for rivers and lakes
+ * @param progressTracker Optional progress tracker for UI updates
+ * @return HydrologyData Flow direction, discharge and lakes for every tile
+ */
+HydrologyData GenerateHydrology(const World& world, const HydrologyParams& params = {},
+                                std::shared_ptr<ProgressTracker> progressTracker = nullptr);
+
+} // namespace Generators
+} // namespace WorldGen
@@ -1,6 +1,9 @@
 #include "Mountain.h"
 #include "World.h"
 #include "Tile.h"
+#include "TaskGraph.h"
+#include "GraphSmoothing.h"
+#include "SphereNoise.h"
 #include "../ProgressTracker.h"
 #include "../Core/TerrainTypes.h"
 #include "../Core/WorldGenParameters.h"
@@ -14,6 +17,36 @@
 namespace WorldGen {
 namespace Generators {
 
+namespace {
+
+/**
+ * @brief Classify the boundary between two plates at one point
+ */
+BoundaryInfo MakeBoundaryInfo(const Plate& plate1, const Plate& plate2, const glm::vec3& boundaryPos) {
+    // Determine boundary type and stress
+    auto [boundaryType, stress] = DetermineBoundaryType(plate1, plate2, boundaryPos);
+    
+    // Calculate boundary normal
+    glm::vec3 boundaryDirection = glm::normalize(plate2.center - plate1.center);
+    glm::vec3 boundaryNormal = glm::cross(boundaryPos, boundaryDirection);
+    if (glm::length(boundaryNormal) > 0.001f) {
+        boundaryNormal = glm::normalize(boundaryNormal);
+    } else {
+        boundaryNormal = glm::vec3(0, 1, 0); // fallback
+    }
+    
+    BoundaryInfo boundary;
+    boundary.plateId1 = plate1.id;
+    boundary.plateId2 = plate2.id;
+    boundary.position = boundaryPos;
+    boundary.normal = boundaryNormal;
+    boundary.type = boundaryType;
+    boundary.stress = stress;
+    return boundary;
+}
+
+} // namespace
+
 std::vector<BoundaryInfo> AnalyzePlateBoundaries(World* world, const std::vector<Plate>& plates) {
     if (!world || plates.empty()) {
         return {};
@@ -62,33 +95,13 @@ std::vector<BoundaryInfo> AnalyzePlateBoundaries(World* world, const std::vector
                             glm::vec3 pos2 = glm::normalize(tiles[neighborIdx].GetCenter());
                             glm::vec3 boundaryPos = glm::normalize((pos1 + pos2) * 0.5f);
                             
-                            // Determine boundary type and stress
-                            auto [boundaryType, stress] = DetermineBoundaryType(*platePtr1, *platePtr2, boundaryPos);
-                            
-                            // Calculate boundary normal
-                            glm::vec3 boundaryDirection = glm::normalize(platePtr2->center - platePtr1->center);
-                            glm::vec3 boundaryNormal = glm::cross(boundaryPos, boundaryDirection);
-                            if (glm::length(boundaryNormal) > 0.001f) {
-                                boundaryNormal = glm::normalize(boundaryNormal);
-                            } else {
-                                boundaryNormal = glm::vec3(0, 1, 0); // fallback
-                            }
-                            
-                            // Create boundary info
-                            BoundaryInfo boundary;
-                            boundary.plateId1 = plate1;
-                            boundary.plateId2 = plate2;
-                            boundary.position = boundaryPos;
-                            boundary.normal = boundaryNormal;
-                            boundary.type = boundaryType;
-                            boundary.stress = stress;
-                            
+                            BoundaryInfo boundary = MakeBoundaryInfo(*platePtr1, *platePtr2, boundaryPos);
                             boundaries.push_back(boundary);
                             
-                            std::string typeStr = (boundaryType == BoundaryType::Convergent) ? "convergent" :
-                                                 (boundaryType == BoundaryType::Divergent) ? "divergent" : "transform";
+                            std::string typeStr = (boundary.type == BoundaryType::Convergent) ? "convergent" :
+                                                 (boundary.type == BoundaryType::Divergent) ? "divergent" : "transform";
                             std::cout << "Boundary " << plate1 << "-" << plate2 
-                                      << ": " << typeStr << " (stress: " << stress << ")" << std::endl;
+                                      << ": " << typeStr << " (stress: " << boundary.stress << ")" << std::endl;
                         }
                     }
                 }
@@ -100,6 +113,63 @@ std::vector<BoundaryInfo> AnalyzePlateBoundaries(World* world, const std::vector
     return boundaries;
 }
 
+PlateBoundaryField BuildPlateBoundaryField(const World& world, const TileAdjacency& adjacency,
+                                           const std::vector<Plate>& plates, float maxDistance) {
+    const auto& tiles = world.GetTiles();
+    PlateBoundaryField boundaryField;
+    
+    // Plate ids are normally their index, but look them up to be safe
+    int maxPlateId = -1;
+    for (const auto& plate : plates) {
+        maxPlateId = std::max(maxPlateId, plate.id);
+    }
+    std::vector<const Plate*> plateById(maxPlateId + 1, nullptr);
+    for (const auto& plate : plates) {
+        if (plate.id >= 0) {
+            plateById[plate.id] = &plate;
+        }
+    }
+    auto findPlate = [&plateById](int plateId) -> const Plate* {
+        return (plateId >= 0 && plateId < static_cast<int>(plateById.size())) ? plateById[plateId] : nullptr;
+    };
+    
+    // Each boundary tile owns the segment towards its first neighbour on another plate
+    for (size_t tileIdx = 0; tileIdx < tiles.size(); ++tileIdx) {
+        const auto& tile = tiles[tileIdx];
+        const Plate* tilePlate = findPlate(tile.GetPlateId());
+        if (!tilePlate) continue;
+        
+        for (int neighborIdx : adjacency.GetNeighbors(tileIdx)) {
+            const Plate* neighborPlate = findPlate(tiles[neighborIdx].GetPlateId());
+            if (!neighborPlate || neighborPlate == tilePlate) continue;
+            
+            glm::vec3 pos1 = glm::normalize(tile.GetCenter());
+            glm::vec3 pos2 = glm::normalize(tiles[neighborIdx].GetCenter());
+            glm::vec3 boundaryPos = glm::normalize((pos1 + pos2) * 0.5f);
+            
+            // Same plate order as AnalyzePlateBoundaries so both sides agree on the type
+            bool tileFirst = tilePlate->id < neighborPlate->id;
+            boundaryField.segments.push_back(MakeBoundaryInfo(tileFirst ? *tilePlate : *neighborPlate,
+                                                              tileFirst ? *neighborPlate : *tilePlate, boundaryPos));
+            boundaryField.segmentTiles.push_back(static_cast<int>(tileIdx));
+            break;
+        }
+    }
+    
+    DistanceFieldOptions options;
+    options.maxDistance = maxDistance;
+    boundaryField.field = ComputeTileDistanceField(world, adjacency, boundaryField.segmentTiles, options);
+    
+    size_t typeCounts[3] = {0, 0, 0};
+    for (const auto& segment : boundaryField.segments) {
+        typeCounts[static_cast<int>(segment.type)]++;
+    }
+    std::cout << "Found " << boundaryField.segments.size() << " boundary tiles (" << typeCounts[0] << " convergent, "
+              << typeCounts[1] << " divergent, " << typeCounts[2] << " transform)" << std::endl;
+    
+    return boundaryField;
+}
+
 std::pair<BoundaryType, float> DetermineBoundaryType(const Plate& plate1, const Plate& plate2, 
                                                     const glm::vec3& boundaryPosition) {
     // Calculate relative movement at boundary
@@ -230,7 +300,7 @@ float ApplyIsostaticAdjustment(float elevation) {
     return elevation;
 }
 
-void GenerateComprehensiveMountains(World* world, const std::vector<Plate>& plates,
+void GenerateComprehensiveMountains(World* world, const std::vector<Plate>& plates, uint64_t seed,
                                    std::shared_ptr<ProgressTracker> progressTracker) {
     if (!world || plates.empty()) {
         std::cerr << "Error: Invalid world or no plates for mountain generation" << std::endl;
@@ -241,18 +311,24 @@ void GenerateComprehensiveMountains(World* world, const std::vector<Plate>& plat
         progressTracker->UpdateProgress(0.0f, "Starting comprehensive mountain generation...");
     }
     
-    const auto& tiles = world->GetTiles();
+    auto& tiles = world->GetTiles();
     std::cout << "Generating comprehensive mountains for " << tiles.size() 
               << " tiles across " << plates.size() << " plates..." << std::endl;
     
-    // Step 1: Analyze all plate boundaries
+    // Step 1: Find the plate boundaries and every tile's distance to them
     if (progressTracker) {
         progressTracker->UpdateProgress(0.1f, "Analyzing plate boundaries...");
     }
     
-    auto boundaries = AnalyzePlateBoundaries(world, plates);
+    const float maxInfluenceDistance = 0.25f; // Maximum distance for boundary influence
     
-    if (boundaries.empty()) {
+    TileAdjacency adjacency = TileAdjacency::Build(*world);
+    PlateBoundaryField boundaryField = BuildPlateBoundaryField(*world, adjacency, plates, maxInfluenceDistance);
+    if (IsGenerationCancelled()) {
+        return;
+    }
+    
+    if (boundaryField.segments.empty()) {
         std::cout << "No plate boundaries found - skipping mountain generation" << std::endl;
         return;
     }
@@ -263,98 +339,122 @@ void GenerateComprehensiveMountains(World* world, const std::vector<Plate>& plat
         plateMap[plate.id] = &plate;
     }
     
+    // Read-only lookup, safe to share between the worker threads below
+    auto findPlate = [&plateMap](int plateId) -> const Plate* {
+        auto it = plateMap.find(plateId);
+        return it != plateMap.end() ? it->second : nullptr;
+    };
+    
     if (progressTracker) {
         progressTracker->UpdateProgress(0.2f, "Calculating elevations for all tiles...");
     }
     
-    // Step 3: Calculate comprehensive elevation for ALL tiles
-    const float maxInfluenceDistance = 0.25f; // Maximum distance for boundary influence
+    // Relief along transform faults, about as coarse as the plate boundaries
+    NoiseSettings transformNoise;
+    transformNoise.octaves = 3;
+    transformNoise.frequency = 6.0f;
+    transformNoise.seed = static_cast<uint32_t>(seed);
     
-    for (size_t tileIdx = 0; tileIdx < tiles.size(); ++tileIdx) {
-        const auto& tile = tiles[tileIdx];
-        int tilePlateId = tile.GetPlateId();
-        
-        if (tilePlateId < 0) {
-            continue; // Skip unassigned tiles
+    // Step 3: Calculate comprehensive elevation for ALL tiles
+    // Each range counts the tiles it shaped per boundary type
+    using BoundaryHistogram = Histogram<3>;
+    ThreadPool& pool = ThreadPool::GetInstance();
+    BoundaryHistogram shapedTiles = pool.ParallelReduce(tiles.size(), BoundaryHistogram{}, [&](size_t begin, size_t end, BoundaryHistogram& shaped) {
+        // Transform relief for the whole range in one batch
+        std::vector<glm::vec3> rangeCenters(end - begin);
+        for (size_t tileIdx = begin; tileIdx < end; ++tileIdx) {
+            rangeCenters[tileIdx - begin] = glm::normalize(tiles[tileIdx].GetCenter());
         }
+        std::vector<float> transformRelief(end - begin);
+        FillNoise(rangeCenters, transformNoise, transformRelief);
         
-        const Plate* tileplate = plateMap[tilePlateId];
-        if (!tileplate) continue;
-        
-        // Start with the tile's existing elevation (preserves terrain variation)
-        float newElevation = tile.GetElevation();
-        
-        glm::vec3 tilePos = glm::normalize(tile.GetCenter());
-        
-        // Calculate influence from all relevant boundaries
-        for (const auto& boundary : boundaries) {
-            // Calculate distance from tile to boundary
-            float distance = glm::distance(tilePos, boundary.position);
+        for (size_t tileIdx = begin; tileIdx < end; ++tileIdx) {
+            auto& tile = tiles[tileIdx];
+            int tilePlateId = tile.GetPlateId();
             
-            // Only apply influence if within range
-            if (distance < maxInfluenceDistance) {
+            if (tilePlateId < 0) {
+                continue; // Skip unassigned tiles
+            }
+            
+            const Plate* tileplate = findPlate(tilePlateId);
+            if (!tileplate) continue;
+            
+            // Start with the tile's existing elevation (preserves terrain variation)
+            float newElevation = tile.GetElevation();
+            
+            glm::vec3 tilePos = glm::normalize(tile.GetCenter());
+            
+            // Influence of the nearest boundary segment, if within range
+            const BoundaryInfo* boundary = boundaryField.GetSegment(tileIdx);
+            float distance = boundaryField.GetDistance(tileIdx);
+            
+            if (boundary && distance < maxInfluenceDistance) {
                 float influence = CalculateInfluence(distance, maxInfluenceDistance);
                 
                 if (influence > 0.01f) { // Only process if significant influence
-                    const Plate* plate1 = plateMap[boundary.plateId1];
-                    const Plate* plate2 = plateMap[boundary.plateId2];
+                    const Plate* plate1 = findPlate(boundary->plateId1);
+                    const Plate* plate2 = findPlate(boundary->plateId2);
                     
                     if (plate1 && plate2) {
                         float elevationChange = 0.0f;
                         
-                        if (boundary.type == BoundaryType::Convergent) {
+                        if (boundary->type == BoundaryType::Convergent) {
                             // Mountain formation from collision
-                            float normalizedStress = boundary.stress / 1000.0f;
+                            float normalizedStress = boundary->stress / 1000.0f;
                             float mountainContribution = CalculateMountainHeight(normalizedStress, influence, 
                                                                                plate1->isOceanic, plate2->isOceanic);
                             
                             // Add folding pattern for realistic ridge formation
-                            float foldingContribution = ApplyFoldingPattern(tilePos, boundary.position, 
-                                                                           boundary.normal, distance, normalizedStress);
+                            float foldingContribution = ApplyFoldingPattern(tilePos, boundary->position, 
+                                                                           boundary->normal, distance, normalizedStress);
                             
                             elevationChange = (mountainContribution + foldingContribution) * 1000.0f; // Convert to meters
                             
-                        } else if (boundary.type == BoundaryType::Divergent) {
+                        } else if (boundary->type == BoundaryType::Divergent) {
                             // Rifting creates valleys and lower elevation
-                            float normalizedStress = boundary.stress / 500.0f;
+                            float normalizedStress = boundary->stress / 500.0f;
                             elevationChange = -normalizedStress * influence * 300.0f; // Rift valleys in meters
                             
-                        } else if (boundary.type == BoundaryType::Transform) {
+                        } else if (boundary->type == BoundaryType::Transform) {
                             // Transform boundaries create moderate relief variation
-                            float normalizedStress = boundary.stress / 200.0f;
-                            float noise = sin(tilePos.x * 6.0f) * cos(tilePos.z * 6.0f);
+                            float normalizedStress = boundary->stress / 200.0f;
+                            float noise = transformRelief[tileIdx - begin];
                             elevationChange = normalizedStress * influence * noise * 200.0f; // Transform relief in meters
                         }
                         
                         newElevation += elevationChange;
+                        shaped.Add(static_cast<size_t>(boundary->type));
                     }
                 }
             }
+            
+            // Apply isostatic adjustment for crustal thickening effects
+            newElevation = ApplyIsostaticAdjustment(newElevation);
+            
+            // No clamping needed for physical meter values
+            
+            // Set the new elevation
+            tile.SetElevation(newElevation);
+            
+            // Note: Terrain type will be set by the Biome generator based on final elevation
         }
-        
-        // Apply isostatic adjustment for crustal thickening effects
-        newElevation = ApplyIsostaticAdjustment(newElevation);
-        
-        // No clamping needed for physical meter values
-        
-        // Set the new elevation
-        const_cast<Tile&>(tile).SetElevation(newElevation);
-        
-        // Note: Terrain type will be set by the Biome generator based on final elevation
-        
-        // Report progress periodically
-        if (progressTracker && tileIdx % 1000 == 0) {
-            float progress = 0.2f + (static_cast<float>(tileIdx) / tiles.size()) * 0.8f;
-            progressTracker->UpdateProgress(progress, "Processing tile " + std::to_string(tileIdx) + "/" + std::to_string(tiles.size()));
+    }, [](BoundaryHistogram& total, const BoundaryHistogram& range) {
+        total += range;
+    }, [&](float fraction) {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(0.2f + fraction * 0.8f, "Calculating elevations for all tiles...");
         }
-    }
+    });
     
     if (progressTracker) {
         progressTracker->UpdateProgress(1.0f, "Comprehensive mountain generation complete!");
     }
     
     std::cout << "Comprehensive mountain generation complete - processed all " 
-              << tiles.size() << " tiles with " << boundaries.size() << " boundaries." << std::endl;
+              << tiles.size() << " tiles with " << boundaryField.segments.size() << " boundary tiles." << std::endl;
+    std::cout << "Tiles shaped by boundaries: " << shapedTiles[static_cast<size_t>(BoundaryType::Convergent)]
+              << " convergent, " << shapedTiles[static_cast<size_t>(BoundaryType::Divergent)] << " divergent, "
+              << shapedTiles[static_cast<size_t>(BoundaryType::Transform)] << " transform" << std::endl;
 }
 
 } // namespace Generators
@@ -4,6 +4,7 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include "Plate.h"
+#include "TileDistanceField.h"
 
 namespace WorldGen {
 
@@ -36,11 +37,52 @@ struct BoundaryInfo {
     glm::vec3 normal;       // Boundary normal direction
 };
 
+/**
+ * @brief Distance from every tile to the nearest plate boundary
+ *
+ * Every tile that touches a tile of another plate is a boundary tile and owns
+ * one boundary segment, classified from the plate motion at that tile, so the
+ * boundary type can change along a single plate pair. The distance field
+ * records, for every tile within range, how far it is from the nearest
+ * boundary tile and which segment that tile owns, so mountains, rifts and
+ * margins can look up their boundary in O(1) per tile.
+ */
+struct PlateBoundaryField {
+    std::vector<BoundaryInfo> segments; // One per boundary tile, in tile order
+    std::vector<int> segmentTiles;      // Boundary tile of each segment
+    TileDistanceField field;            // Distance to and index of the nearest segment, per tile
+    
+    /**
+     * @brief Get the nearest boundary segment of a tile
+     * 
+     * @param tileIndex Tile to look up
+     * @return const BoundaryInfo* The segment, or nullptr if the tile is out of range
+     */
+    const BoundaryInfo* GetSegment(size_t tileIndex) const {
+        int segmentIdx = field.nearestSource[tileIndex];
+        return segmentIdx >= 0 ? &segments[segmentIdx] : nullptr;
+    }
+    
+    float GetDistance(size_t tileIndex) const { return field.distance[tileIndex]; }
+};
+
+/**
+ * @brief Find the boundary tiles between plates and their distance field
+ * 
+ * @param world The world containing tiles with plate assignments
+ * @param adjacency Tile adjacency graph of the world
+ * @param plates The tectonic plates
+ * @param maxDistance Tiles farther than this from every boundary are left out of the field
+ * @return PlateBoundaryField The boundary segments and the distance to them
+ */
+PlateBoundaryField BuildPlateBoundaryField(const World& world, const TileAdjacency& adjacency,
+                                           const std::vector<Plate>& plates, float maxDistance);
+
 /**
  * @brief Generate comprehensive mountain systems based on plate tectonics
  * 
  * This function implements advanced mountain formation using geological principles:
- * - Distance-based influence from plate boundaries
+ * - Distance-based influence from the nearest plate boundary (see PlateBoundaryField)
  * - Non-linear height calculations for realistic peaks
  * - Folding patterns for ridges and valleys
  * - Isostatic adjustment for crustal thickening
@@ -48,10 +90,12 @@ struct BoundaryInfo {
  * 
  * @param world The world containing tiles to modify
  * @param plates The tectonic plates with movement data
+ * @param seed Random seed for the transform-fault relief noise
  * @param progressTracker Optional progress tracking
  */
 void GenerateComprehensiveMountains(World* world, 
                                    const std::vector<Plate>& plates,
+                                   uint64_t seed,
                                    std::shared_ptr<ProgressTracker> progressTracker = nullptr);
 
 /**
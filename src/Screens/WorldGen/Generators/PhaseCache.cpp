@@ -0,0 +1,159 @@
+#include "PhaseCache.h"
+#include "World.h"
+#include "Tile.h"
+#include <iostream>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+thread_local bool tlsBypass = false; // Inside a PhaseCacheBypass on the current thread
+
+const char* GetPhaseName(PipelinePhase phase) {
+    switch (phase) {
+        case PipelinePhase::PlateGeneration: return "plate generation";
+        case PipelinePhase::PlateAssignment: return "plate assignment";
+        case PipelinePhase::ContinentalMargins: return "continental margins";
+        case PipelinePhase::Mountains: return "mountains";
+        case PipelinePhase::Erosion: return "erosion";
+        case PipelinePhase::Climate: return "climate";
+        case PipelinePhase::Biomes: return "biomes";
+        case PipelinePhase::Hydrology: return "hydrology";
+        default: return "unknown phase";
+    }
+}
+
+} // namespace
+
+PhaseCacheBypass::PhaseCacheBypass()
+    : savedBypass(tlsBypass) {
+    tlsBypass = true;
+}
+
+PhaseCacheBypass::~PhaseCacheBypass() {
+    tlsBypass = savedBypass;
+}
+
+PhaseCache& PhaseCache::GetInstance() {
+    static PhaseCache instance;
+    return instance;
+}
+
+bool PhaseCache::IsEnabledOnThisThread() {
+    return !tlsBypass;
+}
+
+bool PhaseCache::Restore(PipelinePhase phase, uint64_t key, World& world, std::vector<Plate>& plates) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const Entry& entry = entries[static_cast<size_t>(phase)];
+    if (!entry.valid || entry.key != key) {
+        return false;
+    }
+
+    // Phases without tile columns (plate generation) may run while the
+    // geometry phase is still building the tiles, so only touch them if needed
+    const bool hasTileColumns = !entry.plateIds.empty() || !entry.elevations.empty() || !entry.terrainTypes.empty() ||
+                                !entry.temperatures.empty();
+    const bool hasHydrology = !entry.hydrology.IsEmpty();
+
+    // Check every size before writing anything, so a mismatch leaves the world untouched
+    if (hasTileColumns || hasHydrology) {
+        const size_t tileCount = world.GetTileCount();
+        if ((!entry.plateIds.empty() && entry.plateIds.size() != tileCount) ||
+            (!entry.elevations.empty() && entry.elevations.size() != tileCount) ||
+            (!entry.terrainTypes.empty() && entry.terrainTypes.size() != tileCount) ||
+            (!entry.temperatures.empty() && entry.temperatures.size() != tileCount) ||
+            (hasHydrology && entry.hydrology.flowDirection.size() != tileCount)) {
+            std::cerr << "WARNING: Cached " << GetPhaseName(phase) << " output does not match the world's tiles" << std::endl;
+            return false;
+        }
+    }
+
+    if (hasTileColumns) {
+        auto& tiles = world.GetTiles();
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            if (!entry.plateIds.empty()) {
+                tiles[i].SetPlateId(entry.plateIds[i]);
+            }
+            if (!entry.elevations.empty()) {
+                tiles[i].SetElevation(entry.elevations[i]);
+            }
+            if (!entry.terrainTypes.empty()) {
+                tiles[i].SetTerrainType(static_cast<TerrainType>(entry.terrainTypes[i]));
+                tiles[i].SetBiomeType(static_cast<BiomeType>(entry.biomeTypes[i]));
+            }
+            if (!entry.temperatures.empty()) {
+                tiles[i].SetTemperature(entry.temperatures[i]);
+                tiles[i].SetMoisture(entry.moistures[i]);
+            }
+        }
+    }
+
+    if (!entry.plates.empty()) {
+        plates = entry.plates;
+    }
+    
+    if (hasHydrology) {
+        world.SetHydrology(entry.hydrology);
+    }
+
+    std::cout << "Reusing cached " << GetPhaseName(phase) << " output" << std::endl;
+    return true;
+}
+
+void PhaseCache::Store(PipelinePhase phase, uint64_t key, uint32_t outputs, const World& world,
+                       const std::vector<Plate>& plates) {
+    Entry entry;
+    entry.valid = true;
+    entry.key = key;
+    if (outputs & PhaseOutputPlates) {
+        entry.plates = plates;
+    }
+    const std::vector<Tile>& tiles = world.GetTiles();
+    if (outputs & PhaseOutputPlateIds) {
+        entry.plateIds.resize(tiles.size());
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            entry.plateIds[i] = tiles[i].GetPlateId();
+        }
+    }
+    if (outputs & PhaseOutputElevations) {
+        entry.elevations.resize(tiles.size());
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            entry.elevations[i] = tiles[i].GetElevation();
+        }
+    }
+    if (outputs & PhaseOutputClassification) {
+        entry.terrainTypes.resize(tiles.size());
+        entry.biomeTypes.resize(tiles.size());
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            entry.terrainTypes[i] = static_cast<uint8_t>(tiles[i].GetTerrainType());
+            entry.biomeTypes[i] = static_cast<uint8_t>(tiles[i].GetBiomeType());
+        }
+    }
+    if (outputs & PhaseOutputClimate) {
+        entry.temperatures.resize(tiles.size());
+        entry.moistures.resize(tiles.size());
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            entry.temperatures[i] = tiles[i].GetTemperature();
+            entry.moistures[i] = tiles[i].GetMoisture();
+        }
+    }
+    if (outputs & PhaseOutputHydrology) {
+        entry.hydrology = world.GetHydrology();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[static_cast<size_t>(phase)] = std::move(entry);
+}
+
+void PhaseCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) {
+        entry = Entry{};
+    }
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "Plate.h"
+#include "Hydrology.h"
+
+namespace WorldGen {
+namespace Generators {
+
+// Forward declaration
+class World;
+
+/**
+ * @brief Hash of everything a pipeline phase consumes
+ *
+ * Built by chaining the keys of the phases it reads from with the parameters
+ * and seeds it uses, so a phase's key changes whenever any of its inputs do.
+ */
+class PhaseKey {
+public:
+    PhaseKey() = default;
+
+    /**
+     * @brief Mix a value into the key
+     *
+     * @param value Any trivially copyable value without padding
+     * @return PhaseKey& This key, for chaining
+     */
+    template <typename T>
+    PhaseKey& Add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "PhaseKey can only hash trivially copyable values");
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return *this;
+    }
+
+    uint64_t Get() const { return hash; }
+
+private:
+    uint64_t hash = 1469598103934665603ull; // 64-bit FNV-1a offset basis
+};
+
+/**
+ * @brief Phases of Generator::CreateWorld whose outputs are memoized
+ *
+ * The base geometry has its own cache (GeometryCache).
+ */
+enum class PipelinePhase {
+    PlateGeneration,
+    PlateAssignment,
+    ContinentalMargins,
+    Mountains,
+    Erosion,
+    Climate,
+    Biomes,
+    Hydrology,
+    Count
+};
+
+/**
+ * @brief Per-tile state a phase writes, used to pick which columns are cached
+ */
+enum PhaseOutputs : uint32_t {
+    PhaseOutputPlates = 1 << 0,         // The plate list (including tile lists)
+    PhaseOutputPlateIds = 1 << 1,       // Tile::GetPlateId
+    PhaseOutputElevations = 1 << 2,     // Tile::GetElevation
+    PhaseOutputClassification = 1 << 3, // Tile::GetTerrainType and Tile::GetBiomeType
+    PhaseOutputHydrology = 1 << 4,      // World::GetHydrology
+    PhaseOutputClimate = 1 << 5         // Tile::GetTemperature and Tile::GetMoisture
+};
+
+/**
+ * @brief Memoized outputs of the last run of each pipeline phase
+ *
+ * Each phase stores only the columns it writes, together with its key. When
+ * CreateWorld runs again, a phase whose key is unchanged copies its cached
+ * columns into the world instead of running, so changing a late-stage input
+ * only reruns that phase and the ones after it. Phases are deterministic, so
+ * a cached phase stays valid even when an earlier phase had to rerun.
+ */
+class PhaseCache {
+public:
+    /**
+     * @brief Get the process-wide phase cache
+     *
+     * @return PhaseCache& The shared cache
+     */
+    static PhaseCache& GetInstance();
+
+    /**
+     * @brief Apply a phase's cached output if its key matches
+     *
+     * @param phase The phase
+     * @param key Key of the phase's current inputs
+     * @param world World to copy cached tile columns into
+     * @param plates Plate list to replace if the phase outputs plates
+     * @return true if the cached output was applied and the phase can be skipped
+     */
+    bool Restore(PipelinePhase phase, uint64_t key, World& world, std::vector<Plate>& plates);
+
+    /**
+     * @brief Remember a phase's output
+     *
+     * @param phase The phase that just ran
+     * @param key Key of the inputs it ran with
+     * @param outputs PhaseOutputs flags naming what the phase writes
+     * @param world World after the phase ran
+     * @param plates Plate list after the phase ran
+     */
+    void Store(PipelinePhase phase, uint64_t key, uint32_t outputs, const World& world, const std::vector<Plate>& plates);
+
+    /**
+     * @brief Drop every cached phase output
+     */
+    void Clear();
+
+    /**
+     * @brief Whether CreateWorld on the calling thread should use the cache
+     *
+     * @return false inside a PhaseCacheBypass
+     */
+    static bool IsEnabledOnThisThread();
+
+private:
+    PhaseCache() = default;
+
+    struct Entry {
+        bool valid = false;
+        uint64_t key = 0;
+        std::vector<Plate> plates;
+        std::vector<int> plateIds;
+        std::vector<float> elevations;
+        std::vector<uint8_t> terrainTypes;
+        std::vector<uint8_t> biomeTypes;
+        std::vector<float> temperatures;
+        std::vector<float> moistures;
+        HydrologyData hydrology;
+    };
+
+    std::mutex mutex;
+    std::array<Entry, static_cast<size_t>(PipelinePhase::Count)> entries;
+};
+
+/**
+ * @brief Keeps CreateWorld calls on the calling thread away from the phase cache for the lifetime of the scope
+ *
+ * For speculative builds: every phase key includes the seed, so a build for
+ * a seed nobody has asked for yet can never be reused and would only evict
+ * the outputs the foreground's next generation could have reused.
+ */
+class PhaseCacheBypass {
+public:
+    PhaseCacheBypass();
+    ~PhaseCacheBypass();
+
+    PhaseCacheBypass(const PhaseCacheBypass&) = delete;
+    PhaseCacheBypass& operator=(const PhaseCacheBypass&) = delete;
+
+private:
+    bool savedBypass;
+};
+
+} // namespace Generators
+} // namespace WorldGen
@@ -1,6 +1,10 @@
 #include "Plate.h"
 #include "World.h"
 #include "Tile.h"
+#include "GraphSmoothing.h"
+#include "TileDistanceField.h"
+#include "TaskGraph.h"
+#include "CounterRandom.h"
 #include "../ProgressTracker.h"
 #include "../Core/WorldGenParameters.h"
 #include <algorithm>
@@ -14,8 +18,7 @@ namespace WorldGen {
 namespace Generators {
 
 std::vector<glm::vec3> GenerateWellDistributedPoints(int numSamples, uint64_t seed) {
-    std::mt19937_64 rng(seed);
-    std::uniform_real_distribution<float> uniform01(0.0f, 1.0f);
+    const CounterRandom random(seed, RandomStream::PlateCenters);
     
     std::vector<glm::vec3> points;
     points.reserve(numSamples);
@@ -30,10 +33,10 @@ std::vector<glm::vec3> GenerateWellDistributedPoints(int numSamples, uint64_t se
         float theta = goldenAngle * i;
         
         // Add randomness to avoid perfect patterns
-        y += (uniform01(rng) - 0.5f) * 0.4f;
+        y += (random.Uniform01(i, 0) - 0.5f) * 0.4f;
         y = glm::clamp(y, -0.98f, 0.98f);
         radius = sqrt(1.0f - y * y);
-        theta += (uniform01(rng) - 0.5f) * 0.6f;
+        theta += (random.Uniform01(i, 1) - 0.5f) * 0.6f;
         
         glm::vec3 point(
             cos(theta) * radius,
@@ -52,8 +55,7 @@ std::vector<Plate> GeneratePlates(World* world, int numPlates, uint64_t seed,
         progressTracker->UpdateProgress(0.0f, "Generating tectonic plates...");
     }
     
-    std::mt19937_64 rng(seed);
-    std::uniform_real_distribution<float> uniform01(0.0f, 1.0f);
+    const CounterRandom random(seed, RandomStream::PlateProperties);
     
     std::vector<Plate> plates;
     
@@ -79,8 +81,12 @@ std::vector<Plate> GeneratePlates(World* world, int numPlates, uint64_t seed,
         plate.id = i;
         plate.center = platePositions[i];
         plate.size = PlateSize::Major;
+        
+        // Each plate draws from its own sequence, so plates do not depend on each other
+        RandomSequence rng(random, static_cast<uint64_t>(i));
+        
         // Major plates: 30% oceanic (more realistic - most large plates are continental)
-        plate.isOceanic = uniform01(rng) < 0.3f;
+        plate.isOceanic = rng.Uniform01() < 0.3f;
         
         // Generate more realistic movement patterns
         // Real plates tend to move in coherent patterns, not completely random
@@ -97,9 +103,9 @@ std::vector<Plate> GeneratePlates(World* world, int numPlates, uint64_t seed,
         
         // Simulate a simplified mantle convection pattern
         // East-west movement influenced by longitude
-        float eastWestFlow = sin(longitude * 2.0f + uniform01(rng) * 3.14159f);
+        float eastWestFlow = sin(longitude * 2.0f + rng.Uniform01() * 3.14159f);
         // North-south movement influenced by latitude with some randomness
-        float northSouthFlow = cos(latitude * 1.5f + uniform01(rng) * 3.14159f);
+        float northSouthFlow = cos(latitude * 1.5f + rng.Uniform01() * 3.14159f);
         
         // Create movement vector in spherical tangent space
         glm::vec3 east = glm::normalize(glm::cross(plate.center, glm::vec3(0, 1, 0)));
@@ -108,7 +114,11 @@ std::vector<Plate> GeneratePlates(World* world, int numPlates, uint64_t seed,
         baseMovement = east * eastWestFlow + north * northSouthFlow;
         
         // Add some randomness but keep the coherent pattern
-        glm::vec3 randomComponent = glm::vec3(uniform01(rng)*2.0f-1.0f, uniform01(rng)*2.0f-1.0f, uniform01(rng)*2.0f-1.0f);
+        // (drawn one statement at a time; the evaluation order of constructor arguments is unspecified)
+        float randomX = rng.Uniform(-1.0f, 1.0f);
+        float randomY = rng.Uniform(-1.0f, 1.0f);
+        float randomZ = rng.Uniform(-1.0f, 1.0f);
+        glm::vec3 randomComponent(randomX, randomY, randomZ);
         randomComponent = glm::normalize(randomComponent - glm::dot(randomComponent, plate.center) * plate.center);
         
         // Blend coherent movement with random (70% coherent, 30% random)
@@ -116,10 +126,10 @@ std::vector<Plate> GeneratePlates(World* world, int numPlates, uint64_t seed,
         
         // Scale movement speed - oceanic plates tend to move faster
         float baseSpeed = plate.isOceanic ? 0.012f : 0.008f;
-        plate.movement *= baseSpeed * (0.5f + uniform01(rng) * 0.5f) * latitudeInfluence;
+        plate.movement *= baseSpeed * (0.5f + rng.Uniform01() * 0.5f) * latitudeInfluence;
         
         // Rotation rate is generally smaller and somewhat correlated with movement
-        plate.rotationRate = (uniform01(rng)*2.0f-1.0f) * 0.0006f * glm::length(plate.movement) * 50.0f;
+        plate.rotationRate = rng.Uniform(-1.0f, 1.0f) * 0.0006f * glm::length(plate.movement) * 50.0f;
         
         plates.push_back(plate);
         
@@ -146,10 +156,7 @@ void AssignTilesToPlates(World* world, std::vector<Plate>& plates, int targetTot
         progressTracker->UpdateProgress(0.0f, "Assigning tiles to plates...");
     }
     
-    std::mt19937_64 rng(seed);
-    std::uniform_real_distribution<float> uniform01(0.0f, 1.0f);
-    
-    const auto& tiles = world->GetTiles();
+    auto& tiles = world->GetTiles();
     std::cout << "Assigning " << tiles.size() << " tiles to " << plates.size() << " plates..." << std::endl;
     
     // Clear existing assignments
@@ -161,42 +168,54 @@ void AssignTilesToPlates(World* world, std::vector<Plate>& plates, int targetTot
         progressTracker->UpdateProgress(0.2f, "Computing plate assignments...");
     }
     
-    // Assign all tiles to major plates using distance with noise for natural boundaries
-    std::vector<int> tileToPlate(tiles.size(), -1);
+    // Grow every plate outwards from the tile under its center. Noise is
+    // evaluated once per tile and scales the cost of entering it, so plates
+    // spread unevenly and end up with irregular but contiguous boundaries.
+    TileAdjacency adjacency = TileAdjacency::Build(*world);
     
-    for (size_t tileIdx = 0; tileIdx < tiles.size(); ++tileIdx) {
-        const auto& tile = tiles[tileIdx];
-        glm::vec3 tileCenter = glm::normalize(tile.GetCenter());
-        
-        int closestPlate = -1;
-        float minDistance = std::numeric_limits<float>::max();
-        
-        // Find closest plate with noise for natural boundaries
-        for (size_t plateIdx = 0; plateIdx < plates.size(); ++plateIdx) {
-            float distance = glm::distance(tileCenter, plates[plateIdx].center);
-            
-            // Add noise for natural boundaries
-            float noise = sin(tileCenter.x * 8.0f) * cos(tileCenter.y * 8.0f) * sin(tileCenter.z * 8.0f) * 0.15f;
-            float weightedDistance = distance + noise;
-            
-            if (weightedDistance < minDistance) {
-                minDistance = weightedDistance;
-                closestPlate = static_cast<int>(plateIdx);
-            }
+    std::vector<float> tileCosts(tiles.size());
+    ThreadPool::GetInstance().ParallelFor(tiles.size(), [&](size_t begin, size_t end) {
+        for (size_t tileIdx = begin; tileIdx < end; ++tileIdx) {
+            glm::vec3 tileCenter = glm::normalize(tiles[tileIdx].GetCenter());
+            float noise = sin(tileCenter.x * 8.0f) * cos(tileCenter.y * 8.0f) * sin(tileCenter.z * 8.0f);
+            tileCosts[tileIdx] = 1.0f + noise * 0.6f;
         }
-        
-        if (closestPlate >= 0) {
-            tileToPlate[tileIdx] = closestPlate;
-            plates[closestPlate].tileIds.push_back(static_cast<int>(tileIdx));
-            
-            // Assign plate ID to the tile
-            const_cast<Tile&>(tile).SetPlateId(closestPlate);
+    });
+    
+    std::vector<int> seedTiles(plates.size());
+    int previousSeed = 0;
+    for (size_t plateIdx = 0; plateIdx < plates.size(); ++plateIdx) {
+        seedTiles[plateIdx] = FindNearestTile(*world, adjacency, plates[plateIdx].center, previousSeed);
+        previousSeed = seedTiles[plateIdx];
+    }
+    
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.4f, "Growing plate regions...");
+    }
+    
+    DistanceFieldOptions growthOptions;
+    growthOptions.tileCosts = tileCosts;
+    TileDistanceField regions = ComputeTileDistanceField(*world, adjacency, seedTiles, growthOptions);
+    if (IsGenerationCancelled()) {
+        return;
+    }
+    std::vector<int>& tileToPlate = regions.nearestSource;
+    tileToPlate.resize(tiles.size(), -1);
+    
+    for (size_t tileIdx = 0; tileIdx < tiles.size(); ++tileIdx) {
+        if (tileToPlate[tileIdx] >= 0) {
+            tiles[tileIdx].SetPlateId(tileToPlate[tileIdx]);
         }
-        
-        // Report progress
-        if (progressTracker && tileIdx % 1000 == 0) {
-            float progress = 0.2f + (static_cast<float>(tileIdx) / tiles.size()) * 0.8f;
-            progressTracker->UpdateProgress(progress, "Assigning tiles: " + std::to_string(tileIdx) + "/" + std::to_string(tiles.size()));
+    }
+    
+    if (progressTracker) {
+        progressTracker->UpdateProgress(0.8f, "Building plate tile lists...");
+    }
+    
+    // Build the plate tile lists in tile order
+    for (size_t tileIdx = 0; tileIdx < tiles.size(); ++tileIdx) {
+        if (tileToPlate[tileIdx] >= 0) {
+            plates[tileToPlate[tileIdx]].tileIds.push_back(static_cast<int>(tileIdx));
         }
     }
     
@@ -213,32 +232,34 @@ void AssignTilesToPlates(World* world, std::vector<Plate>& plates, int targetTot
     }
     
     // Apply base elevations with noise for natural terrain
-    for (size_t tileIdx = 0; tileIdx < tiles.size(); ++tileIdx) {
-        const auto& tile = tiles[tileIdx];
-        int plateId = tile.GetPlateId();
-        
-        if (plateId >= 0 && plateId < plates.size()) {
-            const auto& plate = plates[plateId];
-            glm::vec3 tilePos = glm::normalize(tile.GetCenter());
+    ThreadPool::GetInstance().ParallelFor(tiles.size(), [&](size_t begin, size_t end) {
+        for (size_t tileIdx = begin; tileIdx < end; ++tileIdx) {
+            auto& tile = tiles[tileIdx];
+            int plateId = tile.GetPlateId();
             
-            // Base elevation based on plate type (in meters from planet center)
-            // Use planet's physical radius as sea level reference
-            static const float seaLevelMeters = PlanetParameters().physicalRadiusMeters;
-            float baseElevation;
-            if (plate.isOceanic) {
-                // Oceanic plates: 3000m below sea level (typical ocean depth)
-                baseElevation = seaLevelMeters - 3000.0f;
-            } else {
-                // Continental plates: 500m above sea level (typical continental elevation)
-                baseElevation = seaLevelMeters + 500.0f;
+            if (plateId >= 0 && plateId < plates.size()) {
+                const auto& plate = plates[plateId];
+                glm::vec3 tilePos = glm::normalize(tile.GetCenter());
+                
+                // Base elevation based on plate type (in meters from planet center)
+                // Use planet's physical radius as sea level reference
+                static const float seaLevelMeters = PlanetParameters().physicalRadiusMeters;
+                float baseElevation;
+                if (plate.isOceanic) {
+                    // Oceanic plates: 3000m below sea level (typical ocean depth)
+                    baseElevation = seaLevelMeters - 3000.0f;
+                } else {
+                    // Continental plates: 500m above sea level (typical continental elevation)
+                    baseElevation = seaLevelMeters + 500.0f;
+                }
+                
+                // No clamping needed for physical meter values
+                
+                // Set the elevation
+                tile.SetElevation(baseElevation);
             }
-            
-            // No clamping needed for physical meter values
-            
-            // Set the elevation
-            const_cast<Tile&>(tile).SetElevation(baseElevation);
         }
-    }
+    });
     
     if (progressTracker) {
         progressTracker->UpdateProgress(1.0f, "Tile assignment complete!");
@@ -251,63 +272,52 @@ void SmoothPlateBoundaries(World* world, const std::vector<Plate>& plates,
                           std::shared_ptr<ProgressTracker> progressTracker) {
     if (!world) return;
     
-    const auto& tiles = world->GetTiles();
+    auto& tiles = world->GetTiles();
     if (tiles.empty()) return;
     
     std::cout << "Smoothing oceanic-continental plate boundaries..." << std::endl;
     
-    const float smoothingDistance = 0.05f; // Distance for smoothing effect
+    auto isOceanicTile = [&](int tileIdx) -> int {
+        int plateId = tiles[tileIdx].GetPlateId();
+        if (plateId < 0 || plateId >= static_cast<int>(plates.size())) return -1;
+        return plates[plateId].isOceanic ? 1 : 0;
+    };
+    
+    // Only edges that cross an oceanic-continental boundary contribute, and
+    // only tiles with at least one such edge are smoothed
+    TileAdjacency adjacency = TileAdjacency::Build(*world);
+    std::vector<float> edgeWeights(adjacency.neighbors.size(), 0.0f);
+    std::vector<uint8_t> boundaryMask(tiles.size(), 0);
+    std::vector<float> elevations(tiles.size());
     
-    // Find tiles near oceanic-continental boundaries and smooth them
     for (size_t i = 0; i < tiles.size(); ++i) {
-        const auto& tile = tiles[i];
-        int plateId = tile.GetPlateId();
+        elevations[i] = tiles[i].GetElevation();
+        int type = isOceanicTile(static_cast<int>(i));
+        if (type < 0) continue;
         
-        if (plateId >= 0 && plateId < plates.size()) {
-            const auto& plate = plates[plateId];
-            float currentElevation = tile.GetElevation();
-            
-            // Look for adjacent tiles with different plate types
-            std::vector<float> neighborElevations;
-            bool hasOceanicNeighbor = false;
-            bool hasContinentalNeighbor = false;
-            
-            for (int neighborIdx : tile.GetNeighbors()) {
-                if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
-                    const auto& neighborTile = tiles[neighborIdx];
-                    int neighborPlateId = neighborTile.GetPlateId();
-                    
-                    if (neighborPlateId >= 0 && neighborPlateId < plates.size()) {
-                        const auto& neighborPlate = plates[neighborPlateId];
-                        
-                        // Track different plate types
-                        if (neighborPlate.isOceanic != plate.isOceanic) {
-                            neighborElevations.push_back(neighborTile.GetElevation());
-                            
-                            if (neighborPlate.isOceanic) hasOceanicNeighbor = true;
-                            else hasContinentalNeighbor = true;
-                        }
-                    }
-                }
-            }
-            
-            // Apply smoothing if this tile is at an oceanic-continental boundary
-            if (!neighborElevations.empty() && hasOceanicNeighbor && hasContinentalNeighbor) {
-                // Calculate average of neighbor elevations from different plate types
-                float avgNeighborElevation = 0.0f;
-                for (float elev : neighborElevations) {
-                    avgNeighborElevation += elev;
-                }
-                avgNeighborElevation /= neighborElevations.size();
-                
-                // Blend current elevation with neighbor average (gentle smoothing)
-                float smoothedElevation = currentElevation * 0.7f + avgNeighborElevation * 0.3f;
-                
-                const_cast<Tile&>(tile).SetElevation(smoothedElevation);
+        for (uint32_t e = adjacency.offsets[i]; e < adjacency.offsets[i + 1]; ++e) {
+            int neighborType = isOceanicTile(adjacency.neighbors[e]);
+            if (neighborType >= 0 && neighborType != type) {
+                edgeWeights[e] = 1.0f;
+                boundaryMask[i] = 1;
             }
         }
     }
     
+    // Blend 30% of the way towards the average elevation across the boundary (gentle smoothing)
+    SmoothingOptions options;
+    options.selfWeight = 0.0f;
+    options.blend = 0.3f;
+    options.mask = boundaryMask;
+    options.edgeWeights = edgeWeights;
+    SmoothTileValues(adjacency, elevations, options);
+    
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (boundaryMask[i]) {
+            tiles[i].SetElevation(elevations[i]);
+        }
+    }
+    
     std::cout << "Plate boundary smoothing complete." << std::endl;
 }
 
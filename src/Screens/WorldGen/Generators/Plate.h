@@ -50,10 +50,12 @@ std::vector<Plate> GeneratePlates(World* world, int numPlates, uint64_t seed,
                                  std::shared_ptr<ProgressTracker> progressTracker = nullptr);
 
 /**
- * @brief Assign tiles to plates using Voronoi-like regions with noise
+ * @brief Assign tiles to plates by growing regions from the plate centers
  * 
- * Assigns all world tiles to the closest major plate using distance-based
- * assignment with noise for natural, irregular boundaries.
+ * Each plate grows outwards over the tile adjacency graph from the tile under
+ * its center (see ComputeTileDistanceField). Per-tile noise makes some tiles
+ * more expensive to cross, giving natural, irregular boundaries while keeping
+ * every plate contiguous. Runs in O(tiles log tiles) for any number of plates.
  * 
  * @param world The world containing tiles
  * @param plates The plates to assign tiles to (modified in-place)
@@ -0,0 +1,291 @@
+#include "SpeculativeWorldPool.h"
+#include "Generator.h"
+#include "PhaseCache.h"
+#include "Plate.h"
+#include "WorldSnapshot.h"
+#include "../ProgressTracker.h"
+#include "../Core/ThreadPriority.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+constexpr size_t kBytesPerMB = 1024 * 1024;
+
+// Memory a finished world holds besides its tiles: the hydrology columns and
+// the plates' tile lists
+constexpr size_t kResidentBytesPerTile = 24;
+
+/**
+ * @brief Estimated peak memory of a build
+ */
+size_t EstimateBuildPeakBytes(const PlanetParameters& params) {
+    return Generator::EstimatePeakMemoryBytes(Generator::GetSubdivisionLevel(params.resolution));
+}
+
+/**
+ * @brief Whether Generator accepts the parameters' resolution under their memory target
+ */
+bool FitsMemoryTarget(const PlanetParameters& params) {
+    return Generator::GetSubdivisionLevel(params.resolution) <= Generator::GetMaxSubdivisionLevel(params.peakMemoryTargetMB);
+}
+
+void RemoveSnapshot(const std::string& path) {
+    if (!path.empty()) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+}
+
+} // namespace
+
+SpeculativeWorldPool::SpeculativeWorldPool(const SpeculativeWorldPoolSettings& settings, const PlanetParameters& params)
+    : settings(settings), workers(settings.threadCount > 0 ? settings.threadCount - 1 : 0, true), params(params),
+      seedGenerator(std::random_device{}()) {
+    FillSeeds();
+    builder = std::thread(&SpeculativeWorldPool::BuilderLoop, this);
+}
+
+SpeculativeWorldPool::~SpeculativeWorldPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        buildCancellation.Cancel();
+    }
+    wake.notify_all();
+    if (builder.joinable()) {
+        builder.join();
+    }
+    DiscardEntries();
+}
+
+void SpeculativeWorldPool::SetParameters(const PlanetParameters& params) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (params == this->params) {
+            return;
+        }
+        this->params = params;
+        parameterVersion++;
+        buildFailed = false;
+        buildCancellation.Cancel();
+        DiscardEntries();
+        FillSeeds();
+    }
+    wake.notify_all();
+}
+
+void SpeculativeWorldPool::SetPaused(bool paused) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->paused = paused;
+    }
+    wake.notify_all();
+}
+
+SpeculativeWorldPool::Candidate SpeculativeWorldPool::TakeNext() {
+    std::unique_lock<std::mutex> lock(mutex);
+    Candidate candidate;
+    if (entries.empty()) {
+        candidate.seed = std::uniform_int_distribution<uint64_t>(1, 999999)(seedGenerator);
+        return candidate;
+    }
+    candidate.seed = entries.front().seed;
+    candidate.world = TakeEntry(entries.begin(), lock);
+    return candidate;
+}
+
+std::unique_ptr<World> SpeculativeWorldPool::Take(uint64_t seed) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto entry = std::find_if(entries.begin(), entries.end(), [seed](const Entry& e) { return e.seed == seed; });
+    if (entry == entries.end()) {
+        return nullptr;
+    }
+    return TakeEntry(entry, lock);
+}
+
+size_t SpeculativeWorldPool::GetReadyCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::count_if(entries.begin(), entries.end(), [](const Entry& entry) { return entry.IsReady(); });
+}
+
+std::unique_ptr<World> SpeculativeWorldPool::TakeEntry(std::deque<Entry>::iterator entry,
+                                                       std::unique_lock<std::mutex>& lock) {
+    if (building && buildingSeed == entry->seed) {
+        buildCancellation.Cancel(); // The caller generates this seed in the foreground instead
+    }
+    Entry taken = std::move(*entry);
+    entries.erase(entry);
+    FillSeeds();
+    lock.unlock();
+    wake.notify_all();
+
+    if (taken.world) {
+        std::cout << "Speculative world pool: seed " << taken.seed << " was ready in memory" << std::endl;
+        return std::move(taken.world);
+    }
+    if (taken.snapshotPath.empty()) {
+        return nullptr;
+    }
+
+    // Mapping and copying a snapshot is far cheaper than regenerating the world.
+    // Every build runs the hydrology phase, so a snapshot without it is not
+    // a complete world and the caller regenerates the seed instead.
+    std::unique_ptr<World> world;
+    auto snapshot = MappedWorldSnapshot::Open(taken.snapshotPath);
+    if (snapshot && snapshot->HasHydrology()) {
+        world = CreateWorldFromSnapshot(*snapshot);
+        std::cout << "Speculative world pool: seed " << taken.seed << " restored from " << taken.snapshotPath
+                  << std::endl;
+    } else {
+        std::cerr << "WARNING: Could not restore pooled world from " << taken.snapshotPath << std::endl;
+    }
+    snapshot.reset();
+    RemoveSnapshot(taken.snapshotPath);
+    return world;
+}
+
+void SpeculativeWorldPool::BuilderLoop() {
+    Core::lowerCurrentThreadPriority();
+
+    // Phases and parallel loops of every build run on the private pool, so
+    // they never wait in the foreground's queues or hold up its work
+    ThreadPoolScope poolScope(&workers);
+
+    // Builds for seeds nobody has asked for must not evict the foreground's cached phases
+    PhaseCacheBypass cacheBypass;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        auto next = std::find_if(entries.begin(), entries.end(), [](const Entry& entry) { return !entry.IsReady(); });
+        const size_t memoryLimit = settings.memoryLimitMB * kBytesPerMB;
+        const size_t buildPeak = EstimateBuildPeakBytes(params);
+        // Parameters CreateWorld would refuse are never built here; generating
+        // them in the foreground reports the error to the player
+        if (paused || buildFailed || next == entries.end() || !FitsMemoryTarget(params) ||
+            GetResidentBytes() + buildPeak > memoryLimit) {
+            wake.wait(lock);
+            continue;
+        }
+
+        const uint64_t seed = next->seed;
+        const uint64_t version = parameterVersion;
+        const PlanetParameters buildParams = params;
+        building = true;
+        buildingSeed = seed;
+        buildCancellation.Reset();
+        lock.unlock();
+
+        // A build that throws (out of memory, a failed snapshot write) must not
+        // take the process down from a thread the player never asked for
+        std::unique_ptr<World> world;
+        size_t worldBytes = 0;
+        std::string snapshotPath;
+        bool failed = false;
+        try {
+            // Nothing displays this progress; the phases just need a tracker to report to
+            auto progressTracker = std::make_shared<ProgressTracker>();
+            world = Generator::CreateWorld(buildParams, seed, progressTracker, &buildCancellation);
+            worldBytes = world ? EstimateResidentBytes(*world) : 0;
+
+            // Keep the world in memory if the next build still fits beside it,
+            // otherwise write it out while it is still private to this thread
+            if (world && !buildCancellation.IsCancelled() && !settings.snapshotDirectory.empty()) {
+                bool keepInMemory;
+                {
+                    std::lock_guard<std::mutex> sizeLock(mutex);
+                    keepInMemory = GetResidentBytes() + worldBytes + buildPeak <= memoryLimit;
+                }
+                if (!keepInMemory) {
+                    std::error_code error;
+                    std::filesystem::create_directories(settings.snapshotDirectory, error);
+                    snapshotPath = GetSnapshotPath(seed);
+                    if (error || !SaveWorldSnapshot(*world, buildParams, snapshotPath)) {
+                        std::cerr << "WARNING: Could not write pooled world snapshot " << snapshotPath << std::endl;
+                        RemoveSnapshot(snapshotPath);
+                        snapshotPath.clear();
+                    } else {
+                        world.reset();
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "WARNING: Speculative world build for seed " << seed << " failed: " << e.what() << std::endl;
+            failed = true;
+        } catch (...) {
+            std::cerr << "WARNING: Speculative world build for seed " << seed << " failed" << std::endl;
+            failed = true;
+        }
+        if (failed) {
+            world.reset();
+            RemoveSnapshot(snapshotPath);
+            snapshotPath.clear();
+        }
+
+        lock.lock();
+        building = false;
+        auto entry = std::find_if(entries.begin(), entries.end(), [seed](const Entry& e) { return e.seed == seed; });
+        if (failed) {
+            // Drop the seed and stop building until the parameters change, since
+            // the next seed would most likely fail the same way
+            if (entry != entries.end()) {
+                entries.erase(entry);
+            }
+            buildFailed = version == parameterVersion;
+            continue;
+        }
+        const bool wanted = (world || !snapshotPath.empty()) && !buildCancellation.IsCancelled() &&
+                            version == parameterVersion && entry != entries.end();
+        if (!wanted) {
+            // Cancelled, taken meanwhile or built for old parameters
+            RemoveSnapshot(snapshotPath);
+            continue;
+        }
+        entry->world = std::move(world);
+        entry->residentBytes = entry->world ? worldBytes : 0;
+        entry->snapshotPath = std::move(snapshotPath);
+        std::cout << "Speculative world pool: seed " << seed << " ready ("
+                  << (entry->world ? "in memory" : "snapshot") << ")" << std::endl;
+    }
+}
+
+void SpeculativeWorldPool::FillSeeds() {
+    // Same range as the seeds the UI draws
+    std::uniform_int_distribution<uint64_t> distribution(1, 999999);
+    while (entries.size() < settings.worldCount) {
+        Entry entry;
+        entry.seed = distribution(seedGenerator);
+        entries.push_back(std::move(entry));
+    }
+}
+
+void SpeculativeWorldPool::DiscardEntries() {
+    for (auto& entry : entries) {
+        RemoveSnapshot(entry.snapshotPath);
+    }
+    entries.clear();
+}
+
+size_t SpeculativeWorldPool::GetResidentBytes() const {
+    size_t total = 0;
+    for (const auto& entry : entries) {
+        total += entry.residentBytes;
+    }
+    return total;
+}
+
+std::string SpeculativeWorldPool::GetSnapshotPath(uint64_t seed) const {
+    std::string name = "pooled_world_" + std::to_string(seed) + ".world";
+    return (std::filesystem::path(settings.snapshotDirectory) / name).string();
+}
+
+size_t SpeculativeWorldPool::EstimateResidentBytes(const World& world) {
+    return world.GetTileCount() * (sizeof(Tile) + kResidentBytesPerTile);
+}
+
+} // namespace Generators
+} // namespace WorldGen
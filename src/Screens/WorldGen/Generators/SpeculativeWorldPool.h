@@ -0,0 +1,153 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include "TaskGraph.h"
+#include "World.h"
+#include "../Core/WorldGenParameters.h"
+
+namespace WorldGen {
+namespace Generators {
+
+/**
+ * @brief Settings for SpeculativeWorldPool
+ */
+struct SpeculativeWorldPoolSettings {
+    size_t worldCount = 2;         ///< Upcoming seeds to keep a world ready for
+    size_t memoryLimitMB = 1024;   ///< Cap on the pooled worlds plus the estimated peak of the build in flight
+    size_t threadCount = 1;        ///< Threads building worlds, all at the lowest scheduling priority
+    std::string snapshotDirectory; ///< Worlds that do not fit the cap are kept here as snapshots (empty: building stops at the cap)
+};
+
+/**
+ * @brief Worlds generated ahead of time for the next few random seeds
+ *
+ * The pool draws the seeds a reroll will use from its own generator and
+ * builds their worlds one at a time on a private low-priority ThreadPool, so
+ * speculative work only runs on cores the foreground leaves idle and never
+ * queues ahead of it. Builds bypass the PhaseCache, so they leave the
+ * foreground's cached phases alone. A reroll takes the next seed and, if its world is done,
+ * the world itself; a build still in flight for that seed is cancelled and
+ * the caller generates it in the foreground as usual.
+ *
+ * Ready worlds stay in memory while they fit memoryLimitMB; the rest are
+ * written as compact snapshots (WorldSnapshot.h) when a snapshot directory is
+ * set. A snapshot holds everything a build produces, hydrology included, so
+ * a restored world is the same as one kept in memory. Worlds built for other
+ * parameters are thrown away.
+ */
+class SpeculativeWorldPool {
+public:
+    /**
+     * @brief A seed taken from the pool, with its world if it was ready
+     */
+    struct Candidate {
+        uint64_t seed = 0;
+        std::unique_ptr<World> world; ///< nullptr if the world still has to be generated
+    };
+
+    /**
+     * @brief Create the pool and start building for the given parameters
+     *
+     * @param settings Pool size, memory cap and snapshot directory
+     * @param params Parameters to build worlds with
+     */
+    SpeculativeWorldPool(const SpeculativeWorldPoolSettings& settings, const PlanetParameters& params);
+
+    /**
+     * @brief Cancel the build in flight, join the builder and delete the pool's snapshots
+     */
+    ~SpeculativeWorldPool();
+
+    SpeculativeWorldPool(const SpeculativeWorldPool&) = delete;
+    SpeculativeWorldPool& operator=(const SpeculativeWorldPool&) = delete;
+
+    /**
+     * @brief Build worlds for these parameters from now on
+     *
+     * Discards every pooled world if the parameters differ from the current
+     * ones, and resumes building if a build for the old ones had failed.
+     *
+     * @param params The parameters the next worlds should be generated with
+     */
+    void SetParameters(const PlanetParameters& params);
+
+    /**
+     * @brief Hold off starting new builds (while the foreground is generating)
+     *
+     * A build already in flight finishes at low priority.
+     *
+     * @param paused Whether to pause
+     */
+    void SetPaused(bool paused);
+
+    /**
+     * @brief Take the next upcoming seed for a reroll
+     *
+     * @return Candidate The seed, with its world if it has been built
+     */
+    Candidate TakeNext();
+
+    /**
+     * @brief Take the world for a specific seed, if the pool has it ready
+     *
+     * The seed is dropped from the pool either way, since the caller is about
+     * to generate it.
+     *
+     * @param seed The seed the player chose
+     * @return std::unique_ptr<World> The ready world, or nullptr
+     */
+    std::unique_ptr<World> Take(uint64_t seed);
+
+    /**
+     * @brief Get the number of worlds ready to be taken
+     *
+     * @return size_t Worlds in memory or in snapshots
+     */
+    size_t GetReadyCount() const;
+
+private:
+    struct Entry {
+        uint64_t seed = 0;
+        std::unique_ptr<World> world; ///< Ready in memory
+        std::string snapshotPath;     ///< Ready on disk
+        size_t residentBytes = 0;     ///< Estimated memory held by world
+
+        bool IsReady() const { return world || !snapshotPath.empty(); }
+    };
+
+    void BuilderLoop();
+    void FillSeeds();
+    void DiscardEntries();
+    std::unique_ptr<World> TakeEntry(std::deque<Entry>::iterator entry, std::unique_lock<std::mutex>& lock);
+    size_t GetResidentBytes() const;
+    std::string GetSnapshotPath(uint64_t seed) const;
+
+    static size_t EstimateResidentBytes(const World& world);
+
+    const SpeculativeWorldPoolSettings settings;
+    CancellationToken buildCancellation; ///< Declared before workers: tasks they drain on destruction still refer to it
+    ThreadPool workers; ///< Low-priority helpers for the builder's parallel loops
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    PlanetParameters params;
+    uint64_t parameterVersion = 0;  ///< Bumped whenever params changes, to spot stale builds
+    std::deque<Entry> entries;      ///< Upcoming seeds in the order rerolls take them
+    std::mt19937_64 seedGenerator;
+    bool paused = false;
+    bool stopping = false;
+    bool buildFailed = false;       ///< A build threw; nothing more is built until the parameters change
+    bool building = false;
+    uint64_t buildingSeed = 0;
+    std::thread builder;
+};
+
+} // namespace Generators
+} // namespace WorldGen
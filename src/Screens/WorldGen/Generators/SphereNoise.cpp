@@ -0,0 +1,159 @@
+#include "SphereNoise.h"
+#include "SphereNoiseKernel.h"
+#include <bit>
+#include <cmath>
+#include <iostream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "FillNoise reads points as interleaved xyz floats");
+
+/**
+ * @brief One point at a time, for SampleNoise and CPUs without SIMD backends
+ */
+struct ScalarOps {
+    using F = float;
+    using U = uint32_t;
+    using M = bool;
+    static constexpr size_t kLanes = 1;
+
+    static void Load(const float* xyz, F& x, F& y, F& z) { x = xyz[0]; y = xyz[1]; z = xyz[2]; }
+    static void Store(float* out, F value) { *out = value; }
+
+    static F Set(float value) { return value; }
+    static U SetU(uint32_t value) { return value; }
+
+    static F Add(F a, F b) { return a + b; }
+    static F Sub(F a, F b) { return a - b; }
+    static F Mul(F a, F b) { return a * b; }
+    static F Max(F a, F b) { return a > b ? a : b; } // Same operand order as maxps
+    static F Floor(F a) { return std::floor(a); }
+    static F Abs(F a) { return std::bit_cast<float>(std::bit_cast<uint32_t>(a) & 0x7fffffffu); }
+    static F Select(M mask, F a, F b) { return mask ? a : b; }
+    static F FlipSign(F a, U bit) { return std::bit_cast<float>(std::bit_cast<uint32_t>(a) ^ (bit << 31)); }
+
+    static U AddU(U a, U b) { return a + b; }
+    static U MulU(U a, uint32_t b) { return a * b; }
+    static U Xor(U a, U b) { return a ^ b; }
+    static U AndU(U a, uint32_t b) { return a & b; }
+    static U ShiftRight(U a, int bits) { return a >> bits; }
+
+    static U ToInt(F a) { return static_cast<uint32_t>(static_cast<int32_t>(a)); }
+    static F ToFloat(U a) { return static_cast<float>(static_cast<int32_t>(a)); }
+
+    static M GreaterEqual(F a, F b) { return a >= b; }
+    static M LessU(U a, uint32_t b) { return a < b; }
+    static M EqualU(U a, uint32_t b) { return a == b; }
+    static M And(M a, M b) { return a && b; }
+    static M Or(M a, M b) { return a || b; }
+    static M Not(M a) { return !a; }
+    static F One(M mask) { return mask ? 1.0f : 0.0f; }
+    static U OneU(M mask) { return mask ? 1u : 0u; }
+};
+
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false;
+};
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+// AVX2 also needs the OS to save the AVX registers, which MSVC has to check itself
+CpuFeatures DetectCpuFeatures() {
+    CpuFeatures features;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    features.sse41 = (info[2] & (1 << 19)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        features.avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    features.sse41 = __builtin_cpu_supports("sse4.1");
+    features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+    return features;
+}
+
+#else
+
+CpuFeatures DetectCpuFeatures() {
+    return {};
+}
+
+#endif
+
+const CpuFeatures& GetCpuFeatures() {
+    static const CpuFeatures features = DetectCpuFeatures();
+    return features;
+}
+
+} // namespace
+
+bool IsNoiseBackendSupported(NoiseBackend backend) {
+    switch (backend) {
+        case NoiseBackend::Scalar: return true;
+        case NoiseBackend::SSE41: return NoiseKernel::kSSE41Compiled && GetCpuFeatures().sse41;
+        case NoiseBackend::AVX2: return NoiseKernel::kAVX2Compiled && GetCpuFeatures().avx2;
+        default: return false;
+    }
+}
+
+NoiseBackend GetBestNoiseBackend() {
+    static const NoiseBackend best = IsNoiseBackendSupported(NoiseBackend::AVX2) ? NoiseBackend::AVX2
+                                   : IsNoiseBackendSupported(NoiseBackend::SSE41) ? NoiseBackend::SSE41
+                                   : NoiseBackend::Scalar;
+    return best;
+}
+
+float SampleNoise(const glm::vec3& point, const NoiseSettings& settings) {
+    return NoiseKernel::Sample<ScalarOps>(point.x, point.y, point.z, settings);
+}
+
+void FillNoise(std::span<const glm::vec3> points, const NoiseSettings& settings, std::span<float> values) {
+    FillNoise(points, settings, values, GetBestNoiseBackend());
+}
+
+void FillNoise(std::span<const glm::vec3> points, const NoiseSettings& settings, std::span<float> values,
+               NoiseBackend backend) {
+    if (points.size() != values.size()) {
+        std::cerr << "ERROR: Noise column has " << values.size() << " values for " << points.size() << " points" << std::endl;
+        return;
+    }
+    if (points.empty()) {
+        return;
+    }
+
+    const float* xyz = &points[0].x;
+    if (!IsNoiseBackendSupported(backend)) {
+        backend = NoiseBackend::Scalar;
+    }
+
+    switch (backend) {
+        case NoiseBackend::AVX2:
+            NoiseKernel::FillAVX2(xyz, points.size(), settings, values.data());
+            break;
+        case NoiseBackend::SSE41:
+            NoiseKernel::FillSSE41(xyz, points.size(), settings, values.data());
+            break;
+        default:
+            NoiseKernel::Fill<ScalarOps>(xyz, points.size(), settings, values.data());
+            break;
+    }
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <glm/glm.hpp>
+
+namespace WorldGen {
+namespace Generators {
+
+/**
+ * @brief Lattice noise evaluated at each octave
+ */
+enum class NoiseBasis {
+    Simplex, // 3D simplex noise with hashed gradients, roughly -1 to 1
+    Value    // 3D value noise with quintic interpolation, -1 to 1
+};
+
+/**
+ * @brief How octaves are combined
+ */
+enum class NoiseFractal {
+    None,  // A single octave
+    FBm,   // Fractional Brownian motion: amplitude-weighted sum, -1 to 1
+    Ridged // Sum of squared inverted absolute octaves, 0 to 1, with sharp crests
+};
+
+/**
+ * @brief Instruction set a batch of noise is evaluated with
+ */
+enum class NoiseBackend {
+    Scalar, // One point at a time, available everywhere
+    SSE41,  // Four points at a time
+    AVX2    // Eight points at a time
+};
+
+/**
+ * @brief Parameters of a noise field on the sphere
+ */
+struct NoiseSettings {
+    NoiseBasis basis = NoiseBasis::Simplex;
+    NoiseFractal fractal = NoiseFractal::FBm;
+    int octaves = 4;            // Number of octaves (ignored for NoiseFractal::None)
+    float frequency = 1.0f;     // Frequency of the first octave, in cycles per unit-sphere radius
+    float lacunarity = 2.0f;    // Frequency multiplier between octaves
+    float persistence = 0.5f;   // Amplitude multiplier between octaves
+    uint32_t seed = 0;          // Each octave hashes its lattice with a seed derived from this
+};
+
+/**
+ * @brief Evaluate noise at a single point
+ *
+ * Uses the scalar backend. Every backend evaluates the same operations in the
+ * same order, so a point gives the same value here as in a FillNoise batch.
+ *
+ * @param point Point to sample, normally on the unit sphere
+ * @param settings Noise parameters
+ * @return float The noise value
+ */
+float SampleNoise(const glm::vec3& point, const NoiseSettings& settings);
+
+/**
+ * @brief Evaluate noise for a whole attribute column
+ *
+ * Fills one value per point with the widest instruction set the CPU
+ * supports. Points are read straight from their interleaved xyz layout, so
+ * callers can pass a column of tile centers without repacking it.
+ *
+ * @param points Points to sample, normally on the unit sphere
+ * @param settings Noise parameters
+ * @param values Output value per point, the same size as points
+ */
+void FillNoise(std::span<const glm::vec3> points, const NoiseSettings& settings, std::span<float> values);
+
+/**
+ * @brief Evaluate noise for a column with a specific backend
+ *
+ * For benchmarks and tests; falls back to the scalar backend if the
+ * requested one is not supported.
+ *
+ * @param points Points to sample, normally on the unit sphere
+ * @param settings Noise parameters
+ * @param values Output value per point, the same size as points
+ * @param backend Instruction set to use
+ */
+void FillNoise(std::span<const glm::vec3> points, const NoiseSettings& settings, std::span<float> values,
+               NoiseBackend backend);
+
+/**
+ * @brief Check whether a backend was compiled in and the CPU can run it
+ *
+ * @param backend The backend
+ * @return true if FillNoise can use it
+ */
+bool IsNoiseBackendSupported(NoiseBackend backend);
+
+/**
+ * @brief Get the widest supported backend
+ *
+ * @return NoiseBackend The backend FillNoise uses by default
+ */
+NoiseBackend GetBestNoiseBackend();
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,82 @@
+// Compiled with AVX2 enabled (see CMakeLists.txt); keep standard library
+// code out of this file so none of it is emitted with AVX2 instructions.
+// FMA stays off: fused multiply-adds would round differently from the other
+// backends.
+#include "SphereNoiseKernel.h"
+
+#if defined(__AVX2__) || (defined(_MSC_VER) && defined(_M_X64))
+#define WORLDGEN_NOISE_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace WorldGen {
+namespace Generators {
+namespace NoiseKernel {
+
+#if defined(WORLDGEN_NOISE_AVX2)
+
+namespace {
+
+struct AVX2Ops {
+    using F = __m256;
+    using U = __m256i;
+    using M = __m256;
+    static constexpr size_t kLanes = 8;
+
+    static void Load(const float* xyz, F& x, F& y, F& z) {
+        x = _mm256_setr_ps(xyz[0], xyz[3], xyz[6], xyz[9], xyz[12], xyz[15], xyz[18], xyz[21]);
+        y = _mm256_setr_ps(xyz[1], xyz[4], xyz[7], xyz[10], xyz[13], xyz[16], xyz[19], xyz[22]);
+        z = _mm256_setr_ps(xyz[2], xyz[5], xyz[8], xyz[11], xyz[14], xyz[17], xyz[20], xyz[23]);
+    }
+    static void Store(float* out, F value) { _mm256_storeu_ps(out, value); }
+
+    static F Set(float value) { return _mm256_set1_ps(value); }
+    static U SetU(uint32_t value) { return _mm256_set1_epi32(static_cast<int>(value)); }
+
+    static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F Max(F a, F b) { return _mm256_max_ps(a, b); }
+    static F Floor(F a) { return _mm256_floor_ps(a); }
+    static F Abs(F a) { return _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff))); }
+    static F Select(M mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+    static F FlipSign(F a, U bit) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_slli_epi32(bit, 31))); }
+
+    static U AddU(U a, U b) { return _mm256_add_epi32(a, b); }
+    static U MulU(U a, uint32_t b) { return _mm256_mullo_epi32(a, SetU(b)); }
+    static U Xor(U a, U b) { return _mm256_xor_si256(a, b); }
+    static U AndU(U a, uint32_t b) { return _mm256_and_si256(a, SetU(b)); }
+    static U ShiftRight(U a, int bits) { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(bits)); }
+
+    static U ToInt(F a) { return _mm256_cvttps_epi32(a); }
+    static F ToFloat(U a) { return _mm256_cvtepi32_ps(a); }
+
+    static M GreaterEqual(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static M LessU(U a, uint32_t b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(SetU(b), a)); }
+    static M EqualU(U a, uint32_t b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, SetU(b))); }
+    static M And(M a, M b) { return _mm256_and_ps(a, b); }
+    static M Or(M a, M b) { return _mm256_or_ps(a, b); }
+    static M Not(M a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+    static F One(M mask) { return _mm256_and_ps(mask, Set(1.0f)); }
+    static U OneU(M mask) { return _mm256_srli_epi32(_mm256_castps_si256(mask), 31); }
+};
+
+} // namespace
+
+const bool kAVX2Compiled = true;
+
+void FillAVX2(const float* xyz, size_t count, const NoiseSettings& settings, float* values) {
+    Fill<AVX2Ops>(xyz, count, settings, values);
+}
+
+#else
+
+const bool kAVX2Compiled = false;
+
+void FillAVX2(const float*, size_t, const NoiseSettings&, float*) {}
+
+#endif
+
+} // namespace NoiseKernel
+} // namespace Generators
+} // namespace WorldGen
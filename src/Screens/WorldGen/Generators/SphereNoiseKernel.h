@@ -0,0 +1,226 @@
+#pragma once
+
+// Noise kernels shared by the SphereNoise backends. Each backend translation
+// unit supplies an Ops type (in an anonymous namespace, so the instantiations
+// stay local to that unit and its instruction set) with:
+//   F, U, M        float lanes, uint32 lanes and a lane mask
+//   kLanes         points per batch
+//   Load, Store    read kLanes interleaved xyz points, write kLanes floats
+//   Set, SetU      broadcast a constant
+//   Add, Sub, Mul, Max, Floor, Abs, Select            float lane math
+//   AddU, MulU, Xor, AndU, ShiftRight                 uint32 lane math
+//   ToInt, ToFloat                                    conversions
+//   GreaterEqual, LessU, EqualU, And, Or, Not, One, OneU, FlipSign
+// The kernels only combine these, in the same order for every backend, so
+// all backends produce the same values.
+
+#include <cstddef>
+#include <cstdint>
+#include "SphereNoise.h"
+
+namespace WorldGen {
+namespace Generators {
+namespace NoiseKernel {
+
+template <typename Ops>
+typename Ops::U Hash(typename Ops::U i, typename Ops::U j, typename Ops::U k, typename Ops::U seed) {
+    typename Ops::U h = Ops::Xor(seed, Ops::MulU(i, 0x8da6b343u));
+    h = Ops::Xor(h, Ops::MulU(j, 0xd8163841u));
+    h = Ops::Xor(h, Ops::MulU(k, 0xcb1ab31fu));
+    h = Ops::Xor(h, Ops::ShiftRight(h, 15));
+    h = Ops::MulU(h, 0x2c1b3c6du);
+    h = Ops::Xor(h, Ops::ShiftRight(h, 12));
+    h = Ops::MulU(h, 0x297a2d39u);
+    h = Ops::Xor(h, Ops::ShiftRight(h, 15));
+    return h;
+}
+
+// Dot product with one of the 12 cube-edge gradients (Perlin's selection)
+template <typename Ops>
+typename Ops::F Gradient(typename Ops::U hash, typename Ops::F x, typename Ops::F y, typename Ops::F z) {
+    typename Ops::U h = Ops::AndU(hash, 15u);
+    typename Ops::M useX = Ops::LessU(h, 8u);
+    typename Ops::M useY = Ops::LessU(h, 4u);
+    typename Ops::M useXForV = Ops::Or(Ops::EqualU(h, 12u), Ops::EqualU(h, 14u));
+    typename Ops::F u = Ops::Select(useX, x, y);
+    typename Ops::F v = Ops::Select(useY, y, Ops::Select(useXForV, x, z));
+    u = Ops::FlipSign(u, Ops::AndU(h, 1u));
+    v = Ops::FlipSign(v, Ops::ShiftRight(Ops::AndU(h, 2u), 1));
+    return Ops::Add(u, v);
+}
+
+template <typename Ops>
+typename Ops::F SimplexCorner(typename Ops::F x, typename Ops::F y, typename Ops::F z, typename Ops::U hash) {
+    typename Ops::F t = Ops::Sub(Ops::Set(0.6f), Ops::Add(Ops::Add(Ops::Mul(x, x), Ops::Mul(y, y)), Ops::Mul(z, z)));
+    t = Ops::Max(t, Ops::Set(0.0f));
+    typename Ops::F t2 = Ops::Mul(t, t);
+    return Ops::Mul(Ops::Mul(t2, t2), Gradient<Ops>(hash, x, y, z));
+}
+
+template <typename Ops>
+typename Ops::F Simplex(typename Ops::F x, typename Ops::F y, typename Ops::F z, typename Ops::U seed) {
+    using F = typename Ops::F;
+    using U = typename Ops::U;
+    using M = typename Ops::M;
+    const float skew = 1.0f / 3.0f;
+    const float unskew = 1.0f / 6.0f;
+
+    // Simplex cell containing the point, and the offset from its first corner
+    F s = Ops::Mul(Ops::Add(Ops::Add(x, y), z), Ops::Set(skew));
+    F fi = Ops::Floor(Ops::Add(x, s));
+    F fj = Ops::Floor(Ops::Add(y, s));
+    F fk = Ops::Floor(Ops::Add(z, s));
+    F t = Ops::Mul(Ops::Add(Ops::Add(fi, fj), fk), Ops::Set(unskew));
+    F x0 = Ops::Sub(x, Ops::Sub(fi, t));
+    F y0 = Ops::Sub(y, Ops::Sub(fj, t));
+    F z0 = Ops::Sub(z, Ops::Sub(fk, t));
+
+    // The order of the offsets picks which of the six tetrahedra the point is in
+    M xy = Ops::GreaterEqual(x0, y0);
+    M yz = Ops::GreaterEqual(y0, z0);
+    M xz = Ops::GreaterEqual(x0, z0);
+    M i1 = Ops::And(xy, xz);
+    M j1 = Ops::And(Ops::Not(xy), yz);
+    M k1 = Ops::Not(Ops::Or(xz, yz));
+    M i2 = Ops::Or(xy, xz);
+    M j2 = Ops::Or(Ops::Not(xy), yz);
+    M k2 = Ops::Not(Ops::And(xz, yz));
+
+    F x1 = Ops::Add(Ops::Sub(x0, Ops::One(i1)), Ops::Set(unskew));
+    F y1 = Ops::Add(Ops::Sub(y0, Ops::One(j1)), Ops::Set(unskew));
+    F z1 = Ops::Add(Ops::Sub(z0, Ops::One(k1)), Ops::Set(unskew));
+    F x2 = Ops::Add(Ops::Sub(x0, Ops::One(i2)), Ops::Set(2.0f * unskew));
+    F y2 = Ops::Add(Ops::Sub(y0, Ops::One(j2)), Ops::Set(2.0f * unskew));
+    F z2 = Ops::Add(Ops::Sub(z0, Ops::One(k2)), Ops::Set(2.0f * unskew));
+    F x3 = Ops::Add(Ops::Sub(x0, Ops::Set(1.0f)), Ops::Set(3.0f * unskew));
+    F y3 = Ops::Add(Ops::Sub(y0, Ops::Set(1.0f)), Ops::Set(3.0f * unskew));
+    F z3 = Ops::Add(Ops::Sub(z0, Ops::Set(1.0f)), Ops::Set(3.0f * unskew));
+
+    U i = Ops::ToInt(fi);
+    U j = Ops::ToInt(fj);
+    U k = Ops::ToInt(fk);
+    U one = Ops::SetU(1u);
+    F n0 = SimplexCorner<Ops>(x0, y0, z0, Hash<Ops>(i, j, k, seed));
+    F n1 = SimplexCorner<Ops>(x1, y1, z1, Hash<Ops>(Ops::AddU(i, Ops::OneU(i1)), Ops::AddU(j, Ops::OneU(j1)),
+                                                    Ops::AddU(k, Ops::OneU(k1)), seed));
+    F n2 = SimplexCorner<Ops>(x2, y2, z2, Hash<Ops>(Ops::AddU(i, Ops::OneU(i2)), Ops::AddU(j, Ops::OneU(j2)),
+                                                    Ops::AddU(k, Ops::OneU(k2)), seed));
+    F n3 = SimplexCorner<Ops>(x3, y3, z3, Hash<Ops>(Ops::AddU(i, one), Ops::AddU(j, one), Ops::AddU(k, one), seed));
+
+    return Ops::Mul(Ops::Set(32.0f), Ops::Add(Ops::Add(n0, n1), Ops::Add(n2, n3)));
+}
+
+template <typename Ops>
+typename Ops::F LatticeValue(typename Ops::U i, typename Ops::U j, typename Ops::U k, typename Ops::U seed) {
+    // Top 24 bits of the hash convert to float exactly
+    typename Ops::F value = Ops::ToFloat(Ops::ShiftRight(Hash<Ops>(i, j, k, seed), 8));
+    return Ops::Sub(Ops::Mul(value, Ops::Set(2.0f / 16777215.0f)), Ops::Set(1.0f));
+}
+
+template <typename Ops>
+typename Ops::F Lerp(typename Ops::F a, typename Ops::F b, typename Ops::F t) {
+    return Ops::Add(a, Ops::Mul(t, Ops::Sub(b, a)));
+}
+
+// 6t^5 - 15t^4 + 10t^3
+template <typename Ops>
+typename Ops::F Fade(typename Ops::F t) {
+    typename Ops::F inner = Ops::Add(Ops::Mul(t, Ops::Sub(Ops::Mul(t, Ops::Set(6.0f)), Ops::Set(15.0f))), Ops::Set(10.0f));
+    return Ops::Mul(Ops::Mul(Ops::Mul(t, t), t), inner);
+}
+
+template <typename Ops>
+typename Ops::F Value(typename Ops::F x, typename Ops::F y, typename Ops::F z, typename Ops::U seed) {
+    using F = typename Ops::F;
+    using U = typename Ops::U;
+
+    F fi = Ops::Floor(x);
+    F fj = Ops::Floor(y);
+    F fk = Ops::Floor(z);
+    F u = Fade<Ops>(Ops::Sub(x, fi));
+    F v = Fade<Ops>(Ops::Sub(y, fj));
+    F w = Fade<Ops>(Ops::Sub(z, fk));
+
+    U i0 = Ops::ToInt(fi);
+    U j0 = Ops::ToInt(fj);
+    U k0 = Ops::ToInt(fk);
+    U one = Ops::SetU(1u);
+    U i1 = Ops::AddU(i0, one);
+    U j1 = Ops::AddU(j0, one);
+    U k1 = Ops::AddU(k0, one);
+
+    F x00 = Lerp<Ops>(LatticeValue<Ops>(i0, j0, k0, seed), LatticeValue<Ops>(i1, j0, k0, seed), u);
+    F x10 = Lerp<Ops>(LatticeValue<Ops>(i0, j1, k0, seed), LatticeValue<Ops>(i1, j1, k0, seed), u);
+    F x01 = Lerp<Ops>(LatticeValue<Ops>(i0, j0, k1, seed), LatticeValue<Ops>(i1, j0, k1, seed), u);
+    F x11 = Lerp<Ops>(LatticeValue<Ops>(i0, j1, k1, seed), LatticeValue<Ops>(i1, j1, k1, seed), u);
+    return Lerp<Ops>(Lerp<Ops>(x00, x10, v), Lerp<Ops>(x01, x11, v), w);
+}
+
+template <typename Ops>
+typename Ops::F Sample(typename Ops::F x, typename Ops::F y, typename Ops::F z, const NoiseSettings& settings) {
+    using F = typename Ops::F;
+
+    const int octaves = settings.fractal == NoiseFractal::None ? 1 : (settings.octaves > 0 ? settings.octaves : 1);
+    F total = Ops::Set(0.0f);
+    float frequency = settings.frequency;
+    float amplitude = 1.0f;
+    float amplitudeSum = 0.0f;
+
+    for (int octave = 0; octave < octaves; ++octave) {
+        F scale = Ops::Set(frequency);
+        F px = Ops::Mul(x, scale);
+        F py = Ops::Mul(y, scale);
+        F pz = Ops::Mul(z, scale);
+        typename Ops::U seed = Ops::SetU(settings.seed + static_cast<uint32_t>(octave) * 0x9e3779b9u);
+
+        F n = settings.basis == NoiseBasis::Simplex ? Simplex<Ops>(px, py, pz, seed) : Value<Ops>(px, py, pz, seed);
+        if (settings.fractal == NoiseFractal::Ridged) {
+            n = Ops::Sub(Ops::Set(1.0f), Ops::Abs(n));
+            n = Ops::Mul(n, n);
+        }
+
+        total = Ops::Add(total, Ops::Mul(n, Ops::Set(amplitude)));
+        amplitudeSum += amplitude;
+        amplitude *= settings.persistence;
+        frequency *= settings.lacunarity;
+    }
+
+    return Ops::Mul(total, Ops::Set(1.0f / amplitudeSum));
+}
+
+// Whole batches straight from the column, then the tail through a padded batch
+template <typename Ops>
+void Fill(const float* xyz, size_t count, const NoiseSettings& settings, float* values) {
+    constexpr size_t lanes = Ops::kLanes;
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        typename Ops::F x, y, z;
+        Ops::Load(xyz + i * 3, x, y, z);
+        Ops::Store(values + i, Sample<Ops>(x, y, z, settings));
+    }
+
+    if (i < count) {
+        float pointTail[lanes * 3] = {};
+        float valueTail[lanes] = {};
+        for (size_t lane = 0; lane < (count - i) * 3; ++lane) {
+            pointTail[lane] = xyz[i * 3 + lane];
+        }
+        typename Ops::F x, y, z;
+        Ops::Load(pointTail, x, y, z);
+        Ops::Store(valueTail, Sample<Ops>(x, y, z, settings));
+        for (size_t lane = 0; lane < count - i; ++lane) {
+            values[i + lane] = valueTail[lane];
+        }
+    }
+}
+
+// Backends compiled in their own translation units; each reports whether it
+// was built with its instruction set enabled
+extern const bool kSSE41Compiled;
+extern const bool kAVX2Compiled;
+void FillSSE41(const float* xyz, size_t count, const NoiseSettings& settings, float* values);
+void FillAVX2(const float* xyz, size_t count, const NoiseSettings& settings, float* values);
+
+} // namespace NoiseKernel
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,80 @@
+// Compiled with SSE4.1 enabled (see CMakeLists.txt); keep standard library
+// code out of this file so none of it is emitted with SSE4.1 instructions
+#include "SphereNoiseKernel.h"
+
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define WORLDGEN_NOISE_SSE41 1
+#include <immintrin.h>
+#endif
+
+namespace WorldGen {
+namespace Generators {
+namespace NoiseKernel {
+
+#if defined(WORLDGEN_NOISE_SSE41)
+
+namespace {
+
+struct SSE41Ops {
+    using F = __m128;
+    using U = __m128i;
+    using M = __m128;
+    static constexpr size_t kLanes = 4;
+
+    static void Load(const float* xyz, F& x, F& y, F& z) {
+        x = _mm_setr_ps(xyz[0], xyz[3], xyz[6], xyz[9]);
+        y = _mm_setr_ps(xyz[1], xyz[4], xyz[7], xyz[10]);
+        z = _mm_setr_ps(xyz[2], xyz[5], xyz[8], xyz[11]);
+    }
+    static void Store(float* out, F value) { _mm_storeu_ps(out, value); }
+
+    static F Set(float value) { return _mm_set1_ps(value); }
+    static U SetU(uint32_t value) { return _mm_set1_epi32(static_cast<int>(value)); }
+
+    static F Add(F a, F b) { return _mm_add_ps(a, b); }
+    static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F Max(F a, F b) { return _mm_max_ps(a, b); }
+    static F Floor(F a) { return _mm_floor_ps(a); }
+    static F Abs(F a) { return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff))); }
+    static F Select(M mask, F a, F b) { return _mm_blendv_ps(b, a, mask); }
+    static F FlipSign(F a, U bit) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_slli_epi32(bit, 31))); }
+
+    static U AddU(U a, U b) { return _mm_add_epi32(a, b); }
+    static U MulU(U a, uint32_t b) { return _mm_mullo_epi32(a, SetU(b)); }
+    static U Xor(U a, U b) { return _mm_xor_si128(a, b); }
+    static U AndU(U a, uint32_t b) { return _mm_and_si128(a, SetU(b)); }
+    static U ShiftRight(U a, int bits) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(bits)); }
+
+    static U ToInt(F a) { return _mm_cvttps_epi32(a); }
+    static F ToFloat(U a) { return _mm_cvtepi32_ps(a); }
+
+    static M GreaterEqual(F a, F b) { return _mm_cmpge_ps(a, b); }
+    static M LessU(U a, uint32_t b) { return _mm_castsi128_ps(_mm_cmplt_epi32(a, SetU(b))); }
+    static M EqualU(U a, uint32_t b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, SetU(b))); }
+    static M And(M a, M b) { return _mm_and_ps(a, b); }
+    static M Or(M a, M b) { return _mm_or_ps(a, b); }
+    static M Not(M a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+    static F One(M mask) { return _mm_and_ps(mask, Set(1.0f)); }
+    static U OneU(M mask) { return _mm_srli_epi32(_mm_castps_si128(mask), 31); }
+};
+
+} // namespace
+
+const bool kSSE41Compiled = true;
+
+void FillSSE41(const float* xyz, size_t count, const NoiseSettings& settings, float* values) {
+    Fill<SSE41Ops>(xyz, count, settings, values);
+}
+
+#else
+
+const bool kSSE41Compiled = false;
+
+void FillSSE41(const float*, size_t, const NoiseSettings&, float*) {}
+
+#endif
+
+} // namespace NoiseKernel
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,420 @@
+#include "TaskGraph.h"
+#include "../Core/CpuTime.h"
+#include "../Core/ThreadPriority.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+thread_local const ThreadPool* tlsPool = nullptr;          // Pool the current thread works for
+thread_local size_t tlsWorkerIndex = 0;                    // Queue index of the current worker
+thread_local std::atomic<uint64_t>* tlsCpuAccount = nullptr; // Phase the current thread is charging
+thread_local uint64_t tlsNestedCpuNs = 0;                  // CPU time of nested charges in the current scope
+thread_local const CancellationToken* tlsCancellation = nullptr; // Token of the run the current thread works for
+thread_local ThreadPool* tlsRoutedPool = nullptr;         // Pool GetInstance returns on the current thread
+
+// Items a serial ParallelFor runs between cancellation checks
+constexpr size_t kCancellationSliceSize = 32768;
+
+/**
+ * @brief Charges the calling thread's CPU time to a phase for the lifetime of the scope
+ *
+ * Scopes nest: time spent in an inner scope (a task run while waiting) is
+ * charged to the inner account only, never to both.
+ */
+class CpuCharge {
+public:
+    explicit CpuCharge(std::atomic<uint64_t>* account)
+        : account(account), savedAccount(tlsCpuAccount), savedNestedNs(tlsNestedCpuNs),
+          startNs(Core::getThreadCpuTimeNanoseconds()) {
+        tlsCpuAccount = account;
+        tlsNestedCpuNs = 0;
+    }
+
+    ~CpuCharge() {
+        uint64_t elapsedNs = Core::getThreadCpuTimeNanoseconds() - startNs;
+        if (account) {
+            account->fetch_add(elapsedNs - std::min(elapsedNs, tlsNestedCpuNs), std::memory_order_relaxed);
+        }
+        tlsCpuAccount = savedAccount;
+        tlsNestedCpuNs = savedNestedNs + elapsedNs;
+    }
+
+    CpuCharge(const CpuCharge&) = delete;
+    CpuCharge& operator=(const CpuCharge&) = delete;
+
+private:
+    std::atomic<uint64_t>* account;
+    std::atomic<uint64_t>* savedAccount;
+    uint64_t savedNestedNs;
+    uint64_t startNs;
+};
+
+/**
+ * @brief First exception thrown by any task of a ParallelFor or TaskGraph run
+ *
+ * Tasks catch their own exceptions and record them here, so nothing unwinds
+ * through a worker (std::terminate) or out of a wait while tasks still refer
+ * to the waiter's stack. The waiter rethrows once every task has exited.
+ */
+class FirstException {
+public:
+    void Capture() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception) {
+            exception = std::current_exception();
+        }
+        failed.store(true, std::memory_order_relaxed);
+    }
+
+    bool HasFailed() const { return failed.load(std::memory_order_relaxed); }
+
+    void RethrowIfFailed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::exception_ptr exception;
+    std::atomic<bool> failed{false};
+};
+
+} // namespace
+
+CancellationScope::CancellationScope(const CancellationToken* token)
+    : savedToken(tlsCancellation) {
+    tlsCancellation = token;
+}
+
+CancellationScope::~CancellationScope() {
+    tlsCancellation = savedToken;
+}
+
+bool IsGenerationCancelled() {
+    return tlsCancellation && tlsCancellation->IsCancelled();
+}
+
+ThreadPoolScope::ThreadPoolScope(ThreadPool* pool)
+    : savedPool(tlsRoutedPool) {
+    tlsRoutedPool = pool;
+}
+
+ThreadPoolScope::~ThreadPoolScope() {
+    tlsRoutedPool = savedPool;
+}
+
+ThreadPool& ThreadPool::GetInstance() {
+    if (tlsRoutedPool) {
+        return *tlsRoutedPool;
+    }
+    static ThreadPool instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return instance;
+}
+
+ThreadPool::ThreadPool(size_t workerCount, bool lowPriority)
+    : lowPriority(lowPriority) {
+    // The extra queue at the end takes tasks submitted from outside the pool
+    for (size_t i = 0; i < workerCount + 1; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task, std::atomic<size_t>* exited) {
+    // Whatever phase the submitter is charging also pays for the task, and
+    // the task can be cancelled along with the submitter's run. Both belong
+    // to the submitter, so exited is only bumped once the task no longer
+    // touches them.
+    std::atomic<uint64_t>* account = tlsCpuAccount;
+    const CancellationToken* cancellation = tlsCancellation;
+    auto charged = [account, cancellation, exited, task = std::move(task)]() {
+        try {
+            CpuCharge charge(account);
+            CancellationScope cancellationScope(cancellation);
+            task();
+        } catch (const std::exception& e) {
+            // Tasks are expected to catch their own; this only keeps the pool alive
+            std::cerr << "ERROR: Unhandled exception in a pool task: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "ERROR: Unhandled exception in a pool task" << std::endl;
+        }
+        if (exited) {
+            exited->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    const size_t queueIndex = (tlsPool == this) ? tlsWorkerIndex : queues.size() - 1;
+    {
+        std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+        queues[queueIndex]->tasks.emplace_back(std::move(charged));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pendingTasks.fetch_add(1);
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::TryPop(size_t preferredQueue, std::function<void()>& task) {
+    // Newest task from our own queue first, for cache locality
+    {
+        auto& own = *queues[preferredQueue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Otherwise steal the oldest task from another queue
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        auto& victim = *queues[(preferredQueue + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::RunPendingTask() {
+    std::function<void()> task;
+    const size_t queueIndex = (tlsPool == this) ? tlsWorkerIndex : queues.size() - 1;
+    if (!TryPop(queueIndex, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::WaitUntil(const std::function<bool()>& done) {
+    while (!done()) {
+        if (RunPendingTask()) {
+            continue;
+        }
+        // Nothing to help with; sleep briefly rather than spin
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(1), [this]() { return pendingTasks.load() > 0; });
+    }
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+    tlsPool = this;
+    tlsWorkerIndex = index;
+    tlsRoutedPool = this;
+    if (lowPriority) {
+        Core::lowerCurrentThreadPriority();
+    }
+
+    while (true) {
+        std::function<void()> task;
+        if (TryPop(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || pendingTasks.load() > 0; });
+        if (stopping && pendingTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t, size_t)>& body,
+                             const std::function<void(float)>& progress, size_t minRangeSize) {
+    if (count == 0) {
+        return;
+    }
+
+    // A few ranges per thread so faster threads can pick up the slack
+    const size_t concurrency = GetConcurrency();
+    const size_t rangeSize = std::max(std::max<size_t>(1, minRangeSize), (count + concurrency * 4 - 1) / (concurrency * 4));
+    const size_t rangeCount = (count + rangeSize - 1) / rangeSize;
+
+    if (rangeCount <= 1 || workers.empty()) {
+        if (!tlsCancellation) {
+            body(0, count);
+        } else {
+            // Still run in slices, so a cancelled run stops part way through
+            const size_t sliceSize = std::max(minRangeSize, kCancellationSliceSize);
+            for (size_t begin = 0; begin < count && !IsGenerationCancelled(); begin += sliceSize) {
+                body(begin, std::min(count, begin + sliceSize));
+            }
+        }
+        if (progress) {
+            progress(1.0f);
+        }
+        return;
+    }
+
+    // Helpers may start after every range is done. They still charge the
+    // caller's phase and run under its cancellation token, so wait until all
+    // of them have exited, not just until the ranges are complete.
+    // Likewise a range that throws is only rethrown once every helper has
+    // exited; ranges not yet started are skipped.
+    std::atomic<size_t> nextRange{0};
+    std::atomic<size_t> completedRanges{0};
+    std::atomic<size_t> exitedHelpers{0};
+    FirstException failure;
+
+    auto runRanges = [&](bool reportProgress) {
+        size_t range;
+        while ((range = nextRange.fetch_add(1)) < rangeCount) {
+            try {
+                if (!IsGenerationCancelled() && !failure.HasFailed()) {
+                    size_t begin = range * rangeSize;
+                    body(begin, std::min(count, begin + rangeSize));
+                }
+                size_t completed = completedRanges.fetch_add(1, std::memory_order_release) + 1;
+                if (reportProgress && progress) {
+                    progress(static_cast<float>(completed) / rangeCount);
+                }
+            } catch (...) {
+                failure.Capture();
+            }
+        }
+    };
+
+    const size_t helperCount = std::min(workers.size(), rangeCount - 1);
+    for (size_t i = 0; i < helperCount; ++i) {
+        Submit([&runRanges]() { runRanges(false); }, &exitedHelpers);
+    }
+    runRanges(true);
+
+    // Unstarted helpers are run (and find nothing left to do) by this thread
+    WaitUntil([&]() { return exitedHelpers.load(std::memory_order_acquire) == helperCount; });
+    failure.RethrowIfFailed();
+    if (progress) {
+        progress(1.0f);
+    }
+}
+
+TaskGraph::PhaseId TaskGraph::AddPhase(const std::string& name, std::function<void()> work,
+                                       const std::vector<PhaseId>& dependencies) {
+    PhaseId id = phases.size();
+    Phase phase;
+    phase.name = name;
+    phase.work = std::move(work);
+    for (PhaseId dependency : dependencies) {
+        if (dependency >= id) {
+            std::cerr << "ERROR: Phase '" << name << "' depends on a phase that was added after it" << std::endl;
+            continue;
+        }
+        phases[dependency].dependents.push_back(id);
+        phase.dependencyCount++;
+    }
+    phases.push_back(std::move(phase));
+    return id;
+}
+
+void TaskGraph::Run(ThreadPool& pool) {
+    const size_t phaseCount = phases.size();
+    timings.assign(phaseCount, PhaseTiming{});
+    for (size_t i = 0; i < phaseCount; ++i) {
+        timings[i].name = phases[i].name;
+    }
+
+    std::vector<std::atomic<size_t>> remainingDependencies(phaseCount);
+    std::vector<std::atomic<uint64_t>> cpuNs(phaseCount);
+    for (size_t i = 0; i < phaseCount; ++i) {
+        remainingDependencies[i].store(phases[i].dependencyCount);
+        cpuNs[i].store(0);
+    }
+    std::atomic<size_t> completedPhases{0};
+
+    // A phase that throws, and everything downstream of it, is skipped; the
+    // exception is rethrown here once every phase has been launched and exited
+    std::vector<std::atomic<bool>> skipped(phaseCount);
+    FirstException failure;
+
+    auto runStart = std::chrono::steady_clock::now();
+
+    std::function<void(PhaseId)> launch = [&](PhaseId id) {
+        // completedPhases is bumped once the task has let go of everything
+        // local to this call, so returning after the last one is safe
+        pool.Submit([&, id]() {
+            auto start = std::chrono::steady_clock::now();
+            bool failed = skipped[id].load();
+            if (!failed && !IsGenerationCancelled()) {
+                try {
+                    CpuCharge charge(&cpuNs[id]);
+                    phases[id].work();
+                } catch (...) {
+                    failure.Capture();
+                    failed = true;
+                }
+            }
+            timings[id].wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            for (PhaseId dependent : phases[id].dependents) {
+                if (failed) {
+                    skipped[dependent].store(true);
+                }
+                if (remainingDependencies[dependent].fetch_sub(1) == 1) {
+                    launch(dependent);
+                }
+            }
+        }, &completedPhases);
+    };
+
+    for (PhaseId id = 0; id < phaseCount; ++id) {
+        if (phases[id].dependencyCount == 0) {
+            launch(id);
+        }
+    }
+
+    pool.WaitUntil([&]() { return completedPhases.load(std::memory_order_acquire) == phaseCount; });
+
+    totalWallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+    for (size_t i = 0; i < phaseCount; ++i) {
+        timings[i].cpuMs = cpuNs[i].load() / 1.0e6;
+    }
+    failure.RethrowIfFailed();
+}
+
+void TaskGraph::LogTimings() const {
+    std::cout << "\n============ GENERATION PHASE TIMINGS ============" << std::endl;
+    double totalCpuMs = 0.0;
+    for (const auto& timing : timings) {
+        std::cout << std::left << std::setw(28) << timing.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << timing.wallMs << " ms wall" << std::setw(10) << timing.cpuMs << " ms CPU"
+                  << std::endl;
+        totalCpuMs += timing.cpuMs;
+    }
+    std::cout << std::left << std::setw(28) << "Total" << std::right << std::setw(10) << totalWallMs << " ms wall"
+              << std::setw(10) << totalCpuMs << " ms CPU" << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "==================================================" << std::endl;
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace WorldGen {
+namespace Generators {
+
+/**
+ * @brief Flag that asks a generation run to stop early
+ *
+ * Cancellation is cooperative: phases poll IsGenerationCancelled at coarse
+ * intervals and return early, leaving their output incomplete. Callers must
+ * throw away the result of a cancelled run.
+ */
+class CancellationToken {
+public:
+    void Cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    void Reset() { cancelled.store(false, std::memory_order_relaxed); }
+    bool IsCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+/**
+ * @brief Makes a token the calling thread's cancellation token for the lifetime of the scope
+ *
+ * Like CPU time accounting, the token follows work onto the pool: tasks
+ * submitted inside the scope run under the same token, so phases and their
+ * parallel loops see it without it being passed through every generator.
+ */
+class CancellationScope {
+public:
+    explicit CancellationScope(const CancellationToken* token);
+    ~CancellationScope();
+
+    CancellationScope(const CancellationScope&) = delete;
+    CancellationScope& operator=(const CancellationScope&) = delete;
+
+private:
+    const CancellationToken* savedToken;
+};
+
+/**
+ * @brief Whether the run the calling thread works for has been cancelled
+ *
+ * A thread-local read and a relaxed load, so it is cheap enough to poll
+ * every few thousand tiles.
+ *
+ * @return true if the current token has been cancelled (false without a token)
+ */
+bool IsGenerationCancelled();
+
+class ThreadPool;
+
+/**
+ * @brief Routes the calling thread's ThreadPool::GetInstance to another pool for the lifetime of the scope
+ *
+ * Lets a whole generation run (its phases and every parallel loop inside
+ * them) use a private pool without each generator taking one as a parameter.
+ * Workers of a pool always route to their own pool.
+ */
+class ThreadPoolScope {
+public:
+    explicit ThreadPoolScope(ThreadPool* pool);
+    ~ThreadPoolScope();
+
+    ThreadPoolScope(const ThreadPoolScope&) = delete;
+    ThreadPoolScope& operator=(const ThreadPoolScope&) = delete;
+
+private:
+    ThreadPool* savedPool;
+};
+
+/**
+ * @brief Work-stealing thread pool shared by the generation phases
+ *
+ * Every worker owns a task deque. Workers pop their own newest task first and
+ * steal the oldest task from another worker when theirs is empty. Threads
+ * that wait on pool work (ParallelFor callers, TaskGraph::Run) execute queued
+ * tasks while they wait, so nested parallelism never deadlocks.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Get the pool the calling thread works for
+     *
+     * That is the pool the thread is a worker of, or the one installed by a
+     * ThreadPoolScope, and otherwise the process-wide pool (one worker per
+     * hardware thread, minus the caller).
+     *
+     * @return ThreadPool& The pool to run work on
+     */
+    static ThreadPool& GetInstance();
+
+    /**
+     * @brief Create a pool
+     *
+     * @param workerCount Number of worker threads (0 runs everything on the calling thread)
+     * @param lowPriority Run the workers at the lowest scheduling priority, for speculative work
+     */
+    explicit ThreadPool(size_t workerCount, bool lowPriority = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get the number of threads that execute work, including the caller
+     *
+     * @return size_t Worker count plus one
+     */
+    size_t GetConcurrency() const { return workers.size() + 1; }
+
+    /**
+     * @brief Queue a task
+     *
+     * Tasks submitted from a worker go to that worker's own deque. The task
+     * charges its CPU time to the submitter's phase and runs under the
+     * submitter's cancellation token, so the submitter must not return before
+     * the task has finished with them: pass exited and wait for it. Tasks
+     * should catch their own exceptions; one that escapes is logged and dropped.
+     *
+     * @param task The task to run
+     * @param exited Optional counter incremented once the task and its accounting are done
+     */
+    void Submit(std::function<void()> task, std::atomic<size_t>* exited = nullptr);
+
+    /**
+     * @brief Run one queued task on the calling thread, if any
+     *
+     * @return true if a task was run
+     */
+    bool RunPendingTask();
+
+    /**
+     * @brief Block until a condition holds, running queued tasks meanwhile
+     *
+     * @param done Condition to wait for (polled, so it must be cheap and thread-safe)
+     */
+    void WaitUntil(const std::function<bool()>& done);
+
+    /**
+     * @brief Run body over [0, count) split into contiguous ranges
+     *
+     * Blocks until every range is done and every helper task has exited, so
+     * nothing queued by the loop outlives the call. The body must only write data owned
+     * by its range so the result is identical to a serial loop. The optional
+     * progress callback is only ever called on the calling thread. Once the
+     * run is cancelled (IsGenerationCancelled), ranges not yet started are skipped.
+     * If a range throws, ranges not yet started are skipped too, and the first
+     * exception is rethrown on the calling thread once every helper has exited.
+     *
+     * @param count Number of items
+     * @param body Called as body(begin, end) for each range
+     * @param progress Optional callback receiving the completed fraction (0-1)
+     * @param minRangeSize Smallest range worth handing to another thread
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& body,
+                     const std::function<void(float)>& progress = nullptr, size_t minRangeSize = 1024);
+
+    /**
+     * @brief ParallelFor with a private accumulator per range
+     *
+     * The items are split into fixed chunks of minRangeSize, however many
+     * threads there are. Every chunk starts from its own copy of identity, so
+     * the body can update it without locks or atomics (per-thread histograms,
+     * sums, min/max). The chunk results are combined on the calling thread in
+     * chunk order, so the result is the same for any number of threads even
+     * when combine is not associative (float sums).
+     *
+     * @param count Number of items
+     * @param identity Starting value of every chunk's accumulator
+     * @param body Called as body(begin, end, accumulator) for each chunk
+     * @param combine Called as combine(result, chunkAccumulator) to fold the chunks together
+     * @param progress Optional callback receiving the completed fraction (0-1)
+     * @param minRangeSize Items per chunk
+     * @return T The combined accumulator
+     */
+    template <typename T, typename Body, typename Combine>
+    T ParallelReduce(size_t count, const T& identity, Body&& body, Combine&& combine,
+                     const std::function<void(float)>& progress = nullptr, size_t minRangeSize = 1024) {
+        const size_t chunkSize = std::max<size_t>(1, minRangeSize);
+        const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+        std::vector<T> partials(chunkCount, identity);
+        ParallelFor(chunkCount, [&](size_t firstChunk, size_t lastChunk) {
+            for (size_t chunk = firstChunk; chunk < lastChunk && !IsGenerationCancelled(); ++chunk) {
+                // Accumulate locally so neighbouring chunks on other threads never share a cache line
+                T local = identity;
+                const size_t begin = chunk * chunkSize;
+                body(begin, std::min(count, begin + chunkSize), local);
+                partials[chunk] = std::move(local);
+            }
+        }, progress, 1);
+
+        T result = identity;
+        for (const auto& partial : partials) {
+            combine(result, partial);
+        }
+        return result;
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void WorkerLoop(size_t index);
+    bool TryPop(size_t preferredQueue, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; ///< One per worker, plus one for external submitters
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> pendingTasks{0};
+    bool stopping = false;
+    bool lowPriority = false;
+};
+
+/**
+ * @brief Fixed-size counter array for ParallelReduce
+ *
+ * Used to count tiles per category (terrain type, biome, ...) with one
+ * histogram per range instead of a shared map or atomic counters.
+ *
+ * @tparam Bins Number of categories
+ */
+template <size_t Bins>
+struct Histogram {
+    std::array<size_t, Bins> counts{};
+
+    void Add(size_t bin) { counts[bin]++; }
+    size_t operator[](size_t bin) const { return counts[bin]; }
+
+    Histogram& operator+=(const Histogram& other) {
+        for (size_t bin = 0; bin < Bins; ++bin) {
+            counts[bin] += other.counts[bin];
+        }
+        return *this;
+    }
+};
+
+/**
+ * @brief Wall-clock and CPU time spent in one pipeline phase
+ *
+ * CPU time is summed over every thread that worked for the phase, so on a
+ * parallel phase it exceeds the wall-clock time.
+ */
+struct PhaseTiming {
+    std::string name;
+    double wallMs = 0.0;
+    double cpuMs = 0.0;
+};
+
+/**
+ * @brief Directed acyclic graph of generation phases
+ *
+ * Phases are added with the phases they depend on and run on a ThreadPool as
+ * soon as their dependencies finish. Parallel loops inside a phase charge
+ * their CPU time back to that phase. Phases that would start after the
+ * run has been cancelled are skipped.
+ */
+class TaskGraph {
+public:
+    using PhaseId = size_t;
+
+    /**
+     * @brief Add a phase to the graph
+     *
+     * @param name Name used in the timing report
+     * @param work The phase body
+     * @param dependencies Phases that must finish first (must already be added)
+     * @return PhaseId Identifier for use as a dependency of later phases
+     */
+    PhaseId AddPhase(const std::string& name, std::function<void()> work, const std::vector<PhaseId>& dependencies = {});
+
+    /**
+     * @brief Run every phase, blocking until the whole graph is done
+     *
+     * The calling thread helps execute pool work while it waits. If a phase
+     * throws, the phases that depend on it are skipped and the first exception
+     * is rethrown here once every phase has finished or been skipped.
+     *
+     * @param pool Pool to run the phases on
+     */
+    void Run(ThreadPool& pool = ThreadPool::GetInstance());
+
+    /**
+     * @brief Get per-phase timings from the last Run, in the order phases were added
+     *
+     * @return const std::vector<PhaseTiming>& The timings
+     */
+    const std::vector<PhaseTiming>& GetTimings() const { return timings; }
+
+    /**
+     * @brief Print the per-phase timings of the last Run
+     */
+    void LogTimings() const;
+
+private:
+    struct Phase {
+        std::string name;
+        std::function<void()> work;
+        std::vector<PhaseId> dependents;
+        size_t dependencyCount = 0;
+    };
+
+    std::vector<Phase> phases;
+    std::vector<PhaseTiming> timings;
+    double totalWallMs = 0.0;
+};
+
+} // namespace Generators
+} // namespace WorldGen
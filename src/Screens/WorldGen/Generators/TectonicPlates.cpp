@@ -213,7 +213,7 @@ void AssignTilesToPlates(World* world, std::vector<Plate>& plates, int targetTot
         // Report progress
         if (progressTracker && tileIdx % 1000 == 0) {
             float progress = 0.6f + (static_cast<float>(tileIdx) / tiles.size()) * 0.15f;
-            progressTracker->UpdateProgress(progress, "Assigning to major plates: " + std::to_string(tileIdx) + "/" + std::to_string(tiles.size()));
+            progressTracker->UpdateProgress(progress, "Assigning to major plates: {current}/{total}", tileIdx, tiles.size());
         }
     }
     
@@ -365,7 +365,7 @@ void GenerateMountains(World* world, const std::vector<Plate>& plates, std::shar
         // Report progress
         if (progressTracker && tileIdx % 1000 == 0) {
             float progress = 0.1f + (static_cast<float>(tileIdx) / tiles.size()) * 0.3f;
-            progressTracker->UpdateProgress(progress, "Analyzing boundaries: " + std::to_string(tileIdx) + "/" + std::to_string(tiles.size()));
+            progressTracker->UpdateProgress(progress, "Analyzing boundaries: {current}/{total}", tileIdx, tiles.size());
         }
     }
     
@@ -518,7 +518,7 @@ void GenerateMountains(World* world, const std::vector<Plate>& plates, std::shar
         // Report progress
         if (progressTracker && tileIdx % 1000 == 0) {
             float progress = 0.6f + (static_cast<float>(tileIdx) / tiles.size()) * 0.4f;
-            progressTracker->UpdateProgress(progress, "Applying mountains: " + std::to_string(tileIdx) + "/" + std::to_string(tiles.size()));
+            progressTracker->UpdateProgress(progress, "Applying mountains: {current}/{total}", tileIdx, tiles.size());
         }
     }
     
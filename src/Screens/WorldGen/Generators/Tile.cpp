@@ -1,5 +1,6 @@
 #include "Tile.h"
 #include <algorithm>
+#include <iostream>
 
 namespace WorldGen {
 namespace Generators {
@@ -12,32 +13,65 @@ Tile::Tile(const glm::vec3& center, TileShape shape)
     this->center = glm::normalize(this->center);
 }
 
+Tile Tile::FromNormalized(const glm::vec3& center, TileShape shape, std::span<const glm::vec3> vertices)
+{
+    Tile tile(center, shape);
+    tile.center = center;
+    tile.SetVertices(vertices);
+    std::copy_n(vertices.begin(), tile.vertexCount, tile.vertices.begin());
+    return tile;
+}
+
 void Tile::AddNeighbor(int neighborIndex)
 {
     // Avoid duplicates
-    if (std::find(neighbors.begin(), neighbors.end(), neighborIndex) == neighbors.end()) {
-        neighbors.push_back(neighborIndex);
+    auto current = GetNeighbors();
+    if (std::find(current.begin(), current.end(), neighborIndex) != current.end()) {
+        return;
     }
+    if (neighborCount == MaxSides) {
+        std::cerr << "WARNING: Tile already has " << MaxSides << " neighbors, ignoring " << neighborIndex << std::endl;
+        return;
+    }
+    neighbors[neighborCount++] = neighborIndex;
 }
 
 void Tile::AddVertex(const glm::vec3& vertex)
 {
-    vertices.push_back(glm::normalize(vertex)); // Ensure vertex is normalized
+    if (vertexCount == MaxSides) {
+        std::cerr << "WARNING: Tile already has " << MaxSides << " vertices, ignoring extra vertex" << std::endl;
+        return;
+    }
+    vertices[vertexCount++] = glm::normalize(vertex); // Ensure vertex is normalized
 }
 
-void Tile::SetVertices(const std::vector<glm::vec3>& vertices)
+void Tile::SetVertices(std::span<const glm::vec3> vertices)
 {
-    this->vertices = vertices;
+    if (vertices.size() > MaxSides) {
+        std::cerr << "WARNING: Tile given " << vertices.size() << " vertices, keeping the first " << MaxSides << std::endl;
+    }
+    vertexCount = static_cast<uint8_t>(std::min(vertices.size(), MaxSides));
     
     // Ensure all vertices are normalized
-    for (auto& vertex : this->vertices) {
-        vertex = glm::normalize(vertex);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        this->vertices[i] = glm::normalize(vertices[i]);
     }
 }
 
-void Tile::SetNeighbors(const std::vector<int>& neighbors)
+void Tile::SetNeighbors(std::span<const int> neighbors)
 {
-    this->neighbors = neighbors;
+    if (neighbors.size() > MaxSides) {
+        std::cerr << "WARNING: Tile given " << neighbors.size() << " neighbors, keeping the first " << MaxSides << std::endl;
+    }
+    neighborCount = static_cast<uint8_t>(std::min(neighbors.size(), MaxSides));
+    std::copy_n(neighbors.begin(), neighborCount, this->neighbors.begin());
+}
+
+void Tile::RemapNeighbors(std::span<const int> oldToNew)
+{
+    for (size_t i = 0; i < neighborCount; ++i) {
+        neighbors[i] = oldToNew[neighbors[i]];
+    }
 }
 
 } // namespace Generators
@@ -1,7 +1,8 @@
 #pragma once
 
-#include <vector>
-#include <memory>
+#include <array>
+#include <cstdint>
+#include <span>
 #include <glm/glm.hpp>
 #include "../Core/TerrainTypes.h" // Include TerrainTypes.h for TerrainType and BiomeType enums
 
@@ -14,12 +15,21 @@ namespace Generators {
  * This class stores information about a tile's center position, vertices,
  * edges, and its neighboring tiles in the world. It can represent either
  * a pentagon or a hexagon.
+ * 
+ * Neighbors and vertices are stored inline (a tile has at most six of each)
+ * so a tile needs no heap allocations; this keeps million-tile worlds compact.
  */
 class Tile {
-public:    /**
+public:
+    /**
+     * @brief Maximum number of neighbors or boundary vertices of a tile.
+     */
+    static constexpr size_t MaxSides = 6;
+
+    /**
      * @brief Enum representing the possible shapes of tiles.
      */
-    enum class TileShape {
+    enum class TileShape : uint8_t {
         Pentagon,
         Hexagon
     };    /**
@@ -30,6 +40,20 @@ public:    /**
      */
     Tile(const glm::vec3& center, TileShape shape);
 
+    /**
+     * @brief Rebuild a tile whose center and vertices are already normalized.
+     * 
+     * Normalizing a unit vector again can move it by a rounding step, so
+     * loading a stored tile through the constructor and SetVertices would
+     * not reproduce it exactly.
+     * 
+     * @param center The stored center position.
+     * @param shape The shape of tile (pentagon or hexagon).
+     * @param vertices The stored boundary vertices.
+     * @return Tile The tile, bit-identical to the one that was stored.
+     */
+    static Tile FromNormalized(const glm::vec3& center, TileShape shape, std::span<const glm::vec3> vertices);
+
     /**
      * @brief Get the center position of the tile.
      * 
@@ -45,16 +69,16 @@ public:    /**
     /**
      * @brief Get the indices of neighboring tiles.
      * 
-     * @return const std::vector<int>& Vector of neighboring tile indices.
+     * @return std::span<const int> Neighboring tile indices.
      */
-    const std::vector<int>& GetNeighbors() const { return neighbors; }
+    std::span<const int> GetNeighbors() const { return std::span<const int>(neighbors.data(), neighborCount); }
 
     /**
      * @brief Get the vertices that define the tile's boundary.
      * 
-     * @return const std::vector<glm::vec3>& Vector of vertex positions (normalized to unit sphere).
+     * @return std::span<const glm::vec3> Vertex positions (normalized to unit sphere).
      */
-    const std::vector<glm::vec3>& GetVertices() const { return vertices; }
+    std::span<const glm::vec3> GetVertices() const { return std::span<const glm::vec3>(vertices.data(), vertexCount); }
 
     /**
      * @brief Add a neighbor to this tile.
@@ -73,16 +97,23 @@ public:    /**
     /**
      * @brief Set the vertices that define the tile's boundary.
      * 
-     * @param vertices Vector of vertex positions (normalized to unit sphere).
+     * @param vertices Vertex positions (normalized to unit sphere).
      */
-    void SetVertices(const std::vector<glm::vec3>& vertices);
+    void SetVertices(std::span<const glm::vec3> vertices);
 
     /**
      * @brief Set the neighbors of this tile.
      * 
-     * @param neighbors Vector of neighboring tile indices.
+     * @param neighbors Neighboring tile indices.
      */
-    void SetNeighbors(const std::vector<int>& neighbors);
+    void SetNeighbors(std::span<const int> neighbors);
+
+    /**
+     * @brief Rewrite neighbor indices after the world's tiles were reordered.
+     * 
+     * @param oldToNew Mapping from old tile index to new tile index.
+     */
+    void RemapNeighbors(std::span<const int> oldToNew);
     
     // Terrain data properties
     
@@ -133,28 +164,28 @@ public:    /**
      * 
      * @return TerrainType The terrain type.
      */
-    TerrainType GetTerrainType() const { return terrainType; }
+    TerrainType GetTerrainType() const { return static_cast<TerrainType>(terrainType); }
     
     /**
      * @brief Set the terrain type of this tile.
      * 
      * @param terrainType The terrain type.
      */
-    void SetTerrainType(TerrainType terrainType) { this->terrainType = terrainType; }
+    void SetTerrainType(TerrainType terrainType) { this->terrainType = static_cast<uint8_t>(terrainType); }
     
     /**
      * @brief Get the biome type of this tile.
      * 
      * @return BiomeType The biome type.
      */
-    BiomeType GetBiomeType() const { return biomeType; }
+    BiomeType GetBiomeType() const { return static_cast<BiomeType>(biomeType); }
     
     /**
      * @brief Set the biome type of this tile.
      * 
      * @param biomeType The biome type.
      */
-    void SetBiomeType(BiomeType biomeType) { this->biomeType = biomeType; }
+    void SetBiomeType(BiomeType biomeType) { this->biomeType = static_cast<uint8_t>(biomeType); }
     
     /**
      * @brief Get the tectonic plate ID of this tile.
@@ -172,19 +203,22 @@ public:    /**
 
 private:
     glm::vec3 center;                ///< Center position of the tile
-    TileShape shape;                 ///< Shape of tile (Pentagon or Hexagon)
-    std::vector<int> neighbors;      ///< Indices of neighboring tiles
-    std::vector<glm::vec3> vertices; ///< Positions of the tile's boundary vertices
+    std::array<int, MaxSides> neighbors{};          ///< Indices of neighboring tiles
+    std::array<glm::vec3, MaxSides> vertices{};     ///< Positions of the tile's boundary vertices
     
     // Terrain attributes
     float elevation = 0.5f;          ///< Elevation of the tile (0.0-1.0)
     float moisture = 0.5f;           ///< Moisture level of the tile (0.0-1.0)
     float temperature = 0.5f;        ///< Temperature of the tile (0.0-1.0)
-    TerrainType terrainType = TerrainType::Lowland; ///< Type of terrain in this tile
-    BiomeType biomeType = BiomeType::TemperateGrassland; ///< Biome type in this tile
     
     // Tectonic plate data
     int plateId = -1;                ///< Tectonic plate ID (-1 if unassigned)
+    
+    TileShape shape;                 ///< Shape of tile (Pentagon or Hexagon)
+    uint8_t neighborCount = 0;       ///< Number of valid entries in neighbors
+    uint8_t vertexCount = 0;         ///< Number of valid entries in vertices
+    uint8_t terrainType = static_cast<uint8_t>(TerrainType::Lowland);        ///< Type of terrain in this tile
+    uint8_t biomeType = static_cast<uint8_t>(BiomeType::TemperateGrassland); ///< Biome type in this tile
 };
 
 } // namespace Generators
@@ -0,0 +1,145 @@
+#include "TileDistanceField.h"
+#include "GraphSmoothing.h"
+#include "World.h"
+#include "Tile.h"
+#include "TaskGraph.h"
+#include <algorithm>
+#include <iostream>
+#include <queue>
+
+namespace WorldGen {
+namespace Generators {
+
+TileDistanceField ComputeTileDistanceField(const World& world, const TileAdjacency& adjacency,
+                                           std::span<const int> sources, const DistanceFieldOptions& options) {
+    const auto& tiles = world.GetTiles();
+    const size_t tileCount = adjacency.GetTileCount();
+
+    TileDistanceField field;
+    if (tileCount != tiles.size() || (!options.tileCosts.empty() && options.tileCosts.size() != tileCount)) {
+        std::cerr << "ERROR: Distance field inputs do not match the world's " << tiles.size() << " tiles" << std::endl;
+        return field;
+    }
+
+    field.distance.assign(tileCount, std::numeric_limits<float>::infinity());
+    field.nearestSource.assign(tileCount, -1);
+
+    // Normalized centers up front so each edge length is a subtraction and a sqrt
+    std::vector<glm::vec3> centers(tileCount);
+    for (size_t i = 0; i < tileCount; ++i) {
+        centers[i] = glm::normalize(tiles[i].GetCenter());
+    }
+
+    // Min-heap of (distance, tile); stale entries are skipped when popped
+    using QueueEntry = std::pair<float, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> frontier;
+
+    for (size_t sourceIdx = 0; sourceIdx < sources.size(); ++sourceIdx) {
+        int tileIdx = sources[sourceIdx];
+        if (tileIdx < 0 || static_cast<size_t>(tileIdx) >= tileCount || field.nearestSource[tileIdx] >= 0) {
+            continue;
+        }
+        field.distance[tileIdx] = 0.0f;
+        field.nearestSource[tileIdx] = static_cast<int>(sourceIdx);
+        frontier.emplace(0.0f, tileIdx);
+    }
+
+    while (!frontier.empty()) {
+        auto [distance, tileIdx] = frontier.top();
+        frontier.pop();
+        if (distance > field.distance[tileIdx]) {
+            continue;
+        }
+        field.reached.push_back(tileIdx);
+        if ((field.reached.size() & 0xFFFF) == 0 && IsGenerationCancelled()) {
+            break; // The caller discards the run, so a partial field is fine
+        }
+
+        for (int neighborIdx : adjacency.GetNeighbors(tileIdx)) {
+            float step = glm::length(centers[neighborIdx] - centers[tileIdx]);
+            if (!options.tileCosts.empty()) {
+                step *= options.tileCosts[neighborIdx];
+            }
+
+            float candidate = distance + step;
+            if (candidate < field.distance[neighborIdx] && candidate <= options.maxDistance) {
+                field.distance[neighborIdx] = candidate;
+                field.nearestSource[neighborIdx] = field.nearestSource[tileIdx];
+                frontier.emplace(candidate, neighborIdx);
+            }
+        }
+    }
+
+    return field;
+}
+
+TileDistanceField ComputeTileHopField(const World& world, std::span<const int> sources, int maxHops) {
+    const auto& tiles = world.GetTiles();
+    const size_t tileCount = tiles.size();
+
+    TileDistanceField field;
+    field.distance.assign(tileCount, std::numeric_limits<float>::infinity());
+    field.nearestSource.assign(tileCount, -1);
+
+    std::vector<int> frontier;
+    for (size_t sourceIdx = 0; sourceIdx < sources.size(); ++sourceIdx) {
+        int tileIdx = sources[sourceIdx];
+        if (tileIdx < 0 || static_cast<size_t>(tileIdx) >= tileCount || field.nearestSource[tileIdx] >= 0) {
+            continue;
+        }
+        field.distance[tileIdx] = 0.0f;
+        field.nearestSource[tileIdx] = static_cast<int>(sourceIdx);
+        frontier.push_back(tileIdx);
+    }
+    std::sort(frontier.begin(), frontier.end());
+    field.reached = frontier;
+
+    std::vector<int> next;
+    for (int hop = 1; hop <= maxHops && !frontier.empty(); ++hop) {
+        next.clear();
+        for (int tileIdx : frontier) {
+            for (int neighborIdx : tiles[tileIdx].GetNeighbors()) {
+                if (field.nearestSource[neighborIdx] < 0) {
+                    field.distance[neighborIdx] = static_cast<float>(hop);
+                    field.nearestSource[neighborIdx] = field.nearestSource[tileIdx];
+                    next.push_back(neighborIdx);
+                }
+            }
+        }
+        std::sort(next.begin(), next.end());
+        field.reached.insert(field.reached.end(), next.begin(), next.end());
+        frontier.swap(next);
+    }
+
+    return field;
+}
+
+int FindNearestTile(const World& world, const TileAdjacency& adjacency, const glm::vec3& point, int startTile) {
+    const auto& tiles = world.GetTiles();
+    if (tiles.empty()) {
+        return -1;
+    }
+
+    glm::vec3 target = glm::normalize(point);
+    int current = (startTile >= 0 && static_cast<size_t>(startTile) < tiles.size()) ? startTile : 0;
+    float currentDistance = glm::distance(glm::normalize(tiles[current].GetCenter()), target);
+
+    // Greedy descent; the distance strictly decreases so the walk always ends
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (int neighborIdx : adjacency.GetNeighbors(current)) {
+            float distance = glm::distance(glm::normalize(tiles[neighborIdx].GetCenter()), target);
+            if (distance < currentDistance) {
+                currentDistance = distance;
+                current = neighborIdx;
+                improved = true;
+            }
+        }
+    }
+
+    return current;
+}
+
+} // namespace Generators
+} // namespace WorldGen
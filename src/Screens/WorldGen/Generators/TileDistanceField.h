@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace WorldGen {
+namespace Generators {
+
+// Forward declarations
+class World;
+struct TileAdjacency;
+
+/**
+ * @brief Distance from every tile to its nearest source tile
+ *
+ * Distances are path lengths over the tile graph, measured in unit-sphere
+ * units (the chord between neighbouring tile centers), so they approximate
+ * geodesic distance on the planet.
+ */
+struct TileDistanceField {
+    std::vector<float> distance;    // Per tile: distance to the nearest source (infinity if unreached)
+    std::vector<int> nearestSource; // Per tile: index into the sources list of the nearest source (-1 if unreached)
+    std::vector<int> reached;       // Reached tiles, nearest first, so callers can skip the rest of the world
+};
+
+/**
+ * @brief Options for ComputeTileDistanceField
+ */
+struct DistanceFieldOptions {
+    std::span<const float> tileCosts;  // Per tile: multiplier on the length of edges entering it (empty = 1)
+    float maxDistance = std::numeric_limits<float>::infinity(); // Tiles farther than this stay unreached
+};
+
+/**
+ * @brief Grow regions outwards from a set of source tiles
+ *
+ * Multi-source Dijkstra over the tile adjacency graph: every tile is settled
+ * once, in order of distance, and takes the source of the neighbour it was
+ * reached from. With per-tile costs the regions grow faster through cheap
+ * tiles, which gives irregular, noise-shaped borders that are still
+ * guaranteed to be contiguous. Runs in O(tiles log tiles) regardless of the
+ * number of sources.
+ *
+ * @param world The world whose tile centers give the edge lengths
+ * @param adjacency Tile adjacency graph of the world
+ * @param sources Source tile indices; a tile listed twice keeps its first entry
+ * @param options Per-tile costs and distance cutoff
+ * @return TileDistanceField Distance and nearest source for every tile
+ */
+TileDistanceField ComputeTileDistanceField(const World& world, const TileAdjacency& adjacency,
+                                           std::span<const int> sources, const DistanceFieldOptions& options = {});
+
+/**
+ * @brief Breadth-first hop counts from a set of source tiles
+ *
+ * Expands an explicit frontier one ring at a time, so the work is
+ * proportional to the tiles within maxHops of a source rather than to the
+ * whole world. Each ring is expanded in ascending tile order and a tile takes
+ * the source of the first frontier tile to reach it, so results do not depend
+ * on the order of the sources. Reads the neighbours straight from the tiles,
+ * since a narrow band does not pay for building a TileAdjacency.
+ *
+ * @param world The world whose tiles give the neighbours
+ * @param sources Source tile indices; a tile listed twice keeps its first entry
+ * @param maxHops Tiles more than this many steps from every source stay unreached
+ * @return TileDistanceField Hop count (as distance) and nearest source for every tile
+ */
+TileDistanceField ComputeTileHopField(const World& world, std::span<const int> sources, int maxHops);
+
+/**
+ * @brief Find the tile whose center is nearest to a point
+ *
+ * Walks from startTile to whichever neighbour is closer to the point until no
+ * neighbour is, which takes O(sqrt(tiles)) steps on a sphere instead of
+ * scanning every tile.
+ *
+ * @param world The world to search
+ * @param adjacency Tile adjacency graph of the world
+ * @param point Point on the unit sphere
+ * @param startTile Tile to start walking from
+ * @return int Index of the nearest tile, or -1 if the world has no tiles
+ */
+int FindNearestTile(const World& world, const TileAdjacency& adjacency, const glm::vec3& point, int startTile = 0);
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace WorldGen {
+namespace Generators {
+
+// Forward declaration
+class World;
+
+/**
+ * @brief Memory locality of a world's current tile order
+ */
+struct TileLocality {
+    double neighborWalkMs = 0.0;        // Best of several probe neighbour walks over every tile
+    double meanNeighborDistance = 0.0;  // Average |tile index - neighbour index|
+};
+
+/**
+ * @brief Compute the 3D Hilbert curve key of a point on the unit sphere
+ *
+ * The point is quantized into a cube of 2^bits cells per axis and mapped onto
+ * a Hilbert curve through that cube. Points that are close on the sphere get
+ * keys that are close on the curve, so sorting by key clusters neighbours.
+ *
+ * @param point Point on the unit sphere
+ * @param bits Bits of precision per axis (1-21)
+ * @return uint64_t Position of the point along the curve
+ */
+uint64_t HilbertKey3D(const glm::vec3& point, int bits = 21);
+
+/**
+ * @brief Compute a cache-friendly tile order along a Hilbert curve
+ *
+ * @param world The world whose tiles should be ordered
+ * @return std::vector<int> New tile order; element n is the old index of the tile placed at n
+ */
+std::vector<int> ComputeHilbertTileOrder(const World& world);
+
+/**
+ * @brief Measure how local neighbour walks are in the world's current tile order
+ *
+ * Times several full neighbour walks, so it is meant for benchmarks rather
+ * than the generation pipeline.
+ *
+ * @param world The world to measure
+ * @return TileLocality Probe walk time and mean neighbour index distance
+ */
+TileLocality MeasureTileLocality(const World& world);
+
+/**
+ * @brief Renumber world tiles along a space-filling curve
+ *
+ * Tile indices produced by TrianglesToTiles follow hash map iteration order, so
+ * neighbouring tiles end up scattered across memory. This pass sorts the tiles
+ * along a Hilbert curve and remaps every neighbour and plate reference, turning
+ * neighbour walks (smoothing, margins, mountains, point location) into mostly
+ * sequential memory access.
+ *
+ * It runs inside the geometry phase and reports no progress of its own, so
+ * the shared tracker keeps the geometry phase's position.
+ *
+ * @param world The world to renumber (modified in-place)
+ */
+void RenumberTilesAlongHilbertCurve(World* world);
+
+} // namespace Generators
+} // namespace WorldGen
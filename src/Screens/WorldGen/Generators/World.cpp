@@ -17,6 +17,10 @@
 // Project headers
 #include "World.h"
 #include "Plate.h"
+#include "GraphSmoothing.h"
+#include "CounterRandom.h"
+#include "TaskGraph.h"
+#include "Classification.h"
 #include "../Core/WorldGenParameters.h"
 #include "../Core/Util.h"
 #include <cmath>
@@ -42,6 +46,7 @@ World::World(const PlanetParameters& params, uint64_t seed, std::shared_ptr<Prog
     : radius(params.radius)
     , pentagonCount(0)
     , seed(seed)
+    , distortionSeed(params.distortionSeed)
     , progressTracker(progressTracker)
 {
     CreateIcosahedron();
@@ -66,8 +71,7 @@ void World::Generate(int subdivisionLevel, float distortionFactor, std::shared_p
         // Add phases with appropriate weights
         progressTracker->AddPhase("Initialization", 0.05f);
         progressTracker->AddPhase("Subdividing", 0.35f);
-        progressTracker->AddPhase("Creating Tiles", 0.15f);
-        progressTracker->AddPhase("Setting Up Neighbors", 0.15f);
+        progressTracker->AddPhase("Creating Tiles", 0.30f);
         progressTracker->AddPhase("Generating Terrain", 0.30f);
         
         // Start first phase
@@ -89,6 +93,9 @@ void World::Generate(int subdivisionLevel, float distortionFactor, std::shared_p
     // Subdivide it the specified number of times
     std::cout << "Subdividing icosahedron..." << std::endl;
     SubdivideIcosahedron(subdivisionLevel, distortionFactor);
+    if (IsGenerationCancelled()) {
+        return;
+    }
     
     // Report phase completion
     if (progressTracker) {
@@ -96,20 +103,14 @@ void World::Generate(int subdivisionLevel, float distortionFactor, std::shared_p
         progressTracker->StartPhase("Creating Tiles");
     }
     
-    // Convert the triangular mesh to a dual polyhedron of pentagons and hexagons
+    // Convert the triangular mesh to a dual polyhedron of pentagons and hexagons,
+    // including the neighborhood relationships between tiles
     std::cout << "Converting to tiles..." << std::endl;
     TrianglesToTiles();
-    
-    // Report phase completion
-    if (progressTracker) {
-        progressTracker->CompletePhase();
-        progressTracker->StartPhase("Setting Up Neighbors");
+    if (IsGenerationCancelled()) {
+        return;
     }
     
-    // Set up neighborhood relationships between tiles
-    std::cout << "Setting up tile neighbors..." << std::endl;
-    SetupTileNeighbors();
-    
     // Report phase completion
     if (progressTracker) {
         progressTracker->CompletePhase();
@@ -195,16 +196,53 @@ void World::CreateIcosahedron() {
 
 void World::SubdivideIcosahedron(int level, float distortionFactor) {
     for (int i = 0; i < level; i++) {
+        if (IsGenerationCancelled()) {
+            return;
+        }
+        
         // Report subdivision progress if we have a tracker
         if (progressTracker) {
             float iterationProgress = static_cast<float>(i) / level;
-            std::string message = "Subdividing icosphere (level " + std::to_string(i+1) + 
-                                 " of " + std::to_string(level) + ")";
-            progressTracker->UpdateProgress(iterationProgress, message);
+            progressTracker->UpdateProgress(iterationProgress, "Subdividing icosphere (level {current} of {total})",
+                                            i + 1, level);
         }
 
+        // Collect every edge once as a sorted key list instead of a hash map of
+        // midpoints; the position of an edge in the list is its midpoint's index
+        std::vector<uint64_t> edges;
+        edges.reserve(subdivisionFaces.size() * 3);
+        for (const auto& face : subdivisionFaces) {
+            edges.push_back(EdgeKey(face[0], face[1]));
+            edges.push_back(EdgeKey(face[1], face[2]));
+            edges.push_back(EdgeKey(face[2], face[0]));
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        edges.shrink_to_fit();
+        
+        // Create one midpoint vertex per edge. Midpoints only read the
+        // vertices of the previous level, so the edges can be split freely.
+        const int firstMidpoint = static_cast<int>(subdivisionVertices.size());
+        subdivisionVertices.resize(subdivisionVertices.size() + edges.size());
+        ThreadPool::GetInstance().ParallelFor(edges.size(), [&](size_t begin, size_t end) {
+            for (size_t edgeIdx = begin; edgeIdx < end; ++edgeIdx) {
+                int v1 = static_cast<int>(edges[edgeIdx] >> 32);
+                int v2 = static_cast<int>(edges[edgeIdx] & 0xFFFFFFFF);
+                subdivisionVertices[firstMidpoint + edgeIdx] =
+                    GetMidPoint(subdivisionVertices[v1], subdivisionVertices[v2], distortionFactor);
+            }
+        });
+        if (IsGenerationCancelled()) {
+            return;
+        }
+        
+        auto midpointIndex = [&](int v1, int v2) {
+            auto it = std::lower_bound(edges.begin(), edges.end(), EdgeKey(v1, v2));
+            return firstMidpoint + static_cast<int>(it - edges.begin());
+        };
+        
         std::vector<std::array<int, 3>> newFaces;
-        midPointCache.clear();
+        newFaces.reserve(subdivisionFaces.size() * 4);
         
         // Count for more detailed progress reporting within each level
         size_t faceCount = subdivisionFaces.size();
@@ -217,28 +255,26 @@ void World::SubdivideIcosahedron(int level, float distortionFactor) {
             int v3 = face[2];
             
             // Get the midpoints of the three edges
-            int a = GetMidPointIndex(v1, v2, distortionFactor);
-            int b = GetMidPointIndex(v2, v3, distortionFactor);
-            int c = GetMidPointIndex(v3, v1, distortionFactor);
+            int a = midpointIndex(v1, v2);
+            int b = midpointIndex(v2, v3);
+            int c = midpointIndex(v3, v1);
               
             // Create four new faces (subdividing the original triangle)
-            std::array<int, 3> face1 = {v1, a, c};
-            std::array<int, 3> face2 = {v2, b, a};
-            std::array<int, 3> face3 = {v3, c, b};
-            std::array<int, 3> face4 = {a, b, c};
-            newFaces.push_back(face1);
-            newFaces.push_back(face2);
-            newFaces.push_back(face3);
-            newFaces.push_back(face4);
+            newFaces.push_back({v1, a, c});
+            newFaces.push_back({v2, b, a});
+            newFaces.push_back({v3, c, b});
+            newFaces.push_back({a, b, c});
             
             // Report detailed progress for large subdivision levels
             facesDone++;
-            if (progressTracker && level > 3 && facesDone % 100 == 0) {
+            if (facesDone % 4096 == 0 && IsGenerationCancelled()) {
+                return;
+            }
+            if (progressTracker && level > 3 && facesDone % 10000 == 0) {
                 float subProgress = static_cast<float>(i) / level + 
                                    (static_cast<float>(facesDone) / faceCount) / level;
-                std::string detailMsg = "Processing face " + std::to_string(facesDone) + 
-                                      " of " + std::to_string(faceCount);
-                progressTracker->UpdateProgress(subProgress, detailMsg);
+                progressTracker->UpdateProgress(subProgress, "Processing face {current} of {total}",
+                                                facesDone, faceCount);
             }
         }
         
@@ -247,30 +283,7 @@ void World::SubdivideIcosahedron(int level, float distortionFactor) {
     }
 }
 
-int World::GetMidPointIndex(int v1, int v2, float distortionFactor) {
-    // First check if we've already calculated this midpoint
-    uint64_t key = EdgeKey(v1, v2);
-    auto it = midPointCache.find(key);
-    if (it != midPointCache.end()) {
-        return static_cast<int>(it->second);
-    }
-    
-    // Calculate the midpoint with distortion
-    glm::vec3 midPoint = GetMidPoint(
-        subdivisionVertices[v1], 
-        subdivisionVertices[v2], 
-        distortionFactor
-    );
-      // Add the new vertex
-    int index = static_cast<int>(subdivisionVertices.size());
-    subdivisionVertices.push_back(midPoint);
-      // Store in the cache
-    midPointCache[key] = static_cast<size_t>(index);
-    
-    return index;
-}
-
-glm::vec3 World::GetMidPoint(const glm::vec3& v1, const glm::vec3& v2, float distortionFactor) {
+glm::vec3 World::GetMidPoint(const glm::vec3& v1, const glm::vec3& v2, float distortionFactor) const {
     // Calculate the midpoint
     glm::vec3 midPoint = (v1 + v2) * 0.5f;
     
@@ -283,13 +296,12 @@ glm::vec3 World::GetMidPoint(const glm::vec3& v1, const glm::vec3& v2, float dis
     return glm::normalize(midPoint);
 }
 
-glm::vec3 World::ApplyDistortion(const glm::vec3& point, float magnitude) {
-    // Create a random number generator with the seed (non-static so it's re-seeded each time)
-    std::mt19937 rng(static_cast<unsigned int>(seed & 0xFFFFFFFF));
-    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
-    
-    // Calculate a random offset vector
-    glm::vec3 offset(dist(rng), dist(rng), dist(rng));
+glm::vec3 World::ApplyDistortion(const glm::vec3& point, float magnitude) const {
+    // The offset vector depends only on the distortion seed, so every call
+    // (on any thread) draws the same one
+    const CounterRandom random(distortionSeed, RandomStream::GridDistortion);
+    glm::vec3 offset(random.Uniform(0, 0, -1.0f, 1.0f), random.Uniform(0, 1, -1.0f, 1.0f),
+                     random.Uniform(0, 2, -1.0f, 1.0f));
     
     // Make the offset perpendicular to the point direction
     // This ensures the distortion doesn't change the distance from center too much
@@ -306,176 +318,129 @@ void World::TrianglesToTiles() {
     // Reset tile data
     tiles.clear();
     pentagonCount = 0;
-      // Create a mapping from vertices to their adjacent face centers
-    std::unordered_map<size_t, std::vector<int>> vertexFaceCenters;
-    std::vector<glm::vec3> faceCenters;
     
-    // Calculate face centers for all triangular faces
-    size_t totalFaces = subdivisionFaces.size();
-    size_t processedFaces = 0;
+    const size_t vertexCount = subdivisionVertices.size();
+    const size_t totalFaces = subdivisionFaces.size();
     
+    // Calculate face centers for all triangular faces; these become tile corners
+    std::vector<glm::vec3> faceCenters(totalFaces);
     for (size_t i = 0; i < totalFaces; i++) {
         const auto& face = subdivisionFaces[i];
-          // Calculate the face center by averaging its vertices
-        glm::vec3 center = (subdivisionVertices[face.at(0)] + 
-                           subdivisionVertices[face.at(1)] + 
-                           subdivisionVertices[face.at(2)]) / 3.0f;
-        center = glm::normalize(center); // Project to sphere
-        
-        // Store the center
-        faceCenters.push_back(center);
-        
-        // Record that this face center is adjacent to all three vertices
-        int faceCenterIdx = static_cast<int>(faceCenters.size() - 1);
-        vertexFaceCenters[face[0]].push_back(faceCenterIdx);
-        vertexFaceCenters[face[1]].push_back(faceCenterIdx);
-        vertexFaceCenters[face[2]].push_back(faceCenterIdx);
+        faceCenters[i] = glm::normalize(subdivisionVertices[face[0]] + 
+                                        subdivisionVertices[face[1]] + 
+                                        subdivisionVertices[face[2]]);
         
         // Report progress periodically
-        processedFaces++;
-        if (progressTracker && processedFaces % 500 == 0) {
-            float progress = static_cast<float>(processedFaces) / totalFaces;
-            std::string message = "Calculating face centers (" + 
-                                 std::to_string(processedFaces) + " of " + 
-                                 std::to_string(totalFaces) + ")";
-            progressTracker->UpdateProgress(progress, message);
+        if (i % 4096 == 0 && IsGenerationCancelled()) {
+            return;
+        }
+        if (progressTracker && i % 10000 == 0) {
+            float progress = static_cast<float>(i) / totalFaces * 0.3f;
+            progressTracker->UpdateProgress(progress, "Calculating face centers ({current} of {total})", i, totalFaces);
         }
     }
     
-    // For each vertex, create a tile using the face centers around it
-    size_t totalVertices = vertexFaceCenters.size();
-    size_t processedVertices = 0;
+    // Vertex-to-face adjacency as compressed rows: faces around vertex v are
+    // vertexFaces[vertexFaceOffsets[v] .. vertexFaceOffsets[v + 1])
+    std::vector<uint32_t> vertexFaceOffsets(vertexCount + 1, 0);
+    for (const auto& face : subdivisionFaces) {
+        vertexFaceOffsets[face[0] + 1]++;
+        vertexFaceOffsets[face[1] + 1]++;
+        vertexFaceOffsets[face[2] + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++) {
+        vertexFaceOffsets[v + 1] += vertexFaceOffsets[v];
+    }
+    std::vector<uint32_t> vertexFaces(vertexFaceOffsets[vertexCount]);
+    {
+        std::vector<uint32_t> cursor(vertexFaceOffsets.begin(), vertexFaceOffsets.end() - 1);
+        for (size_t f = 0; f < totalFaces; f++) {
+            for (int v : subdivisionFaces[f]) {
+                vertexFaces[cursor[v]++] = static_cast<uint32_t>(f);
+            }
+        }
+    }
     
-    for (const auto& [vertexIndex, adjacentCenters] : vertexFaceCenters) {        
+    // For each vertex, create a tile from the ring of faces around it. Walking
+    // the ring orders the corners and yields the neighbouring vertices (which
+    // are the neighbouring tiles) in the same pass.
+    tiles.reserve(vertexCount);
+    for (size_t vertexIndex = 0; vertexIndex < vertexCount; vertexIndex++) {
         // Identify the shape of tile (pentagon or hexagon)
         // The original 12 icosahedron vertices will be pentagons, the rest are hexagons
         bool isPentagon = vertexIndex < 12;
         Tile::TileShape shape = isPentagon ? Tile::TileShape::Pentagon : Tile::TileShape::Hexagon;
-          // Create a new tile centered at the vertex
         Tile tile(subdivisionVertices[vertexIndex], shape);
         
-        // We need to order the face centers to form a proper polygon
-        std::vector<glm::vec3> orderedVertices;
+        const uint32_t begin = vertexFaceOffsets[vertexIndex];
+        const size_t ringSize = vertexFaceOffsets[vertexIndex + 1] - begin;
+        if (ringSize > Tile::MaxSides) {
+            std::cerr << "Warning: Vertex " << vertexIndex << " touches " << ringSize << " faces" << std::endl;
+        }
         
-        // For this simplified implementation, we'll just add all adjacent face centers
-        // In a real implementation, these would need to be ordered correctly
-        for (int centerIdx : adjacentCenters) {
-            orderedVertices.push_back(faceCenters[centerIdx]);
+        // The two other vertices of each face around this vertex
+        std::array<std::array<int, 2>, Tile::MaxSides> others;
+        std::array<bool, Tile::MaxSides> used{};
+        const size_t count = std::min(ringSize, Tile::MaxSides);
+        for (size_t k = 0; k < count; k++) {
+            const auto& face = subdivisionFaces[vertexFaces[begin + k]];
+            int slot = 0;
+            for (int v : face) {
+                if (v != static_cast<int>(vertexIndex)) {
+                    others[k][slot++] = v;
+                }
+            }
         }
         
-        // Set the tile vertices
-        tile.SetVertices(orderedVertices);
+        std::array<glm::vec3, Tile::MaxSides> corners;
+        std::array<int, Tile::MaxSides> neighbors;
+        size_t current = 0;
+        used[0] = true;
+        corners[0] = faceCenters[vertexFaces[begin]];
+        int link = others[0][1];
+        neighbors[0] = link;
+        for (size_t step = 1; step < count; step++) {
+            // Next face shares the edge (vertexIndex, link) with the current one
+            for (size_t k = 0; k < count; k++) {
+                if (!used[k] && (others[k][0] == link || others[k][1] == link)) {
+                    current = k;
+                    break;
+                }
+            }
+            used[current] = true;
+            corners[step] = faceCenters[vertexFaces[begin + current]];
+            link = (others[current][0] == link) ? others[current][1] : others[current][0];
+            neighbors[step] = link;
+        }
         
-        // Add the tile to our collection
-        tiles.push_back(std::move(tile));
+        tile.SetVertices(std::span<const glm::vec3>(corners.data(), count));
+        tile.SetNeighbors(std::span<const int>(neighbors.data(), count));
+        tiles.push_back(tile);
         
         // Count pentagons
         if (isPentagon) pentagonCount++;
         
         // Report progress periodically
-        processedVertices++;
-        if (progressTracker && processedVertices % 200 == 0) {
-            float progress = static_cast<float>(processedVertices) / totalVertices;
-            std::string message = "Creating tiles (" + 
-                                 std::to_string(processedVertices) + " of " + 
-                                 std::to_string(totalVertices) + ")";
-            progressTracker->UpdateProgress(progress, message);
+        if (vertexIndex % 4096 == 0 && IsGenerationCancelled()) {
+            return;
+        }
+        if (progressTracker && vertexIndex % 10000 == 0) {
+            float progress = 0.3f + static_cast<float>(vertexIndex) / vertexCount * 0.7f;
+            progressTracker->UpdateProgress(progress, "Creating tiles ({current} of {total})", vertexIndex, vertexCount);
         }
     }
     
+    // The triangle mesh is not needed once the tiles exist
+    std::vector<glm::vec3>().swap(subdivisionVertices);
+    std::vector<std::array<int, 3>>().swap(subdivisionFaces);
+    
     // Debug check
     if (pentagonCount != 12) {
         std::cerr << "Warning: Expected 12 pentagons but got " << pentagonCount << std::endl;
     }
     
     if (progressTracker) {
-        progressTracker->UpdateProgress(1.0f, "Created " + std::to_string(tiles.size()) + " tiles");
-    }
-}
-
-void World::SetupTileNeighbors() {
-    // Build edge-to-tiles mapping during tile creation for O(E) complexity
-    std::unordered_map<uint64_t, std::vector<int>> edgeToTiles;
-    
-    // For each tile, register all its edges
-    for (size_t tileIdx = 0; tileIdx < tiles.size(); tileIdx++) {
-        const auto& tile = tiles[tileIdx];
-        const auto& vertices = tile.GetVertices();
-        
-        // For each edge in the tile (connecting consecutive vertices)
-        for (size_t i = 0; i < vertices.size(); i++) {
-            size_t nextIdx = (i + 1) % vertices.size();
-            
-            // Create edge key using vertex hashes (ensure consistent ordering)
-            size_t hash1 = std::hash<glm::vec3>{}(vertices[i]);
-            size_t hash2 = std::hash<glm::vec3>{}(vertices[nextIdx]);
-            uint64_t edgeKey = (hash1 < hash2) ? 
-                               ((static_cast<uint64_t>(hash1) << 32) | hash2) :
-                               ((static_cast<uint64_t>(hash2) << 32) | hash1);
-            
-            // Add this tile to the edge mapping
-            edgeToTiles[edgeKey].push_back(static_cast<int>(tileIdx));
-        }
-        
-        // Report progress periodically
-        if (progressTracker && tileIdx % 1000 == 0) {
-            float progress = static_cast<float>(tileIdx) / tiles.size() * 0.3f;
-            std::string message = "Building edge mapping (" + 
-                                 std::to_string(tileIdx) + " of " + 
-                                 std::to_string(tiles.size()) + ")";
-            progressTracker->UpdateProgress(progress, message);
-        }
-    }
-    
-    // Now establish neighborhood relationships using the edge mapping
-    for (size_t tileIdx = 0; tileIdx < tiles.size(); tileIdx++) {
-        auto& tile = tiles[tileIdx];
-        const auto& vertices = tile.GetVertices();
-        std::vector<int> neighbors;
-        
-        // For each edge in the tile, find tiles that share this edge
-        for (size_t i = 0; i < vertices.size(); i++) {
-            size_t nextIdx = (i + 1) % vertices.size();
-            
-            // Create the same edge key
-            size_t hash1 = std::hash<glm::vec3>{}(vertices[i]);
-            size_t hash2 = std::hash<glm::vec3>{}(vertices[nextIdx]);
-            uint64_t edgeKey = (hash1 < hash2) ? 
-                               ((static_cast<uint64_t>(hash1) << 32) | hash2) :
-                               ((static_cast<uint64_t>(hash2) << 32) | hash1);
-            
-            // Find all tiles sharing this edge
-            auto it = edgeToTiles.find(edgeKey);
-            if (it != edgeToTiles.end()) {
-                for (int otherTileIdx : it->second) {
-                    // Don't add ourselves as a neighbor
-                    if (otherTileIdx != static_cast<int>(tileIdx)) {
-                        neighbors.push_back(otherTileIdx);
-                    }
-                }
-            }
-        }
-        
-        // Remove duplicates (a tile might be added multiple times if sharing multiple edges)
-        std::sort(neighbors.begin(), neighbors.end());
-        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
-        
-        // Set the neighbors
-        tile.SetNeighbors(neighbors);
-        
-        // Report progress periodically
-        if (progressTracker && tileIdx % 1000 == 0) {
-            float progress = 0.3f + static_cast<float>(tileIdx) / tiles.size() * 0.7f;
-            std::string message = "Establishing tile connections (" + 
-                                 std::to_string(tileIdx) + " of " + 
-                                 std::to_string(tiles.size()) + ")";
-            progressTracker->UpdateProgress(progress, message);
-        }
-    }
-    
-    // Report completion
-    if (progressTracker) {
-        progressTracker->UpdateProgress(1.0f, "Completed neighborhood setup");
+        progressTracker->UpdateProgress(1.0f, "Created {total} tiles", tiles.size(), tiles.size());
     }
 }
 
@@ -485,33 +450,30 @@ void World::InitializeBaseTiles() {
     
     // Initialize all tiles with default values
     // Plate assignment will determine ocean vs land
-    for (size_t i = 0; i < tiles.size(); i++) {
-        // Set neutral elevation - plate system will determine actual values
-        tiles[i].SetElevation(0.5f);
-        
-        // Set default terrain type - will be updated by plate system
-        tiles[i].SetTerrainType(TerrainType::Lowland);
-        
-        // Set neutral moisture - can be updated later by climate system
-        tiles[i].SetMoisture(0.5f);
-        
-        // Temperature based on latitude (this can stay)
-        glm::vec3 pos = tiles[i].GetCenter();
-        float latitude = std::asin(pos.y);  // -π/2 to +π/2
-        float normalizedLatitude = latitude / (3.14159f / 2.0f);  // -1 to +1
-        float temperature = 0.8f - 0.6f * std::abs(normalizedLatitude);
-        temperature = glm::clamp(temperature, 0.0f, 1.0f);
-        tiles[i].SetTemperature(temperature);
-        
-        // Report progress periodically
-        if (progressTracker && i % 1000 == 0) {
-            float progress = static_cast<float>(i) / tiles.size();
-            std::string message = "Initializing tiles (" + 
-                                 std::to_string(i) + " of " + 
-                                 std::to_string(tiles.size()) + ")";
-            progressTracker->UpdateProgress(progress, message);
+    ThreadPool::GetInstance().ParallelFor(tiles.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Set neutral elevation - plate system will determine actual values
+            tiles[i].SetElevation(0.5f);
+            
+            // Set default terrain type - will be updated by plate system
+            tiles[i].SetTerrainType(TerrainType::Lowland);
+            
+            // Set neutral moisture - replaced by the climate phase
+            tiles[i].SetMoisture(0.5f);
+            
+            // Temperature based on latitude (refined by the climate phase)
+            glm::vec3 pos = tiles[i].GetCenter();
+            float latitude = std::asin(pos.y);  // -π/2 to +π/2
+            float normalizedLatitude = latitude / (3.14159f / 2.0f);  // -1 to +1
+            float temperature = 0.8f - 0.6f * std::abs(normalizedLatitude);
+            temperature = glm::clamp(temperature, 0.0f, 1.0f);
+            tiles[i].SetTemperature(temperature);
         }
-    }
+    }, [&](float fraction) {
+        if (progressTracker) {
+            progressTracker->UpdateProgress(fraction * 0.7f, "Initializing tiles...");
+        }
+    });
     
     // Report progress before smoothing starts
     if (progressTracker) {
@@ -528,64 +490,39 @@ void World::InitializeBaseTiles() {
 }
 
 void World::SmoothTerrainData() {
-    // Create a copy of the current terrain data
-    std::vector<float> oldElevations(tiles.size());
-    std::vector<float> oldMoistures(tiles.size());
-    std::vector<float> oldTemperatures(tiles.size());
-    
-    for (size_t i = 0; i < tiles.size(); i++) {
-        oldElevations[i] = tiles[i].GetElevation();
-        oldMoistures[i] = tiles[i].GetMoisture();
-        oldTemperatures[i] = tiles[i].GetTemperature();
-    }
-    
-    // Smooth the terrain data by averaging with neighbors
-    for (size_t i = 0; i < tiles.size(); i++) {
-        const auto& neighbors = tiles[i].GetNeighbors();
-        if (neighbors.empty()) continue;
-        
-        // Calculate average values considering neighbors
-        float sumElevation = oldElevations[i];
-        float sumMoisture = oldMoistures[i];
-        float sumTemperature = oldTemperatures[i];
-        int count = 1;  // start with 1 for the tile itself
-        
-        for (int neighborIdx : neighbors) {
-            if (neighborIdx >= 0 && neighborIdx < static_cast<int>(tiles.size())) {
-                sumElevation += oldElevations[neighborIdx];
-                sumMoisture += oldMoistures[neighborIdx];
-                sumTemperature += oldTemperatures[neighborIdx];
-                count++;
-            }
+    // Gather the terrain columns so the kernel works on flat arrays
+    std::vector<float> elevations(tiles.size());
+    std::vector<float> moistures(tiles.size());
+    std::vector<float> temperatures(tiles.size());
+    
+    ThreadPool& pool = ThreadPool::GetInstance();
+    pool.ParallelFor(tiles.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            elevations[i] = tiles[i].GetElevation();
+            moistures[i] = tiles[i].GetMoisture();
+            temperatures[i] = tiles[i].GetTemperature();
         }
-          // Apply the smoothed values
-        float smoothedElevation = sumElevation / count;
-        tiles[i].SetElevation(smoothedElevation);
-        tiles[i].SetMoisture(sumMoisture / count);
-        tiles[i].SetTemperature(sumTemperature / count);
-        
-        // Update terrain type based on smoothed elevation
-        const float waterLevel = 0.4f;
-        TerrainType terrainType;
-        if (smoothedElevation < waterLevel - 0.2f) {
-            terrainType = TerrainType::Ocean;
-        } else if (smoothedElevation < waterLevel - 0.05f) {
-            terrainType = TerrainType::Shallow;
-        } else if (smoothedElevation < waterLevel + 0.05f) {
-            terrainType = TerrainType::Beach;
-        } else if (smoothedElevation < waterLevel + 0.3f) {
-            terrainType = TerrainType::Lowland;
-        } else if (smoothedElevation < waterLevel + 0.6f) {
-            terrainType = TerrainType::Highland;
-        } else if (smoothedElevation < waterLevel + 0.8f) {
-            terrainType = TerrainType::Mountain;
-        } else {
-            terrainType = TerrainType::Peak;
+    });
+    
+    // Average each tile with its neighbors (the tile itself counts once)
+    TileAdjacency adjacency = TileAdjacency::Build(*this);
+    SmoothTileValues(adjacency, elevations);
+    SmoothTileValues(adjacency, moistures);
+    SmoothTileValues(adjacency, temperatures);
+    
+    const TerrainClassifier terrainClassifier(0.4f, kNormalizedTerrainBands);
+    pool.ParallelFor(tiles.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            // Apply the smoothed values
+            float smoothedElevation = elevations[i];
+            tiles[i].SetElevation(smoothedElevation);
+            tiles[i].SetMoisture(moistures[i]);
+            tiles[i].SetTemperature(temperatures[i]);
+            
+            // Update terrain type based on smoothed elevation
+            tiles[i].SetTerrainType(terrainClassifier.Classify(smoothedElevation));
         }
-        
-        // Set the terrain type
-        tiles[i].SetTerrainType(terrainType);
-    }
+    });
 }
 
 int World::FindTileContainingPoint(const glm::vec3& point, int previousTileIndex) const {
@@ -662,6 +599,47 @@ bool World::isPointInTile(const glm::vec3& point, int tileIndex) const {
     return true;  // This tile's center is closest, point belongs here
 }
 
+void World::ReorderTiles(const std::vector<int>& newOrder) {
+    if (newOrder.size() != tiles.size()) {
+        std::cerr << "ERROR: Tile order has " << newOrder.size() << " entries, expected " << tiles.size() << std::endl;
+        return;
+    }
+
+    std::vector<int> oldToNew(tiles.size());
+    for (size_t newIndex = 0; newIndex < newOrder.size(); ++newIndex) {
+        oldToNew[newOrder[newIndex]] = static_cast<int>(newIndex);
+    }
+
+    // Apply the permutation in place, one cycle at a time, so reordering a
+    // large world never holds two copies of the tiles
+    std::vector<bool> placed(tiles.size(), false);
+    for (size_t start = 0; start < tiles.size(); ++start) {
+        if (placed[start]) {
+            continue;
+        }
+        Tile carried = tiles[start];
+        size_t current = start;
+        while (static_cast<size_t>(newOrder[current]) != start) {
+            tiles[current] = tiles[newOrder[current]];
+            placed[current] = true;
+            current = newOrder[current];
+        }
+        tiles[current] = carried;
+        placed[current] = true;
+    }
+
+    for (auto& tile : tiles) {
+        tile.RemapNeighbors(oldToNew);
+    }
+
+    for (auto& plate : tectonicPlates) {
+        for (auto& tileId : plate.tileIds) {
+            tileId = oldToNew[tileId];
+        }
+        std::sort(plate.tileIds.begin(), plate.tileIds.end());
+    }
+}
+
 void World::SetPlates(const std::vector<Plate>& plates) {
     tectonicPlates = plates;
 }
@@ -6,6 +6,8 @@
 #include <glm/glm.hpp>
 #include <array>
 #include "Tile.h"
+#include "Hydrology.h"
+#include "TaskGraph.h"
 #include "../ProgressTracker.h"
 
 // Forward declaration for Plate struct
@@ -54,6 +56,13 @@ public:
      */
     const std::vector<Tile>& GetTiles() const { return tiles; }
 
+    /**
+     * @brief Get all tiles in the world for modification by generation phases.
+     * 
+     * @return std::vector<Tile>& The world's tiles.
+     */
+    std::vector<Tile>& GetTiles() { return tiles; }
+
     /**
      * @brief Get the number of tiles in the world.
      * 
@@ -123,6 +132,16 @@ public:
      */
     int FindTileContainingPoint(const glm::vec3& point, int previousTileIndex = -1) const;
 
+    /**
+     * @brief Reorder the tiles and remap every tile index that refers to them.
+     * 
+     * Neighbor lists and plate tile lists are rewritten so that the world stays
+     * consistent. Used to lay tiles out along a space-filling curve.
+     * 
+     * @param newOrder Element n is the old index of the tile that moves to index n
+     */
+    void ReorderTiles(const std::vector<int>& newOrder);
+
 private:
     /**
      * @brief Create the base icosahedron.
@@ -139,13 +158,11 @@ private:
 
     /**
      * @brief Convert the triangular mesh into a dual polyhedron of pentagons and hexagons.
+     * 
+     * Tile corners are ordered around each tile and neighbors are taken from the
+     * mesh edges. The triangle mesh is released afterwards.
      */
     void TrianglesToTiles();
-
-    /**
-     * @brief Setup the neighborhood relationships between tiles.
-     */
-    void SetupTileNeighbors();
     
     /**
      * @brief Initialize tiles with base values.
@@ -170,17 +187,7 @@ private:
      * @param distortionFactor Factor controlling the amount of distortion (0-1).
      * @return glm::vec3 The mid-point, projected onto the unit sphere.
      */
-    glm::vec3 GetMidPoint(const glm::vec3& v1, const glm::vec3& v2, float distortionFactor);
-
-    /**
-     * @brief Get or create a midpoint between two vertices.
-     * 
-     * @param v1 Index of first vertex.
-     * @param v2 Index of second vertex.
-     * @param distortionFactor Factor controlling the amount of distortion (0-1).
-     * @return int Index of the midpoint vertex.
-     */
-    int GetMidPointIndex(int v1, int v2, float distortionFactor);
+    glm::vec3 GetMidPoint(const glm::vec3& v1, const glm::vec3& v2, float distortionFactor) const;
 
     /**
      * @brief Apply random distortion to a point.
@@ -189,7 +196,7 @@ private:
      * @param magnitude The maximum magnitude of distortion.
      * @return glm::vec3 The distorted point.
      */
-    glm::vec3 ApplyDistortion(const glm::vec3& point, float magnitude);
+    glm::vec3 ApplyDistortion(const glm::vec3& point, float magnitude) const;
     
     /**
      * @brief Check if a point on the sphere belongs to a specific tile.
@@ -219,24 +226,56 @@ public:
      * @return const std::vector<Plate>& The plate data
      */
     const std::vector<Plate>& GetPlates() const { return tectonicPlates; }
+    
+    /**
+     * @brief Set the drainage computed by the hydrology phase
+     * 
+     * @param hydrology Flow directions, discharge and lakes for every tile
+     */
+    void SetHydrology(HydrologyData hydrology) { this->hydrology = std::move(hydrology); }
+    
+    /**
+     * @brief Get the drainage computed by the hydrology phase
+     * 
+     * @return const HydrologyData& Per-tile rivers and lakes (empty before the phase runs)
+     */
+    const HydrologyData& GetHydrology() const { return hydrology; }
+    
+    /**
+     * @brief Record how long each generation phase took to build this world
+     * 
+     * @param timings Per-phase timings of the pipeline run
+     */
+    void SetPhaseTimings(std::vector<PhaseTiming> timings) { phaseTimings = std::move(timings); }
+    
+    /**
+     * @brief Get how long each generation phase took to build this world
+     * 
+     * @return const std::vector<PhaseTiming>& Timings in pipeline order (empty if the world was not generated)
+     */
+    const std::vector<PhaseTiming>& GetPhaseTimings() const { return phaseTimings; }
 
     std::vector<Tile> tiles;                     ///< All tiles in the world
     std::vector<glm::vec3> icosahedronVertices;  ///< Original icosahedron vertices
     std::vector<std::array<int, 3>> icosahedronFaces; ///< Original icosahedron faces as index triplets
     
-    // Subdivision data structures
+    // Subdivision data structures (released once tiles have been built)
     std::vector<glm::vec3> subdivisionVertices;  ///< Vertices after subdivision
     std::vector<std::array<int, 3>> subdivisionFaces; ///< Faces after subdivision
-      // Cache of midpoints to avoid duplicates during subdivision
-    std::unordered_map<uint64_t, size_t> midPointCache;
     
     float radius;         ///< World radius
     size_t pentagonCount; ///< Count of pentagon tiles (should be 12)
-    uint64_t seed;        ///< Seed for random distortion
+    uint64_t seed;        ///< World generation seed
+    uint64_t distortionSeed; ///< Seed for random distortion
     std::shared_ptr<ProgressTracker> progressTracker; ///< Progress tracking
     
     // Tectonic plate data (populated by Generator pipeline)
     std::vector<Plate> tectonicPlates;
+    
+    // Rivers and lakes (populated by Generator pipeline)
+    HydrologyData hydrology;
+    
+    std::vector<PhaseTiming> phaseTimings; ///< Time spent in each generation phase
 };
 
 } // namespace Generators
@@ -0,0 +1,66 @@
+#include "WorldPreview.h"
+#include "World.h"
+#include "Plate.h"
+#include "Classification.h"
+#include "../Core/WorldGenParameters.h"
+
+namespace WorldGen {
+namespace Generators {
+
+namespace {
+
+std::shared_ptr<const std::vector<int>> CopyPlateIds(const std::vector<Tile>& tiles) {
+    auto plateIds = std::make_shared<std::vector<int>>(tiles.size());
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        (*plateIds)[i] = tiles[i].GetPlateId();
+    }
+    return plateIds;
+}
+
+void CopyElevations(const std::vector<Tile>& tiles, WorldPreview& preview) {
+    auto elevations = std::make_shared<std::vector<float>>(tiles.size());
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        (*elevations)[i] = tiles[i].GetElevation();
+    }
+
+    // Terrain types are only assigned by the biome phase, so classify the
+    // elevations the same way it will
+    auto terrainTypes = std::make_shared<std::vector<TerrainType>>(tiles.size());
+    TerrainClassifier classifier(PlanetParameters().physicalRadiusMeters, kMeterTerrainBands);
+    classifier.Classify(*elevations, *terrainTypes);
+
+    preview.elevations = std::move(elevations);
+    preview.terrainTypes = std::move(terrainTypes);
+}
+
+} // namespace
+
+std::shared_ptr<const WorldPreview> MakeGeometryPreview(const World& world) {
+    auto preview = std::make_shared<WorldPreview>();
+    preview->stage = WorldPreview::Stage::Geometry;
+    preview->radius = world.GetRadius();
+    preview->geometry = std::make_shared<const std::vector<Tile>>(world.GetTiles());
+    preview->plateIds = CopyPlateIds(world.GetTiles());
+    preview->plates = std::make_shared<const std::vector<Plate>>();
+    CopyElevations(world.GetTiles(), *preview);
+    return preview;
+}
+
+std::shared_ptr<const WorldPreview> MakePlatePreview(const WorldPreview& previous, const World& world,
+                                                     const std::vector<Plate>& plates) {
+    auto preview = std::make_shared<WorldPreview>(previous);
+    preview->stage = WorldPreview::Stage::Plates;
+    preview->plateIds = CopyPlateIds(world.GetTiles());
+    preview->plates = std::make_shared<const std::vector<Plate>>(plates);
+    return preview;
+}
+
+std::shared_ptr<const WorldPreview> MakeElevationPreview(const WorldPreview& previous, const World& world) {
+    auto preview = std::make_shared<WorldPreview>(previous);
+    preview->stage = WorldPreview::Stage::Elevation;
+    CopyElevations(world.GetTiles(), *preview);
+    return preview;
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Tile.h"
+#include "../Core/TerrainTypes.h"
+
+namespace WorldGen {
+namespace Generators {
+
+// Forward declarations
+class World;
+struct Plate;
+
+/**
+ * @brief Immutable snapshot of a world part way through generation
+ *
+ * Generator::CreateWorld publishes one after the geometry, plate and
+ * elevation phases so the globe can be shown while later phases still run.
+ * Every attribute is its own shared column and is never modified once
+ * published; a snapshot reuses the columns of the one before it that its
+ * phase did not change, so a consumer can compare column pointers to see
+ * what to refresh. Tile indices are final from the first snapshot on.
+ */
+struct WorldPreview {
+    enum class Stage : uint8_t {
+        Geometry,   ///< Tile shapes only; the other columns hold their initial values
+        Plates,     ///< Plate ids assigned
+        Elevation   ///< Continents and mountains raised (before erosion)
+    };
+
+    Stage stage = Stage::Geometry;
+    float radius = 1.0f;                                          ///< World radius
+    std::shared_ptr<const std::vector<Tile>> geometry;            ///< Tiles as of the geometry phase (centers, corners, neighbors)
+    std::shared_ptr<const std::vector<int>> plateIds;             ///< Plate per tile
+    std::shared_ptr<const std::vector<Plate>> plates;             ///< Plates (empty before Stage::Plates)
+    std::shared_ptr<const std::vector<float>> elevations;         ///< Elevation per tile in meters from the planet center
+    std::shared_ptr<const std::vector<TerrainType>> terrainTypes; ///< Terrain per tile, classified from the elevation
+};
+
+/**
+ * @brief Receives each snapshot; called on a generation thread
+ */
+using WorldPreviewCallback = std::function<void(std::shared_ptr<const WorldPreview>)>;
+
+/**
+ * @brief Snapshot the geometry (and the initial attributes) of a world
+ *
+ * Copies the tiles, so only call it when a second copy fits in memory.
+ */
+std::shared_ptr<const WorldPreview> MakeGeometryPreview(const World& world);
+
+/**
+ * @brief Snapshot the plate assignment, sharing the other columns with the previous snapshot
+ */
+std::shared_ptr<const WorldPreview> MakePlatePreview(const WorldPreview& previous, const World& world,
+                                                     const std::vector<Plate>& plates);
+
+/**
+ * @brief Snapshot the elevations, sharing the other columns with the previous snapshot
+ */
+std::shared_ptr<const WorldPreview> MakeElevationPreview(const WorldPreview& previous, const World& world);
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,678 @@
+#include "WorldSnapshot.h"
+#include "World.h"
+#include "Tile.h"
+#include "Plate.h"
+#include "../Core/WorldGenParameters.h"
+#include "../ProgressTracker.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace WorldGen {
+namespace Generators {
+
+static_assert(std::endian::native == std::endian::little,
+              "World snapshots are little-endian and mapped in place; big-endian hosts need a byte-swapping loader");
+
+namespace {
+
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ull;
+constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+
+constexpr size_t kSectionCount = static_cast<size_t>(WorldSnapshotSection::Count);
+
+size_t AlignUp(size_t value) {
+    return (value + kWorldSnapshotAlignment - 1) & ~(kWorldSnapshotAlignment - 1);
+}
+
+/**
+ * @brief Incremental form of ComputeSnapshotChecksum for streamed writes
+ */
+class SnapshotChecksum {
+public:
+    void Update(const uint8_t* bytes, size_t size) {
+        // Complete a word left over from the previous update
+        while (pendingSize > 0 && pendingSize < 8 && size > 0) {
+            pending[pendingSize++] = *bytes++;
+            size--;
+        }
+        if (pendingSize == 8) {
+            MixWord(pending.data());
+            pendingSize = 0;
+        }
+
+        while (size >= 8) {
+            MixWord(bytes);
+            bytes += 8;
+            size -= 8;
+        }
+
+        while (size > 0) {
+            pending[pendingSize++] = *bytes++;
+            size--;
+        }
+    }
+
+    uint64_t Finish() const {
+        uint64_t result = hash;
+        for (size_t i = 0; i < pendingSize; ++i) {
+            result ^= pending[i];
+            result *= kFnvPrime;
+        }
+        return result;
+    }
+
+private:
+    void MixWord(const uint8_t* bytes) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        hash ^= word;
+        hash *= kFnvPrime;
+    }
+
+    uint64_t hash = kFnvOffsetBasis;
+    std::array<uint8_t, 8> pending{};
+    size_t pendingSize = 0;
+};
+
+/**
+ * @brief Sequential snapshot writer that tracks position and checksum
+ */
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::ofstream& out) : out(out) {}
+
+    void Write(const void* bytes, size_t size) {
+        out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        checksum.Update(static_cast<const uint8_t*>(bytes), size);
+        position += size;
+    }
+
+    template <typename T>
+    void WriteSection(const std::vector<T>& values) {
+        if (!values.empty()) {
+            Write(values.data(), values.size() * sizeof(T));
+        }
+        Pad();
+    }
+
+    void Pad() {
+        static const uint8_t zeros[kWorldSnapshotAlignment] = {};
+        size_t padding = AlignUp(position) - position;
+        if (padding > 0) {
+            Write(zeros, padding);
+        }
+    }
+
+    size_t Position() const { return position; }
+    uint64_t Checksum() const { return checksum.Finish(); }
+
+private:
+    std::ofstream& out;
+    SnapshotChecksum checksum;
+    size_t position = sizeof(WorldSnapshotHeader);
+};
+
+/**
+ * @brief Size in bytes of a section given the counts in the header
+ */
+size_t SectionSize(WorldSnapshotSection section, const WorldSnapshotHeader& header) {
+    const size_t tiles = header.tileCount;
+    switch (section) {
+        case WorldSnapshotSection::Centers:         return tiles * sizeof(glm::vec3);
+        case WorldSnapshotSection::Shapes:          return tiles * sizeof(uint8_t);
+        case WorldSnapshotSection::Elevations:      return tiles * sizeof(float);
+        case WorldSnapshotSection::Moistures:       return tiles * sizeof(float);
+        case WorldSnapshotSection::Temperatures:    return tiles * sizeof(float);
+        case WorldSnapshotSection::TerrainTypes:    return tiles * sizeof(uint8_t);
+        case WorldSnapshotSection::BiomeTypes:      return tiles * sizeof(uint8_t);
+        case WorldSnapshotSection::PlateIds:        return tiles * sizeof(int32_t);
+        case WorldSnapshotSection::NeighborOffsets: return (tiles + 1) * sizeof(uint32_t);
+        case WorldSnapshotSection::Neighbors:       return header.neighborCount * sizeof(int32_t);
+        case WorldSnapshotSection::VertexOffsets:   return (tiles + 1) * sizeof(uint32_t);
+        case WorldSnapshotSection::Vertices:        return header.vertexCount * sizeof(glm::vec3);
+        case WorldSnapshotSection::Plates:          return header.plateCount * sizeof(WorldSnapshotPlate);
+        case WorldSnapshotSection::PlateTileIds:    return header.plateTileCount * sizeof(int32_t);
+        case WorldSnapshotSection::FlowDirections:  return header.hydrologyTileCount * sizeof(int32_t);
+        case WorldSnapshotSection::Discharges:      return header.hydrologyTileCount * sizeof(float);
+        case WorldSnapshotSection::LakeIds:         return header.hydrologyTileCount * sizeof(int32_t);
+        case WorldSnapshotSection::WaterSurfaces:   return header.hydrologyTileCount * sizeof(float);
+        case WorldSnapshotSection::Count:           break;
+    }
+    return 0;
+}
+
+WorldSnapshotParameters ToSnapshotParameters(const PlanetParameters& params) {
+    WorldSnapshotParameters stored{};
+    stored.planetAge = params.planetAge;
+    stored.starAge = params.starAge;
+    stored.radius = params.radius;
+    stored.physicalRadiusMeters = params.physicalRadiusMeters;
+    stored.mass = params.mass;
+    stored.rotationRate = params.rotationRate;
+    stored.waterAmount = params.waterAmount;
+    stored.atmosphereDensity = params.atmosphereDensity;
+    stored.starMass = params.starMass;
+    stored.starRadius = params.starRadius;
+    stored.starTemperature = params.starTemperature;
+    stored.semiMajorAxis = params.semiMajorAxis;
+    stored.eccentricity = params.eccentricity;
+    stored.numTectonicPlates = params.numTectonicPlates;
+    stored.resolution = params.resolution;
+    stored.distortionFactor = params.distortionFactor;
+    stored.distortionSeed = params.distortionSeed;
+    stored.peakMemoryTargetMB = params.peakMemoryTargetMB;
+    return stored;
+}
+
+/**
+ * @brief Map a whole file read-only
+ *
+ * @return Pointer to the mapping, or nullptr on failure
+ */
+const uint8_t* MapFile(const std::string& path, size_t& size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return nullptr;
+    }
+
+    // The view keeps the mapping alive after its handle is closed
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        return nullptr;
+    }
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+    return static_cast<const uint8_t*>(view);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        return nullptr;
+    }
+
+    size = static_cast<size_t>(fileInfo.st_size);
+    return static_cast<const uint8_t*>(view);
+#endif
+}
+
+void UnmapFile(const uint8_t* data, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<uint8_t*>(data), size);
+#endif
+}
+
+/**
+ * @brief Check that the header and section table describe a well-formed file
+ */
+bool ValidateHeader(const WorldSnapshotHeader& header, size_t fileSize, const std::string& path) {
+    if (std::memcmp(header.magic, kWorldSnapshotMagic, sizeof(kWorldSnapshotMagic)) != 0) {
+        std::cerr << "ERROR: " << path << " is not a world snapshot" << std::endl;
+        return false;
+    }
+    if (header.version != kWorldSnapshotVersion) {
+        std::cerr << "ERROR: World snapshot " << path << " has version " << header.version << ", expected "
+                  << kWorldSnapshotVersion << std::endl;
+        return false;
+    }
+    if (header.headerSize != sizeof(WorldSnapshotHeader) || header.fileSize != fileSize) {
+        std::cerr << "ERROR: World snapshot " << path << " is truncated or has a mismatched header" << std::endl;
+        return false;
+    }
+    if (header.hydrologyTileCount != 0 && header.hydrologyTileCount != header.tileCount) {
+        std::cerr << "ERROR: World snapshot " << path << " has hydrology for " << header.hydrologyTileCount
+                  << " tiles, expected " << header.tileCount << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < kSectionCount; ++i) {
+        const uint64_t offset = header.sectionOffsets[i];
+        const size_t bytes = SectionSize(static_cast<WorldSnapshotSection>(i), header);
+        if (offset % kWorldSnapshotAlignment != 0 || offset < sizeof(WorldSnapshotHeader) || offset > fileSize ||
+            bytes > fileSize - offset) {
+            std::cerr << "ERROR: World snapshot " << path << " has an invalid section table" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check that CSR row offsets start at 0, never decrease and end at the entry count
+ */
+bool ValidateRowOffsets(std::span<const uint32_t> offsets, uint32_t entryCount) {
+    if (offsets.front() != 0 || offsets.back() != entryCount) {
+        return false;
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check that every index lies in [lowest, end)
+ */
+bool ValidateIndices(std::span<const int32_t> indices, int64_t lowest, int64_t end) {
+    return std::all_of(indices.begin(), indices.end(),
+                       [=](int32_t index) { return index >= lowest && index < end; });
+}
+
+} // namespace
+
+uint64_t ComputeSnapshotChecksum(const void* data, size_t size) {
+    SnapshotChecksum checksum;
+    checksum.Update(static_cast<const uint8_t*>(data), size);
+    return checksum.Finish();
+}
+
+bool SaveWorldSnapshot(const World& world, const PlanetParameters& params, const std::string& path) {
+    const auto& tiles = world.GetTiles();
+    const auto& plates = world.GetPlates();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "ERROR: Could not open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    WorldSnapshotHeader header{};
+    std::memcpy(header.magic, kWorldSnapshotMagic, sizeof(kWorldSnapshotMagic));
+    header.version = kWorldSnapshotVersion;
+    header.headerSize = sizeof(WorldSnapshotHeader);
+    header.seed = world.seed;
+    header.tileCount = static_cast<uint32_t>(tiles.size());
+    header.pentagonCount = static_cast<uint32_t>(world.GetPentagonCount());
+    header.plateCount = static_cast<uint32_t>(plates.size());
+    header.radius = world.GetRadius();
+    header.parameters = ToSnapshotParameters(params);
+
+    // Reserve space for the header; it is rewritten once offsets and checksum are known
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    SnapshotWriter writer(out);
+    auto beginSection = [&](WorldSnapshotSection section) {
+        header.sectionOffsets[static_cast<size_t>(section)] = writer.Position();
+    };
+
+    // Per-tile columns
+    {
+        std::vector<glm::vec3> centers;
+        centers.reserve(tiles.size());
+        for (const auto& tile : tiles) {
+            centers.push_back(tile.GetCenter());
+        }
+        beginSection(WorldSnapshotSection::Centers);
+        writer.WriteSection(centers);
+    }
+    {
+        std::vector<uint8_t> shapes;
+        shapes.reserve(tiles.size());
+        for (const auto& tile : tiles) {
+            shapes.push_back(static_cast<uint8_t>(tile.GetShape()));
+        }
+        beginSection(WorldSnapshotSection::Shapes);
+        writer.WriteSection(shapes);
+    }
+    {
+        std::vector<float> column(tiles.size());
+        std::transform(tiles.begin(), tiles.end(), column.begin(), [](const Tile& tile) { return tile.GetElevation(); });
+        beginSection(WorldSnapshotSection::Elevations);
+        writer.WriteSection(column);
+
+        std::transform(tiles.begin(), tiles.end(), column.begin(), [](const Tile& tile) { return tile.GetMoisture(); });
+        beginSection(WorldSnapshotSection::Moistures);
+        writer.WriteSection(column);
+
+        std::transform(tiles.begin(), tiles.end(), column.begin(), [](const Tile& tile) { return tile.GetTemperature(); });
+        beginSection(WorldSnapshotSection::Temperatures);
+        writer.WriteSection(column);
+    }
+    {
+        std::vector<uint8_t> column(tiles.size());
+        std::transform(tiles.begin(), tiles.end(), column.begin(),
+                       [](const Tile& tile) { return static_cast<uint8_t>(tile.GetTerrainType()); });
+        beginSection(WorldSnapshotSection::TerrainTypes);
+        writer.WriteSection(column);
+
+        std::transform(tiles.begin(), tiles.end(), column.begin(),
+                       [](const Tile& tile) { return static_cast<uint8_t>(tile.GetBiomeType()); });
+        beginSection(WorldSnapshotSection::BiomeTypes);
+        writer.WriteSection(column);
+    }
+    {
+        std::vector<int32_t> plateIds(tiles.size());
+        std::transform(tiles.begin(), tiles.end(), plateIds.begin(), [](const Tile& tile) { return tile.GetPlateId(); });
+        beginSection(WorldSnapshotSection::PlateIds);
+        writer.WriteSection(plateIds);
+    }
+
+    // CSR topology
+    {
+        std::vector<uint32_t> offsets;
+        std::vector<int32_t> neighbors;
+        offsets.reserve(tiles.size() + 1);
+        offsets.push_back(0);
+        for (const auto& tile : tiles) {
+            neighbors.insert(neighbors.end(), tile.GetNeighbors().begin(), tile.GetNeighbors().end());
+            offsets.push_back(static_cast<uint32_t>(neighbors.size()));
+        }
+        header.neighborCount = static_cast<uint32_t>(neighbors.size());
+        beginSection(WorldSnapshotSection::NeighborOffsets);
+        writer.WriteSection(offsets);
+        beginSection(WorldSnapshotSection::Neighbors);
+        writer.WriteSection(neighbors);
+    }
+    {
+        std::vector<uint32_t> offsets;
+        std::vector<glm::vec3> vertices;
+        offsets.reserve(tiles.size() + 1);
+        offsets.push_back(0);
+        for (const auto& tile : tiles) {
+            vertices.insert(vertices.end(), tile.GetVertices().begin(), tile.GetVertices().end());
+            offsets.push_back(static_cast<uint32_t>(vertices.size()));
+        }
+        header.vertexCount = static_cast<uint32_t>(vertices.size());
+        beginSection(WorldSnapshotSection::VertexOffsets);
+        writer.WriteSection(offsets);
+        beginSection(WorldSnapshotSection::Vertices);
+        writer.WriteSection(vertices);
+    }
+
+    // Plates
+    {
+        std::vector<WorldSnapshotPlate> storedPlates;
+        std::vector<int32_t> plateTileIds;
+        storedPlates.reserve(plates.size());
+        for (const auto& plate : plates) {
+            WorldSnapshotPlate stored{};
+            stored.id = plate.id;
+            stored.center[0] = plate.center.x;
+            stored.center[1] = plate.center.y;
+            stored.center[2] = plate.center.z;
+            stored.movement[0] = plate.movement.x;
+            stored.movement[1] = plate.movement.y;
+            stored.movement[2] = plate.movement.z;
+            stored.rotationRate = plate.rotationRate;
+            stored.isOceanic = plate.isOceanic ? 1 : 0;
+            stored.size = static_cast<uint8_t>(plate.size);
+            stored.firstTile = static_cast<uint32_t>(plateTileIds.size());
+            stored.tileCount = static_cast<uint32_t>(plate.tileIds.size());
+            plateTileIds.insert(plateTileIds.end(), plate.tileIds.begin(), plate.tileIds.end());
+            storedPlates.push_back(stored);
+        }
+        header.plateTileCount = static_cast<uint32_t>(plateTileIds.size());
+        beginSection(WorldSnapshotSection::Plates);
+        writer.WriteSection(storedPlates);
+        beginSection(WorldSnapshotSection::PlateTileIds);
+        writer.WriteSection(plateTileIds);
+    }
+
+    // Hydrology (empty sections for a world generated without it)
+    {
+        const HydrologyData& hydrology = world.GetHydrology();
+        header.hydrologyTileCount = static_cast<uint32_t>(hydrology.flowDirection.size());
+        header.lakeCount = hydrology.lakeCount;
+        beginSection(WorldSnapshotSection::FlowDirections);
+        writer.WriteSection(hydrology.flowDirection);
+        beginSection(WorldSnapshotSection::Discharges);
+        writer.WriteSection(hydrology.discharge);
+        beginSection(WorldSnapshotSection::LakeIds);
+        writer.WriteSection(hydrology.lakeId);
+        beginSection(WorldSnapshotSection::WaterSurfaces);
+        writer.WriteSection(hydrology.waterSurface);
+    }
+
+    header.fileSize = writer.Position();
+    header.checksum = writer.Checksum();
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+
+    if (!out) {
+        std::cerr << "ERROR: Failed to write world snapshot " << path << std::endl;
+        return false;
+    }
+
+    std::cout << "Saved world snapshot " << path << " (" << header.tileCount << " tiles, " << header.fileSize
+              << " bytes)" << std::endl;
+    return true;
+}
+
+std::unique_ptr<MappedWorldSnapshot> MappedWorldSnapshot::Open(const std::string& path, bool verifyChecksum) {
+    size_t size = 0;
+    const uint8_t* data = MapFile(path, size);
+    if (!data) {
+        std::cerr << "ERROR: Could not map world snapshot " << path << std::endl;
+        return nullptr;
+    }
+
+    // Own the mapping from here on so every early return unmaps it
+    std::unique_ptr<MappedWorldSnapshot> snapshot(new MappedWorldSnapshot(data, size));
+
+    if (size < sizeof(WorldSnapshotHeader) || !ValidateHeader(snapshot->GetHeader(), size, path)) {
+        return nullptr;
+    }
+
+    // Every index the accessors and CreateWorldFromSnapshot follow is checked
+    // here, with or without the checksum, so a damaged file is rejected
+    // instead of read out of bounds
+    const WorldSnapshotHeader& header = snapshot->GetHeader();
+    const int64_t tileCount = header.tileCount;
+    auto neighborOffsets = snapshot->Column<uint32_t>(WorldSnapshotSection::NeighborOffsets, header.tileCount + 1);
+    auto vertexOffsets = snapshot->Column<uint32_t>(WorldSnapshotSection::VertexOffsets, header.tileCount + 1);
+    if (!ValidateRowOffsets(neighborOffsets, header.neighborCount) ||
+        !ValidateRowOffsets(vertexOffsets, header.vertexCount)) {
+        std::cerr << "ERROR: World snapshot " << path << " has inconsistent topology offsets" << std::endl;
+        return nullptr;
+    }
+    if (!ValidateIndices(snapshot->Column<int32_t>(WorldSnapshotSection::Neighbors, header.neighborCount), 0, tileCount)) {
+        std::cerr << "ERROR: World snapshot " << path << " has neighbor indices outside its tiles" << std::endl;
+        return nullptr;
+    }
+    for (const auto& plate : snapshot->GetPlates()) {
+        if (plate.firstTile > header.plateTileCount || plate.tileCount > header.plateTileCount - plate.firstTile) {
+            std::cerr << "ERROR: World snapshot " << path << " has inconsistent plate tile ranges" << std::endl;
+            return nullptr;
+        }
+    }
+    // Tiles without a plate keep -1
+    if (!ValidateIndices(snapshot->GetPlateIds(), -1, header.plateCount) ||
+        !ValidateIndices(snapshot->Column<int32_t>(WorldSnapshotSection::PlateTileIds, header.plateTileCount), 0, tileCount)) {
+        std::cerr << "ERROR: World snapshot " << path << " has plate indices out of range" << std::endl;
+        return nullptr;
+    }
+    if (snapshot->HasHydrology() &&
+        (header.lakeCount < 0 || !ValidateIndices(snapshot->GetFlowDirections(), -1, tileCount) ||
+         !ValidateIndices(snapshot->GetLakeIds(), -1, header.lakeCount))) {
+        std::cerr << "ERROR: World snapshot " << path << " has hydrology indices out of range" << std::endl;
+        return nullptr;
+    }
+
+    if (verifyChecksum) {
+        uint64_t checksum = ComputeSnapshotChecksum(data + sizeof(WorldSnapshotHeader), size - sizeof(WorldSnapshotHeader));
+        if (checksum != header.checksum) {
+            std::cerr << "ERROR: World snapshot " << path << " failed checksum verification" << std::endl;
+            return nullptr;
+        }
+    }
+
+    return snapshot;
+}
+
+MappedWorldSnapshot::~MappedWorldSnapshot() {
+    UnmapFile(data, size);
+}
+
+PlanetParameters MappedWorldSnapshot::GetParameters() const {
+    const WorldSnapshotParameters& stored = GetHeader().parameters;
+    PlanetParameters params;
+    params.radius = stored.radius;
+    params.physicalRadiusMeters = stored.physicalRadiusMeters;
+    params.mass = stored.mass;
+    params.rotationRate = stored.rotationRate;
+    params.numTectonicPlates = stored.numTectonicPlates;
+    params.waterAmount = stored.waterAmount;
+    params.atmosphereDensity = stored.atmosphereDensity;
+    params.planetAge = stored.planetAge;
+    params.starMass = stored.starMass;
+    params.starRadius = stored.starRadius;
+    params.starTemperature = stored.starTemperature;
+    params.starAge = stored.starAge;
+    params.semiMajorAxis = stored.semiMajorAxis;
+    params.eccentricity = stored.eccentricity;
+    params.resolution = stored.resolution;
+    params.distortionFactor = stored.distortionFactor;
+    params.distortionSeed = stored.distortionSeed;
+    params.peakMemoryTargetMB = stored.peakMemoryTargetMB;
+    return params;
+}
+
+std::span<const int32_t> MappedWorldSnapshot::GetNeighbors(size_t tileIndex) const {
+    auto offsets = Column<uint32_t>(WorldSnapshotSection::NeighborOffsets, GetTileCount() + 1);
+    auto neighbors = Column<int32_t>(WorldSnapshotSection::Neighbors, GetHeader().neighborCount);
+    return neighbors.subspan(offsets[tileIndex], offsets[tileIndex + 1] - offsets[tileIndex]);
+}
+
+std::span<const glm::vec3> MappedWorldSnapshot::GetVertices(size_t tileIndex) const {
+    auto offsets = Column<uint32_t>(WorldSnapshotSection::VertexOffsets, GetTileCount() + 1);
+    auto vertices = Column<glm::vec3>(WorldSnapshotSection::Vertices, GetHeader().vertexCount);
+    return vertices.subspan(offsets[tileIndex], offsets[tileIndex + 1] - offsets[tileIndex]);
+}
+
+std::span<const int32_t> MappedWorldSnapshot::GetPlateTiles(size_t plateIndex) const {
+    const WorldSnapshotPlate& plate = GetPlates()[plateIndex];
+    auto tileIds = Column<int32_t>(WorldSnapshotSection::PlateTileIds, GetHeader().plateTileCount);
+    return tileIds.subspan(plate.firstTile, plate.tileCount);
+}
+
+std::unique_ptr<World> CreateWorldFromSnapshot(const MappedWorldSnapshot& snapshot,
+                                               std::shared_ptr<ProgressTracker> progressTracker) {
+    const WorldSnapshotHeader& header = snapshot.GetHeader();
+    auto world = std::make_unique<World>(snapshot.GetParameters(), header.seed, progressTracker);
+    world->SetRadius(header.radius);
+    world->pentagonCount = header.pentagonCount;
+
+    auto centers = snapshot.GetCenters();
+    auto shapes = snapshot.GetShapes();
+    auto elevations = snapshot.GetElevations();
+    auto moistures = snapshot.GetMoistures();
+    auto temperatures = snapshot.GetTemperatures();
+    auto terrainTypes = snapshot.GetTerrainTypes();
+    auto biomeTypes = snapshot.GetBiomeTypes();
+    auto plateIds = snapshot.GetPlateIds();
+
+    world->tiles.clear();
+    world->tiles.reserve(header.tileCount);
+    for (size_t i = 0; i < header.tileCount; ++i) {
+        Tile tile = Tile::FromNormalized(centers[i], static_cast<Tile::TileShape>(shapes[i]), snapshot.GetVertices(i));
+
+        tile.SetNeighbors(snapshot.GetNeighbors(i));
+
+        tile.SetElevation(elevations[i]);
+        tile.SetMoisture(moistures[i]);
+        tile.SetTemperature(temperatures[i]);
+        tile.SetTerrainType(static_cast<TerrainType>(terrainTypes[i]));
+        tile.SetBiomeType(static_cast<BiomeType>(biomeTypes[i]));
+        tile.SetPlateId(plateIds[i]);
+
+        world->tiles.push_back(std::move(tile));
+
+        if (progressTracker && i % 10000 == 0) {
+            progressTracker->UpdateProgress(static_cast<float>(i) / header.tileCount, "Loading world snapshot...");
+        }
+    }
+
+    std::vector<Plate> plates;
+    auto storedPlates = snapshot.GetPlates();
+    plates.reserve(storedPlates.size());
+    for (size_t i = 0; i < storedPlates.size(); ++i) {
+        const WorldSnapshotPlate& stored = storedPlates[i];
+        Plate plate;
+        plate.id = stored.id;
+        plate.center = glm::vec3(stored.center[0], stored.center[1], stored.center[2]);
+        plate.movement = glm::vec3(stored.movement[0], stored.movement[1], stored.movement[2]);
+        plate.rotationRate = stored.rotationRate;
+        plate.isOceanic = stored.isOceanic != 0;
+        plate.size = static_cast<PlateSize>(stored.size);
+        auto tileIds = snapshot.GetPlateTiles(i);
+        plate.tileIds.assign(tileIds.begin(), tileIds.end());
+        plates.push_back(std::move(plate));
+    }
+    world->SetPlates(plates);
+
+    if (snapshot.HasHydrology()) {
+        HydrologyData hydrology;
+        auto flowDirections = snapshot.GetFlowDirections();
+        auto discharges = snapshot.GetDischarges();
+        auto lakeIds = snapshot.GetLakeIds();
+        auto waterSurfaces = snapshot.GetWaterSurfaces();
+        hydrology.flowDirection.assign(flowDirections.begin(), flowDirections.end());
+        hydrology.discharge.assign(discharges.begin(), discharges.end());
+        hydrology.lakeId.assign(lakeIds.begin(), lakeIds.end());
+        hydrology.waterSurface.assign(waterSurfaces.begin(), waterSurfaces.end());
+        hydrology.lakeCount = header.lakeCount;
+        world->SetHydrology(std::move(hydrology));
+    }
+
+    if (progressTracker) {
+        progressTracker->UpdateProgress(1.0f, "World snapshot loaded");
+    }
+
+    return world;
+}
+
+} // namespace Generators
+} // namespace WorldGen
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <glm/glm.hpp>
+
+namespace WorldGen {
+
+// Forward declarations
+class ProgressTracker;
+struct PlanetParameters;
+
+namespace Generators {
+
+// Forward declaration
+class World;
+
+/**
+ * @brief Binary world snapshot format
+ *
+ * A snapshot is a single little-endian file that can be memory-mapped and read
+ * in place. It starts with a WorldSnapshotHeader followed by a series of
+ * sections, each aligned to kWorldSnapshotAlignment bytes:
+ *
+ *   Centers          glm::vec3[tileCount]
+ *   Shapes           uint8[tileCount]      (Tile::TileShape)
+ *   Elevations       float[tileCount]
+ *   Moistures        float[tileCount]
+ *   Temperatures     float[tileCount]
+ *   TerrainTypes     uint8[tileCount]      (TerrainType)
+ *   BiomeTypes       uint8[tileCount]      (BiomeType)
+ *   PlateIds         int32[tileCount]
+ *   NeighborOffsets  uint32[tileCount + 1] (CSR row offsets into Neighbors)
+ *   Neighbors        int32[neighborCount]
+ *   VertexOffsets    uint32[tileCount + 1] (CSR row offsets into Vertices)
+ *   Vertices         glm::vec3[vertexCount]
+ *   Plates           WorldSnapshotPlate[plateCount]
+ *   PlateTileIds     int32[plateTileCount]
+ *   FlowDirections   int32[hydrologyTileCount] (HydrologyData, absent if hydrologyTileCount is 0)
+ *   Discharges       float[hydrologyTileCount]
+ *   LakeIds          int32[hydrologyTileCount]
+ *   WaterSurfaces    float[hydrologyTileCount]
+ *
+ * The checksum covers every byte after the header. Bump kWorldSnapshotVersion
+ * whenever the layout of the header or any section changes.
+ */
+constexpr char kWorldSnapshotMagic[8] = {'C', 'S', 'W', 'O', 'R', 'L', 'D', '\0'};
+constexpr uint32_t kWorldSnapshotVersion = 3;
+constexpr size_t kWorldSnapshotAlignment = 16;
+
+/**
+ * @brief Sections stored in a world snapshot, in file order
+ */
+enum class WorldSnapshotSection : uint32_t {
+    Centers,
+    Shapes,
+    Elevations,
+    Moistures,
+    Temperatures,
+    TerrainTypes,
+    BiomeTypes,
+    PlateIds,
+    NeighborOffsets,
+    Neighbors,
+    VertexOffsets,
+    Vertices,
+    Plates,
+    PlateTileIds,
+    FlowDirections,
+    Discharges,
+    LakeIds,
+    WaterSurfaces,
+    Count
+};
+
+/**
+ * @brief Fixed-layout copy of PlanetParameters stored in a snapshot
+ */
+struct WorldSnapshotParameters {
+    uint64_t planetAge;
+    uint64_t starAge;
+    float radius;
+    float physicalRadiusMeters;
+    float mass;
+    float rotationRate;
+    float waterAmount;
+    float atmosphereDensity;
+    float starMass;
+    float starRadius;
+    float starTemperature;
+    float semiMajorAxis;
+    float eccentricity;
+    int32_t numTectonicPlates;
+    int32_t resolution;
+    float distortionFactor;
+    int32_t peakMemoryTargetMB;
+    uint32_t reserved;
+    uint64_t distortionSeed;
+};
+
+/**
+ * @brief Fixed-layout plate record stored in a snapshot
+ *
+ * The plate's tiles are PlateTileIds[firstTile, firstTile + tileCount).
+ */
+struct WorldSnapshotPlate {
+    int32_t id;
+    float center[3];
+    float movement[3];
+    float rotationRate;
+    uint8_t isOceanic;
+    uint8_t size;         // PlateSize
+    uint16_t reserved0;
+    uint32_t firstTile;
+    uint32_t tileCount;
+    uint32_t reserved1;
+};
+
+/**
+ * @brief Header at the start of every world snapshot
+ */
+struct WorldSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t fileSize;
+    uint64_t checksum;        // Checksum of every byte after the header
+    uint64_t seed;
+    uint32_t tileCount;
+    uint32_t pentagonCount;
+    uint32_t neighborCount;   // Total entries in the Neighbors section
+    uint32_t vertexCount;     // Total entries in the Vertices section
+    uint32_t plateCount;
+    uint32_t plateTileCount;  // Total entries in the PlateTileIds section
+    float radius;
+    uint32_t hydrologyTileCount; // tileCount, or 0 for a world without hydrology
+    WorldSnapshotParameters parameters;
+    uint64_t sectionOffsets[static_cast<size_t>(WorldSnapshotSection::Count)];
+    int32_t lakeCount;
+    uint32_t reserved[3];     // Keeps the first section aligned
+};
+
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "Snapshot vertex sections assume tightly packed glm::vec3");
+static_assert(sizeof(WorldSnapshotParameters) == 88, "WorldSnapshotParameters layout changed; bump kWorldSnapshotVersion");
+static_assert(sizeof(WorldSnapshotPlate) == 48, "WorldSnapshotPlate layout changed; bump kWorldSnapshotVersion");
+static_assert(sizeof(WorldSnapshotHeader) == 320, "WorldSnapshotHeader layout changed; bump kWorldSnapshotVersion");
+static_assert(sizeof(WorldSnapshotHeader) % kWorldSnapshotAlignment == 0, "The first section must start aligned");
+
+/**
+ * @brief Compute the checksum used by world snapshots
+ *
+ * 64-bit FNV-1a applied to 8-byte little-endian words (trailing bytes are
+ * folded in one at a time), which keeps verification of large worlds cheap.
+ *
+ * @param data Bytes to checksum
+ * @param size Number of bytes
+ * @return uint64_t The checksum
+ */
+uint64_t ComputeSnapshotChecksum(const void* data, size_t size);
+
+/**
+ * @brief Write a generated world to a binary snapshot file
+ *
+ * @param world The world to save
+ * @param params The parameters the world was generated with
+ * @param path Destination file path (overwritten if it exists)
+ * @return true if the snapshot was written successfully
+ */
+bool SaveWorldSnapshot(const World& world, const PlanetParameters& params, const std::string& path);
+
+/**
+ * @brief Read-only view of a memory-mapped world snapshot
+ *
+ * Opening a snapshot validates the header, section bounds and (optionally)
+ * the checksum; all accessors then point straight into the mapped file.
+ */
+class MappedWorldSnapshot {
+public:
+    /**
+     * @brief Map a snapshot file into memory
+     *
+     * @param path Snapshot file path
+     * @param verifyChecksum Whether to verify the payload checksum
+     * @return std::unique_ptr<MappedWorldSnapshot> The mapped snapshot, or nullptr on failure
+     */
+    static std::unique_ptr<MappedWorldSnapshot> Open(const std::string& path, bool verifyChecksum = true);
+
+    ~MappedWorldSnapshot();
+
+    MappedWorldSnapshot(const MappedWorldSnapshot&) = delete;
+    MappedWorldSnapshot& operator=(const MappedWorldSnapshot&) = delete;
+
+    const WorldSnapshotHeader& GetHeader() const { return *reinterpret_cast<const WorldSnapshotHeader*>(data); }
+    size_t GetTileCount() const { return GetHeader().tileCount; }
+    uint64_t GetSeed() const { return GetHeader().seed; }
+
+    /**
+     * @brief Get the planet parameters the world was generated with
+     *
+     * @return PlanetParameters The stored parameters
+     */
+    PlanetParameters GetParameters() const;
+
+    std::span<const glm::vec3> GetCenters() const { return Column<glm::vec3>(WorldSnapshotSection::Centers, GetTileCount()); }
+    std::span<const uint8_t> GetShapes() const { return Column<uint8_t>(WorldSnapshotSection::Shapes, GetTileCount()); }
+    std::span<const float> GetElevations() const { return Column<float>(WorldSnapshotSection::Elevations, GetTileCount()); }
+    std::span<const float> GetMoistures() const { return Column<float>(WorldSnapshotSection::Moistures, GetTileCount()); }
+    std::span<const float> GetTemperatures() const { return Column<float>(WorldSnapshotSection::Temperatures, GetTileCount()); }
+    std::span<const uint8_t> GetTerrainTypes() const { return Column<uint8_t>(WorldSnapshotSection::TerrainTypes, GetTileCount()); }
+    std::span<const uint8_t> GetBiomeTypes() const { return Column<uint8_t>(WorldSnapshotSection::BiomeTypes, GetTileCount()); }
+    std::span<const int32_t> GetPlateIds() const { return Column<int32_t>(WorldSnapshotSection::PlateIds, GetTileCount()); }
+    std::span<const WorldSnapshotPlate> GetPlates() const {
+        return Column<WorldSnapshotPlate>(WorldSnapshotSection::Plates, GetHeader().plateCount);
+    }
+
+    /**
+     * @brief Whether the snapshot holds the hydrology phase's drainage
+     *
+     * @return true if the hydrology columns are present (one entry per tile)
+     */
+    bool HasHydrology() const { return GetHeader().hydrologyTileCount != 0; }
+    std::span<const int32_t> GetFlowDirections() const { return HydrologyColumn<int32_t>(WorldSnapshotSection::FlowDirections); }
+    std::span<const float> GetDischarges() const { return HydrologyColumn<float>(WorldSnapshotSection::Discharges); }
+    std::span<const int32_t> GetLakeIds() const { return HydrologyColumn<int32_t>(WorldSnapshotSection::LakeIds); }
+    std::span<const float> GetWaterSurfaces() const { return HydrologyColumn<float>(WorldSnapshotSection::WaterSurfaces); }
+
+    /**
+     * @brief Get the neighbor indices of a tile
+     *
+     * @param tileIndex Index of the tile
+     * @return std::span<const int32_t> The tile's neighbors
+     */
+    std::span<const int32_t> GetNeighbors(size_t tileIndex) const;
+
+    /**
+     * @brief Get the boundary vertices of a tile
+     *
+     * @param tileIndex Index of the tile
+     * @return std::span<const glm::vec3> The tile's boundary vertices
+     */
+    std::span<const glm::vec3> GetVertices(size_t tileIndex) const;
+
+    /**
+     * @brief Get the tiles belonging to a plate
+     *
+     * @param plateIndex Index of the plate in GetPlates()
+     * @return std::span<const int32_t> The plate's tile indices
+     */
+    std::span<const int32_t> GetPlateTiles(size_t plateIndex) const;
+
+private:
+    MappedWorldSnapshot(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    std::span<const T> Column(WorldSnapshotSection section, size_t count) const {
+        const uint64_t offset = GetHeader().sectionOffsets[static_cast<size_t>(section)];
+        return std::span<const T>(reinterpret_cast<const T*>(data + offset), count);
+    }
+
+    template <typename T>
+    std::span<const T> HydrologyColumn(WorldSnapshotSection section) const {
+        return Column<T>(section, GetHeader().hydrologyTileCount);
+    }
+
+    const uint8_t* data; ///< Start of the mapped file
+    size_t size;         ///< Size of the mapped file in bytes
+};
+
+/**
+ * @brief Rebuild a World from a mapped snapshot
+ *
+ * Copies the snapshot into regular Tile and Plate objects for code that still
+ * works on Generators::World (rendering, chunk generation).
+ *
+ * @param snapshot The mapped snapshot
+ * @param progressTracker Optional progress tracker stored in the world
+ * @return std::unique_ptr<World> The reconstructed world
+ */
+std::unique_ptr<World> CreateWorldFromSnapshot(const MappedWorldSnapshot& snapshot,
+                                               std::shared_ptr<ProgressTracker> progressTracker = nullptr);
+
+} // namespace Generators
+} // namespace WorldGen
@@ -10,98 +10,146 @@
 #include <algorithm> // For std::find_if, std::sort, std::unique, std::min/max
 #include <iostream> // For debug output
 #include <map> // Use map for ordered boundary processing
-#include <unordered_map> // For vertex->plate lookup
-#include <set> // For ordered set to avoid duplicate edges/vertices and processed boundaries
+#include <tuple> // For std::tie
 #include <cmath> // For std::abs
 
 
 namespace WorldGen {
 
-void Lithosphere::DetectBoundaries(const std::vector<glm::vec3>& planetVertices, const std::vector<unsigned int>& planetIndices) {
-    // std::cout << "Lithosphere::DetectBoundaries called." << std::endl; // Less verbose
-    if (m_plates.empty() || planetIndices.empty()) {
-        // std::cerr << "Cannot detect boundaries: No plates or indices." << std::endl; // Less verbose
-        return;
-    }
+namespace {
 
-    // 1. Clear existing boundaries using the new method
-    for (auto& plate : m_plates) {
-        plate->ClearBoundaries();
-    }
+// A boundary edge tagged with the plates on either side, for grouping by plate pair
+struct BoundaryEdge {
+    int plate1Id;
+    int plate2Id;
+    std::pair<int, int> edge;
 
-    // 2. Create a map from vertex index to plate ID for quick lookup
-    std::unordered_map<int, int> vertexIndexToPlateId;
-    for (const auto& plate : m_plates) {
-        for (int vertexIndex : plate->GetVertexIndices()) {
-            // Check for conflicts (a vertex should only belong to one plate)
-            if (vertexIndexToPlateId.count(vertexIndex)) {
-                 // This shouldn't happen with the current assignment logic, but good to check
-                 std::cerr << "Warning: Vertex " << vertexIndex << " assigned to multiple plates (" << vertexIndexToPlateId[vertexIndex] << " and " << plate->GetId() << ")" << std::endl;
-            }
-            vertexIndexToPlateId[vertexIndex] = plate->GetId();
-        }
+    bool operator<(const BoundaryEdge& other) const {
+        return std::tie(plate1Id, plate2Id, edge) < std::tie(other.plate1Id, other.plate2Id, other.edge);
     }
+};
 
-    // 3. Keep track of boundaries being built
-    // Key: pair of plate IDs (smaller first), Value: The boundary struct being built
-    std::map<std::pair<int, int>, PlateBoundary> boundaryDataMap;
+} // namespace
 
-    // 4. Iterate through triangles defined by indices to find edges
-    for (size_t i = 0; i < planetIndices.size(); i += 3) {
-        unsigned int v_indices[3] = { planetIndices[i], planetIndices[i + 1], planetIndices[i + 2] };
+void Lithosphere::BuildMeshEdges(const std::vector<unsigned int>& planetIndices) {
+    const int vertexCount = static_cast<int>(m_crust.GetVertexCount());
 
-        // Check all 3 edges of the triangle
+    // Unique edges of all triangles, smaller index first
+    m_edges.clear();
+    m_edges.reserve(planetIndices.size());
+    for (size_t i = 0; i + 2 < planetIndices.size(); i += 3) {
         for (int j = 0; j < 3; ++j) {
-            unsigned int u_idx = v_indices[j];
-            unsigned int v_idx = v_indices[(j + 1) % 3];
-
-            // Ensure consistent edge representation (smaller index first)
-            if (u_idx > v_idx) std::swap(u_idx, v_idx);
-
-            auto it_u = vertexIndexToPlateId.find(u_idx);
-            auto it_v = vertexIndexToPlateId.find(v_idx);
-
-            if (it_u != vertexIndexToPlateId.end() && it_v != vertexIndexToPlateId.end()) {
-                int plateIdU = it_u->second;
-                int plateIdV = it_v->second;
+            int u_idx = static_cast<int>(planetIndices[i + j]);
+            int v_idx = static_cast<int>(planetIndices[i + (j + 1) % 3]);
+            if (u_idx >= vertexCount || v_idx >= vertexCount) continue; // Not a planet vertex
+            m_edges.emplace_back(std::min(u_idx, v_idx), std::max(u_idx, v_idx));
+        }
+    }
+    std::sort(m_edges.begin(), m_edges.end());
+    m_edges.erase(std::unique(m_edges.begin(), m_edges.end()), m_edges.end());
+
+    // Vertex -> edge adjacency in compressed rows
+    m_vertexEdgeOffsets.assign(vertexCount + 1, 0);
+    for (const auto& edge : m_edges) {
+        m_vertexEdgeOffsets[edge.first + 1]++;
+        m_vertexEdgeOffsets[edge.second + 1]++;
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        m_vertexEdgeOffsets[v + 1] += m_vertexEdgeOffsets[v];
+    }
+    m_vertexEdges.resize(m_vertexEdgeOffsets[vertexCount]);
+    std::vector<int> fill(m_vertexEdgeOffsets.begin(), m_vertexEdgeOffsets.end() - 1);
+    for (int e = 0; e < static_cast<int>(m_edges.size()); ++e) {
+        m_vertexEdges[fill[m_edges[e].first]++] = e;
+        m_vertexEdges[fill[m_edges[e].second]++] = e;
+    }
 
-                // If vertices are on different plates, this edge is a boundary edge
-                if (plateIdU != plateIdV) {
-                    int plate1Id = std::min(plateIdU, plateIdV);
-                    int plate2Id = std::max(plateIdU, plateIdV);
-                    std::pair<int, int> boundaryKey = {plate1Id, plate2Id};
+    m_boundaryEdges.clear();
+    m_boundaryEdgeSlot.assign(m_edges.size(), -1);
+    m_meshIndexCount = planetIndices.size();
+}
 
-                    // Get or create the boundary data in the map
-                    PlateBoundary& boundary = boundaryDataMap[boundaryKey]; // Creates if not exists
+void Lithosphere::UpdateBoundaryEdge(int edge) {
+    const std::vector<int>& vertexPlateIds = m_crust.plateId;
+    int plateIdU = vertexPlateIds[m_edges[edge].first];
+    int plateIdV = vertexPlateIds[m_edges[edge].second];
+    bool isBoundary = plateIdU >= 0 && plateIdV >= 0 && plateIdU != plateIdV;
+
+    int slot = m_boundaryEdgeSlot[edge];
+    if (isBoundary && slot < 0) {
+        m_boundaryEdgeSlot[edge] = static_cast<int>(m_boundaryEdges.size());
+        m_boundaryEdges.push_back(edge);
+    } else if (!isBoundary && slot >= 0) {
+        // Swap-remove from the flat list
+        int last = m_boundaryEdges.back();
+        m_boundaryEdges[slot] = last;
+        m_boundaryEdgeSlot[last] = slot;
+        m_boundaryEdges.pop_back();
+        m_boundaryEdgeSlot[edge] = -1;
+    }
+}
 
-                    // Initialize plate indices if it's a new boundary
-                    if (boundary.plate1Index == 0 && boundary.plate2Index == 0) { // Check default init state (assuming IDs start from 1 or are non-zero)
-                        boundary.plate1Index = plate1Id;
-                        boundary.plate2Index = plate2Id;
-                    }
+void Lithosphere::DetectBoundaries(const std::vector<glm::vec3>& planetVertices, const std::vector<unsigned int>& planetIndices) {
+    // std::cout << "Lithosphere::DetectBoundaries called." << std::endl; // Less verbose
+    if (m_plates.empty() || planetIndices.empty()) {
+        // std::cerr << "Cannot detect boundaries: No plates or indices." << std::endl; // Less verbose
+        return;
+    }
 
-                    // Add the shared vertices and the edge to the boundary
-                    // Use sets to automatically handle duplicates
-                    boundary.m_sharedVertexIndices.push_back(u_idx); // We'll unique this later if needed
-                    boundary.m_sharedVertexIndices.push_back(v_idx);
-                    boundary.m_sharedEdgeIndicesSet.insert({u_idx, v_idx});
-                }
+    // 1. Update the boundary edge list. Only edges touching a vertex that changed
+    // plate can have become (or stopped being) boundaries; a new mesh needs a full pass.
+    const bool meshChanged = planetIndices.size() != m_meshIndexCount ||
+                             m_vertexEdgeOffsets.size() != m_crust.GetVertexCount() + 1;
+    if (meshChanged) {
+        BuildMeshEdges(planetIndices);
+        for (int e = 0; e < static_cast<int>(m_edges.size()); ++e) {
+            UpdateBoundaryEdge(e);
+        }
+    } else if (m_changedVertices.empty()) {
+        return; // The plates' boundaries are still current
+    } else {
+        for (int vertexIndex : m_changedVertices) {
+            for (int k = m_vertexEdgeOffsets[vertexIndex]; k < m_vertexEdgeOffsets[vertexIndex + 1]; ++k) {
+                UpdateBoundaryEdge(m_vertexEdges[k]);
             }
         }
     }
+    m_changedVertices.clear();
+
+    // 2. Group the boundary edges by plate pair (smaller ID first), in edge order within each pair
+    const std::vector<int>& vertexPlateIds = m_crust.plateId;
+    std::vector<BoundaryEdge> boundaryEdges;
+    boundaryEdges.reserve(m_boundaryEdges.size());
+    for (int e : m_boundaryEdges) {
+        const std::pair<int, int>& edge = m_edges[e];
+        int plateIdU = vertexPlateIds[edge.first];
+        int plateIdV = vertexPlateIds[edge.second];
+        boundaryEdges.push_back({std::min(plateIdU, plateIdV), std::max(plateIdU, plateIdV), edge});
+    }
+    std::sort(boundaryEdges.begin(), boundaryEdges.end());
 
-    // 5. Finalize boundaries: unique vertices, convert edge set to vector, and add to plates
-    for (auto& pair : boundaryDataMap) {
-        PlateBoundary& boundary = pair.second;
+    // 3. Build one boundary per plate pair and add it to both involved plates
+    for (auto& plate : m_plates) {
+        plate->ClearBoundaries();
+    }
+    for (size_t begin = 0; begin < boundaryEdges.size();) {
+        PlateBoundary boundary;
+        boundary.plate1Index = boundaryEdges[begin].plate1Id;
+        boundary.plate2Index = boundaryEdges[begin].plate2Id;
+
+        size_t end = begin;
+        for (; end < boundaryEdges.size() && boundaryEdges[end].plate1Id == boundary.plate1Index &&
+               boundaryEdges[end].plate2Id == boundary.plate2Index; ++end) {
+            const std::pair<int, int>& edge = boundaryEdges[end].edge;
+            boundary.m_sharedEdgeIndices.push_back(edge);
+            boundary.m_sharedVertexIndices.push_back(edge.first);
+            boundary.m_sharedVertexIndices.push_back(edge.second);
+        }
+        begin = end;
 
-        // Unique shared vertices (optional, depends on how they are used)
         std::sort(boundary.m_sharedVertexIndices.begin(), boundary.m_sharedVertexIndices.end());
         boundary.m_sharedVertexIndices.erase(std::unique(boundary.m_sharedVertexIndices.begin(), boundary.m_sharedVertexIndices.end()), boundary.m_sharedVertexIndices.end());
 
-        // Convert edge set to vector
-        boundary.m_sharedEdgeIndices.assign(boundary.m_sharedEdgeIndicesSet.begin(), boundary.m_sharedEdgeIndicesSet.end());
-
-        // Add the finalized boundary to both involved plates
         TectonicPlate* plate1 = GetPlateById(boundary.plate1Index);
         TectonicPlate* plate2 = GetPlateById(boundary.plate2Index);
         if (plate1 && plate2) {
@@ -112,7 +160,7 @@ void Lithosphere::DetectBoundaries(const std::vector<glm::vec3>& planetVertices,
         }
     }
 
-    // std::cout << "Detected " << boundaryDataMap.size() << " boundaries." << std::endl; // Less verbose
+    // std::cout << "Detected " << m_boundaryEdges.size() << " boundary edges." << std::endl; // Less verbose
 }
 
 void Lithosphere::AnalyzeBoundaries(const std::vector<glm::vec3>& planetVertices) {
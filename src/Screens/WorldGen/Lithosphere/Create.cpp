@@ -10,8 +10,8 @@
 #include <algorithm> // For std::find_if, std::sort, std::unique, std::min/max
 #include <iostream> // For debug output
 #include <limits> // Required for std::numeric_limits
-#include <cmath> // Required for std::sqrt, std::uniform_real_distribution, std::acos, std::abs
-#include <random> // For std::uniform_real_distribution
+#include <cmath> // Required for std::sqrt, std::acos, std::abs
+#include "../Generators/CounterRandom.h"
 #include <glm/gtc/constants.hpp> // For pi()
 
 
@@ -26,10 +26,11 @@ void Lithosphere::CreatePlates(const std::vector<glm::vec3>& planetVertices) {
     GeneratePlateCenters(centers, m_parameters.numTectonicPlates);
 
     // 2. Create TectonicPlate objects
+    const Generators::CounterRandom typeRandom(m_seed, Generators::RandomStream::LithospherePlateTypes);
     for (int i = 0; i < centers.size(); ++i) {
         // Determine plate type - roughly 30% continental, 70% oceanic
-        PlateType type = (m_random() % 100 < 30) ? PlateType::Continental : PlateType::Oceanic;
-        m_plates.push_back(std::make_shared<TectonicPlate>(i, type, centers[i]));
+        PlateType type = (typeRandom.Bits(i) % 100 < 30) ? PlateType::Continental : PlateType::Oceanic;
+        m_plates.push_back(std::make_shared<TectonicPlate>(i, type, centers[i], m_crust));
     }
     std::cout << "Created " << m_plates.size() << " plate objects." << std::endl;
 
@@ -57,16 +58,21 @@ void Lithosphere::GeneratePlateCenters(std::vector<glm::vec3>& centers, int numP
     float minAngleDistance = 0.8f * std::sqrt(4.0f * glm::pi<float>() / static_cast<float>(numPlates)); // Adjusted factor
     std::cout << "Minimum angle distance: " << minAngleDistance << std::endl; // Added log
 
+    // Every attempt draws from its own sequence (attempt 0 is the first point)
+    const Generators::CounterRandom random(m_seed, Generators::RandomStream::LithospherePlateCenters);
+    auto randomDirection = [&random](uint64_t attempt) {
+        Generators::RandomSequence sequence(random, attempt);
+        glm::vec3 point;
+        do {
+            point.x = sequence.Uniform(-1.0f, 1.0f);
+            point.y = sequence.Uniform(-1.0f, 1.0f);
+            point.z = sequence.Uniform(-1.0f, 1.0f);
+        } while (glm::length(point) < 0.001f); // Avoid zero vector
+        return point;
+    };
+
     // Generate first point randomly
-    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
-    glm::vec3 firstPoint;
-    do {
-        firstPoint = glm::vec3(
-            dist(m_random),
-            dist(m_random),
-            dist(m_random)
-        );
-    } while (glm::length(firstPoint) < 0.001f); // Avoid zero vector
+    glm::vec3 firstPoint = randomDirection(0);
 
     // Normalize to put on unit sphere
     firstPoint = glm::normalize(firstPoint);
@@ -89,16 +95,7 @@ void Lithosphere::GeneratePlateCenters(std::vector<glm::vec3>& centers, int numP
         This avoids potential issues with zero vectors, especially since the next step in the surrounding code is to normalize 
         this candidate vector (dividing by its length), which would fail if the length were zero.
         */
-        glm::vec3 candidate;
-        do {
-            candidate = glm::vec3(
-                dist(m_random),
-                dist(m_random),
-                dist(m_random)
-            );
-        } while (glm::length(candidate) < 0.001f);
-
-        candidate = glm::normalize(candidate);
+        glm::vec3 candidate = glm::normalize(randomDirection(static_cast<uint64_t>(attempts) + 1));
 
         // Check distance to existing points
         bool tooClose = false;
@@ -132,6 +129,9 @@ void Lithosphere::AssignVerticesToPlates(const std::vector<glm::vec3>& planetVer
     for (auto& plate : m_plates) {
         plate->ClearVertices();
     }
+    m_crust.Resize(planetVertices.size());
+    m_thicknessDelta.resize(planetVertices.size(), 0.0f);
+    m_crustTouched.resize(planetVertices.size(), 0);
 
     int assignedCount = 0;
     for (int i = 0; i < planetVertices.size(); ++i) {
@@ -159,6 +159,9 @@ void Lithosphere::AssignVerticesToPlates(const std::vector<glm::vec3>& planetVer
 
         // Assign vertex to the closest plate
         if (closestPlateIndex != -1) {
+            if (m_crust.plateId[i] != m_plates[closestPlateIndex]->GetId()) {
+                m_changedVertices.push_back(i); // Its edges need another look in DetectBoundaries
+            }
             m_plates[closestPlateIndex]->AddVertex(i);
             assignedCount++;
         }
@@ -175,7 +178,8 @@ void Lithosphere::AssignVerticesToPlates(const std::vector<glm::vec3>& planetVer
 
 void Lithosphere::InitializePlateProperties() {
     float totalMassRecalc = 0.0f; // For debug
-    std::uniform_real_distribution<float> noiseDist(-0.05f, 0.05f); // Add up to ±0.05 noise
+    // Noise is keyed by vertex, so it does not depend on which plate owns the vertex
+    const Generators::CounterRandom noiseRandom(m_seed, Generators::RandomStream::LithosphereCrust);
     for (auto& plate : m_plates) {
         float plateMass = 0.0f;
         float initialThickness = (plate->GetType() == PlateType::Continental) ? 0.5f : 0.2f; // Example values
@@ -184,7 +188,7 @@ void Lithosphere::InitializePlateProperties() {
         const auto& vertexIndices = plate->GetVertexIndices();
         for (int vertexIndex : vertexIndices) {
             // Add random noise to thickness
-            float noisyThickness = initialThickness + noiseDist(m_random);
+            float noisyThickness = initialThickness + noiseRandom.Uniform(vertexIndex, 0, -0.05f, 0.05f); // Up to ±0.05 noise
             noisyThickness = glm::clamp(noisyThickness, 0.01f, 2.0f); // Clamp to valid range
             plate->SetVertexCrustThickness(vertexIndex, noisyThickness);
             plate->SetVertexCrustAge(vertexIndex, initialAge);
@@ -197,17 +201,17 @@ void Lithosphere::InitializePlateProperties() {
 }
 
 void Lithosphere::GeneratePlateMovements() {
+    const Generators::CounterRandom random(m_seed, Generators::RandomStream::LithosphereMovements);
     for (auto& plate : m_plates) {
         // Generate random movement direction tangent to sphere at plate center
         glm::vec3 normal = glm::normalize(plate->GetCenter());
 
         // Generate random vector
-        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
-        glm::vec3 randomVec(
-            dist(m_random),
-            dist(m_random),
-            dist(m_random)
-        );
+        Generators::RandomSequence rng(random, static_cast<uint64_t>(plate->GetId()));
+        glm::vec3 randomVec;
+        randomVec.x = rng.Uniform(-1.0f, 1.0f);
+        randomVec.y = rng.Uniform(-1.0f, 1.0f);
+        randomVec.z = rng.Uniform(-1.0f, 1.0f);
 
         // Project onto tangent plane
         glm::vec3 movement = randomVec - normal * glm::dot(randomVec, normal);
@@ -222,7 +226,7 @@ void Lithosphere::GeneratePlateMovements() {
 
         // Set random rotation rate (adjust range as needed)
         float maxRotationRate = 0.002f; // Example max rate
-        float rotationRate = dist(m_random) * maxRotationRate;
+        float rotationRate = rng.Uniform(-1.0f, 1.0f) * maxRotationRate;
         plate->SetRotationRate(rotationRate);
     }
     std::cout << "Generated initial plate movements." << std::endl;
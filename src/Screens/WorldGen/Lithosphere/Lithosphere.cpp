@@ -24,7 +24,7 @@ namespace WorldGen {
 
 Lithosphere::Lithosphere(const PlanetParameters& parameters, uint64_t seed)
     : m_parameters(parameters)
-    , m_random(seed)
+    , m_seed(seed)
 {
     std::cout << "Lithosphere created with seed: " << seed << std::endl;
 }
@@ -7,7 +7,7 @@
 
 #include <vector>
 #include <memory>
-#include <random>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <map> // Added for boundary map
 #include "Plate/TectonicPlate.h" // Updated path to TectonicPlate.h
@@ -19,6 +19,8 @@ class Lithosphere {
 public:
     // Use PlanetParameters from WorldGenParameters.h
     Lithosphere(const PlanetParameters& parameters, uint64_t seed);
+    Lithosphere(const Lithosphere&) = delete;
+    Lithosphere& operator=(const Lithosphere&) = delete;
 
     // Creates the initial set of tectonic plates.
     // Needs planet mesh vertices for assignment.
@@ -33,6 +35,9 @@ public:
     const std::vector<std::shared_ptr<TectonicPlate>>& GetPlates() const;
     std::vector<std::shared_ptr<TectonicPlate>>& GetPlates();
 
+    // Per-vertex crust thickness, age and owning plate
+    const CrustFields& GetCrust() const { return m_crust; }
+
     // Public helpers needed for initial generation
     void DetectBoundaries(const std::vector<glm::vec3>& planetVertices, const std::vector<unsigned int>& planetIndices);
     void AnalyzeBoundaries(const std::vector<glm::vec3>& planetVertices); // Pass vertices
@@ -41,8 +46,22 @@ public:
 private:
     // Store parameters by value, not reference
     PlanetParameters m_parameters;
-    std::mt19937_64 m_random;
+    uint64_t m_seed; // Keys the counter-based random streams (Generators/CounterRandom.h)
     std::vector<std::shared_ptr<TectonicPlate>> m_plates;
+    CrustFields m_crust; // Plates point into this, so Lithosphere is not copyable
+    
+    // Scatter buffers for ModifyCrust, one entry per vertex, allocated with m_crust
+    std::vector<float> m_thicknessDelta;  // Accumulated boundary thickness change this step
+    std::vector<uint8_t> m_crustTouched;  // Whether a boundary changed the vertex (resets its age)
+
+    // Mesh edges and the boundary edges among them, kept up to date as vertices change plate
+    size_t m_meshIndexCount = 0;                  // Index count the edges were built from
+    std::vector<std::pair<int, int>> m_edges;     // Unique mesh edges, smaller vertex first
+    std::vector<int> m_vertexEdgeOffsets;         // Edges of vertex v are m_vertexEdges[offsets[v]..offsets[v + 1])
+    std::vector<int> m_vertexEdges;
+    std::vector<int> m_boundaryEdges;             // Edges whose vertices are on different plates, unordered
+    std::vector<int> m_boundaryEdgeSlot;          // Position of each edge in m_boundaryEdges, -1 if not a boundary
+    std::vector<int> m_changedVertices;           // Vertices assigned to another plate since the last DetectBoundaries
 
     // Helper methods
     void GeneratePlateCenters(std::vector<glm::vec3>& centers, int numPlates);
@@ -52,6 +71,8 @@ private:
     bool MovePlates(float deltaTime); // Return true if any plates moved
     bool ModifyCrust(float deltaTime); // Return true if crust was modified
     void RecalculatePlateMasses();
+    void BuildMeshEdges(const std::vector<unsigned int>& planetIndices);
+    void UpdateBoundaryEdge(int edge);
 
     // Helper to get plate by ID
     TectonicPlate* GetPlateById(int id);
@@ -14,12 +14,13 @@
 
 namespace WorldGen {
 
-TectonicPlate::TectonicPlate(int id, PlateType type, const glm::vec3& center)
+TectonicPlate::TectonicPlate(int id, PlateType type, const glm::vec3& center, CrustFields& crust)
     : m_id(id)
     , m_type(type)
     , m_center(glm::normalize(center))
     , m_movementVector(0.0f)
     , m_rotationRate(0.0f)
+    , m_crust(&crust)
     , m_totalMass(0.0f) // Initialize new member
 {
 }
@@ -49,50 +50,18 @@ float TectonicPlate::GetBaseElevation() const {
 
 void TectonicPlate::AddVertex(int vertexIndex) {
     m_vertexIndices.push_back(vertexIndex);
-    // Initialize default thickness/age if not already set (optional)
-    if (m_vertexCrustThickness.find(vertexIndex) == m_vertexCrustThickness.end()) {
-        m_vertexCrustThickness[vertexIndex] = (m_type == PlateType::Continental) ? 0.5f : 0.2f; // Default initial
+    // Initialize default thickness/age the first time the vertex is assigned;
+    // afterwards its crust moves with it to whichever plate claims it
+    if (m_crust->plateId[vertexIndex] < 0) {
+        m_crust->thickness[vertexIndex] = (m_type == PlateType::Continental) ? 0.5f : 0.2f; // Default initial
+        m_crust->age[vertexIndex] = (m_type == PlateType::Continental) ? 100.0f : 1.0f; // Default initial
     }
-    if (m_vertexCrustAge.find(vertexIndex) == m_vertexCrustAge.end()) {
-         m_vertexCrustAge[vertexIndex] = (m_type == PlateType::Continental) ? 100.0f : 1.0f; // Default initial
-    }
-}
-
-void TectonicPlate::SetVertexCrustThickness(int vertexIndex, float thickness) {
-    m_vertexCrustThickness[vertexIndex] = thickness;
-}
-
-void TectonicPlate::SetVertexCrustAge(int vertexIndex, float age) {
-    m_vertexCrustAge[vertexIndex] = age;
-}
-
-// Get crust thickness for a specific vertex
-float TectonicPlate::GetVertexCrustThickness(int vertexIndex) const {
-    auto it = m_vertexCrustThickness.find(vertexIndex);
-    if (it != m_vertexCrustThickness.end()) {
-        return it->second;
-    }
-    // Return a default or signal an error if vertex isn't part of the plate
-    // std::cerr << "Warning: Vertex " << vertexIndex << " not found in thickness map for plate " << m_id << std::endl;
-    return (m_type == PlateType::Continental) ? 0.5f : 0.2f; // Return default based on type
-}
-
-// Get crust age for a specific vertex
-float TectonicPlate::GetVertexCrustAge(int vertexIndex) const {
-    auto it = m_vertexCrustAge.find(vertexIndex);
-    if (it != m_vertexCrustAge.end()) {
-        return it->second;
-    }
-    // Return a default or signal an error
-    // std::cerr << "Warning: Vertex " << vertexIndex << " not found in age map for plate " << m_id << std::endl;
-    return (m_type == PlateType::Continental) ? 100.0f : 1.0f; // Return default based on type
+    m_crust->plateId[vertexIndex] = m_id;
 }
 
 void TectonicPlate::ClearVertices() {
     m_vertexIndices.clear();
-    // Optionally clear thickness/age maps if they should reset on re-assignment
-    // m_vertexCrustThickness.clear();
-    // m_vertexCrustAge.clear();
+    // The crust columns keep their values (and owner) until the vertex is reassigned
 }
 
 void TectonicPlate::AddBoundary(const PlateBoundary& boundary) {
@@ -114,7 +83,6 @@ void TectonicPlate::UpdateBoundary(int otherPlateId, const PlateBoundary& update
          {
              // Update the relevant fields (don't overwrite plate indices)
              boundary.m_sharedVertexIndices = updatedBoundary.m_sharedVertexIndices;
-             boundary.m_sharedEdgeIndicesSet = updatedBoundary.m_sharedEdgeIndicesSet; // Copy set
              boundary.m_sharedEdgeIndices = updatedBoundary.m_sharedEdgeIndices; // Copy vector
              boundary.stress = updatedBoundary.stress;
              boundary.type = updatedBoundary.type;
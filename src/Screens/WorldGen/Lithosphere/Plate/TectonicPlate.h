@@ -7,10 +7,8 @@
 
 #include <vector>
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <glm/glm.hpp>
-#include <set> // Include set for boundary management
 
 namespace WorldGen {
 
@@ -26,12 +24,11 @@ enum class BoundaryType {
 };
 
 struct PlateBoundary {
-    int plate1Index;
-    int plate2Index;
+    int plate1Index = -1;
+    int plate2Index = -1;
     std::vector<int> m_sharedVertexIndices;
     // Store edges as pairs of indices, ensuring smaller index is first for consistency
-    std::set<std::pair<int, int>> m_sharedEdgeIndicesSet; // Use set during detection
-    std::vector<std::pair<int, int>> m_sharedEdgeIndices; // Final vector for rendering/analysis
+    std::vector<std::pair<int, int>> m_sharedEdgeIndices; // Sorted, for rendering/analysis
     float stress = 0.0f;
     BoundaryType type = BoundaryType::Transform; // Default type
     float m_relativeMovementMagnitude = 0.0f;
@@ -39,10 +36,26 @@ struct PlateBoundary {
     float m_transformSpeed = 0.0f;   // Store calculated speeds
 };
 
+// Crust state of every planet vertex, shared by all plates and indexed by vertex.
+// Dense columns keep per-step updates to linear passes instead of hash lookups.
+struct CrustFields {
+    std::vector<float> thickness;
+    std::vector<float> age;
+    std::vector<int> plateId; // Owning plate, -1 until the vertex is first assigned
+
+    void Resize(size_t vertexCount) {
+        thickness.resize(vertexCount, 0.0f);
+        age.resize(vertexCount, 0.0f);
+        plateId.resize(vertexCount, -1);
+    }
+    size_t GetVertexCount() const { return plateId.size(); }
+};
+
 
 class TectonicPlate {
 public:
-    TectonicPlate(int id, PlateType type, const glm::vec3& center);
+    // crust is owned by the Lithosphere and must outlive the plate
+    TectonicPlate(int id, PlateType type, const glm::vec3& center, CrustFields& crust);
 
     // Getters
     int GetId() const { return m_id; }
@@ -54,13 +67,9 @@ public:
     std::vector<int>& GetVertexIndices() { return m_vertexIndices; } // Non-const version
     const std::vector<PlateBoundary>& GetBoundaries() const { return m_boundaries; }
     std::vector<PlateBoundary>& GetBoundaries() { return m_boundaries; }
-    const std::unordered_map<int, float>& GetVertexCrustThickness() const { return m_vertexCrustThickness; }
-    std::unordered_map<int, float>& GetVertexCrustThickness() { return m_vertexCrustThickness; } // Non-const version
-    const std::unordered_map<int, float>& GetVertexCrustAge() const { return m_vertexCrustAge; }
-    std::unordered_map<int, float>& GetVertexCrustAge() { return m_vertexCrustAge; } // Non-const version
     float GetTotalMass() const { return m_totalMass; }
-    float GetVertexCrustThickness(int vertexIndex) const; // Added getter
-    float GetVertexCrustAge(int vertexIndex) const; // Added getter
+    float GetVertexCrustThickness(int vertexIndex) const { return m_crust->thickness[vertexIndex]; }
+    float GetVertexCrustAge(int vertexIndex) const { return m_crust->age[vertexIndex]; }
 
     // Setters
     void SetCenter(const glm::vec3& center) { m_center = glm::normalize(center); } // Ensure center is normalized
@@ -71,8 +80,8 @@ public:
     // Methods
     void AddVertex(int vertexIndex);
     void ClearVertices(); // Added declaration
-    void SetVertexCrustThickness(int vertexIndex, float thickness);
-    void SetVertexCrustAge(int vertexIndex, float age);
+    void SetVertexCrustThickness(int vertexIndex, float thickness) { m_crust->thickness[vertexIndex] = thickness; }
+    void SetVertexCrustAge(int vertexIndex, float age) { m_crust->age[vertexIndex] = age; }
     void AddBoundary(const PlateBoundary& boundary); // Declaration added
     void UpdateBoundary(int otherPlateId, const PlateBoundary& updatedBoundary); // Declaration added
     void ClearBoundaries(); // Added declaration
@@ -87,8 +96,7 @@ private:
     float m_rotationRate; // Angular speed around m_center axis
     std::vector<int> m_vertexIndices;
     std::vector<PlateBoundary> m_boundaries;
-    std::unordered_map<int, float> m_vertexCrustThickness;
-    std::unordered_map<int, float> m_vertexCrustAge;
+    CrustFields* m_crust; // Shared per-vertex crust state (not owned)
     float m_totalMass = 0.0f;
 };
 
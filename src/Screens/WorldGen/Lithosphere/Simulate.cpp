@@ -12,7 +12,6 @@
 #include <limits> // Required for std::numeric_limits
 #include <cmath> // Required for std::sqrt, std::uniform_real_distribution, std::acos, std::abs
 #include <map> // Use map for ordered boundary processing
-#include <unordered_map> // For temporary storage in ModifyCrust
 #include <set> // For ordered set to avoid duplicate edges/vertices and processed boundaries
 #include <glm/gtx/rotate_vector.hpp> // For glm::rotate
 #include <glm/gtc/quaternion.hpp> // For quaternions
@@ -95,9 +94,10 @@ bool Lithosphere::ModifyCrust(float deltaTime) {
     const float minThickness = 0.01f; // Minimum crust thickness
     const float maxThickness = 2.0f;  // Maximum crust thickness
 
-    // Store changes temporarily to avoid race conditions if modifying shared vertices
-    std::unordered_map<int, float> thicknessChanges; // vertexIndex -> change in thickness
-    std::unordered_map<int, float> ageChanges;       // vertexIndex -> new age (absolute value)
+    // Scatter changes into the per-vertex buffers first, since boundaries share vertices.
+    // Every recorded change also resets the vertex's age.
+    std::vector<float>& thicknessChanges = m_thicknessDelta;
+    std::vector<uint8_t>& touched = m_crustTouched;
 
     // Iterate through boundaries to apply modifications
     std::set<std::pair<int, int>> processedBoundaries; // Track processed boundary pairs
@@ -156,7 +156,7 @@ bool Lithosphere::ModifyCrust(float deltaTime) {
                             // Only record significant changes
                             if (std::abs(thicknessIncrease) > SIGNIFICANT_THICKNESS_CHANGE) {
                                 thicknessChanges[vertexIndex] += thicknessIncrease; // Accumulate changes
-                                ageChanges[vertexIndex] = 0.0f; // Reset age due to mountain building
+                                touched[vertexIndex] = 1; // Reset age due to mountain building
                             }
                         } else {
                             // Subduction/Orogeny involving at least one oceanic plate
@@ -167,7 +167,7 @@ bool Lithosphere::ModifyCrust(float deltaTime) {
                                 // Only record significant changes
                                 if (std::abs(thicknessIncrease) > SIGNIFICANT_THICKNESS_CHANGE) {
                                     thicknessChanges[vertexIndex] += thicknessIncrease;
-                                    ageChanges[vertexIndex] = 0.0f; // Reset age due to uplift/volcanism
+                                    touched[vertexIndex] = 1; // Reset age due to uplift/volcanism
                                 }
                             }
                             if (subductingPlate && subductingPlate->GetType() == PlateType::Oceanic) {
@@ -177,7 +177,7 @@ bool Lithosphere::ModifyCrust(float deltaTime) {
                                 // Only record significant changes
                                 if (std::abs(thicknessDecrease) > SIGNIFICANT_THICKNESS_CHANGE) {
                                     thicknessChanges[vertexIndex] += thicknessDecrease;
-                                    ageChanges[vertexIndex] = 0.0f; // Reset age
+                                    touched[vertexIndex] = 1; // Reset age
                                 }
                             }
                         }
@@ -192,7 +192,7 @@ bool Lithosphere::ModifyCrust(float deltaTime) {
                         // Only record significant changes
                         if (std::abs(thicknessChange) > SIGNIFICANT_THICKNESS_CHANGE) {
                             thicknessChanges[vertexIndex] += thicknessChange;
-                            ageChanges[vertexIndex] = 0.0f; // New crust is young
+                            touched[vertexIndex] = 1; // New crust is young
                         }
                     }
                     break;
@@ -205,50 +205,44 @@ bool Lithosphere::ModifyCrust(float deltaTime) {
         }
     }
 
-    // Apply accumulated changes and general aging to all vertices
-    for (auto& plate : m_plates) {
-        auto& thicknessMap = plate->GetVertexCrustThickness();
-        auto& ageMap = plate->GetVertexCrustAge();
-        const auto& vertexIndices = plate->GetVertexIndices(); // Get indices for this plate
+    // Apply accumulated changes and general aging to all vertices in one pass,
+    // clearing the scatter buffers for the next step as we go
+    std::vector<float>& thicknessColumn = m_crust.thickness;
+    std::vector<float>& ageColumn = m_crust.age;
+    const std::vector<int>& plateColumn = m_crust.plateId;
+    const size_t vertexCount = m_crust.GetVertexCount();
 
-        for (int vertexIndex : vertexIndices) {
-            float currentThickness = thicknessMap[vertexIndex];
-            float currentAge = ageMap[vertexIndex];
-            float newThickness = currentThickness;
-            float newAge = currentAge;
-            bool vertexModified = false;
+    for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+        if (plateColumn[vertexIndex] < 0) continue; // Not on any plate
 
-            // Apply specific boundary changes
-            if (thicknessChanges.count(vertexIndex)) {
-                newThickness += thicknessChanges[vertexIndex];
-                vertexModified = true;
-            }
-            
-            if (ageChanges.count(vertexIndex)) {
-                newAge = ageChanges[vertexIndex]; // Set new absolute age
-                // Note: We don't count age changes as visual modifications anymore
-            } else {
-                // Apply general aging if no boundary interaction reset it
-                newAge += ageIncreaseRate;
-                // Don't count age changes as significant visual modifications anymore
-                // Age changes don't affect the appearance of the planet in this simulation
-            }
+        float currentThickness = thicknessColumn[vertexIndex];
+        float newThickness = currentThickness;
+        bool vertexModified = false;
 
-            // Clamp thickness
-            newThickness = glm::clamp(newThickness, minThickness, maxThickness);
-            
-            // Only update thickness and set the modified flag if there was a significant thickness change
-            if (std::abs(newThickness - currentThickness) > SIGNIFICANT_THICKNESS_CHANGE) {
-                thicknessMap[vertexIndex] = newThickness;
-                vertexModified = true;
-            }
-            
-            // Always update age, but DO NOT count it for the dirty flag
-            ageMap[vertexIndex] = newAge;
-            
-            if (vertexModified) {
-                anyCrustModified = true;
-            }
+        if (touched[vertexIndex]) {
+            // Apply specific boundary changes and set the new absolute age
+            newThickness += thicknessChanges[vertexIndex];
+            ageColumn[vertexIndex] = 0.0f;
+            vertexModified = true;
+            thicknessChanges[vertexIndex] = 0.0f;
+            touched[vertexIndex] = 0;
+        } else {
+            // Apply general aging if no boundary interaction reset it
+            // Age changes don't affect the appearance of the planet, so they never set the dirty flag
+            ageColumn[vertexIndex] += ageIncreaseRate;
+        }
+
+        // Clamp thickness
+        newThickness = glm::clamp(newThickness, minThickness, maxThickness);
+        
+        // Only update thickness and set the modified flag if there was a significant thickness change
+        if (std::abs(newThickness - currentThickness) > SIGNIFICANT_THICKNESS_CHANGE) {
+            thicknessColumn[vertexIndex] = newThickness;
+            vertexModified = true;
+        }
+        
+        if (vertexModified) {
+            anyCrustModified = true;
         }
     }
     
@@ -257,30 +251,22 @@ bool Lithosphere::ModifyCrust(float deltaTime) {
 
 void Lithosphere::RecalculatePlateMasses() {
     // std::cout << "Lithosphere::RecalculatePlateMasses called." << std::endl; // Less verbose
-    for (auto& plate : m_plates) {
-        float plateMass = 0.0f;
-        const auto& thicknessMap = plate->GetVertexCrustThickness();
-        const auto& vertexIndices = plate->GetVertexIndices();
-
-        if (vertexIndices.empty()) {
-            plate->SetTotalMass(0.0f);
-            continue;
-        }
+    // Plate ids are their creation indices (see CreatePlates)
+    std::vector<float> plateMasses(m_plates.size(), 0.0f);
+    const std::vector<float>& thicknessColumn = m_crust.thickness;
+    const std::vector<int>& plateColumn = m_crust.plateId;
 
-        for (int vertexIndex : vertexIndices) {
+    for (size_t vertexIndex = 0; vertexIndex < m_crust.GetVertexCount(); ++vertexIndex) {
+        int plateId = plateColumn[vertexIndex];
+        if (plateId >= 0 && plateId < static_cast<int>(plateMasses.size())) {
             // Simple mass calculation: sum of thickness
             // TODO: Improve by considering vertex area and density
-            auto it = thicknessMap.find(vertexIndex);
-            if (it != thicknessMap.end()) {
-                 plateMass += it->second;
-            } else {
-                // This shouldn't happen if initialization and modification are correct
-                std::cerr << "Warning: Vertex " << vertexIndex << " on plate " << plate->GetId() << " missing thickness during mass recalc." << std::endl;
-                // Assign a default thickness based on plate type? Or 0?
-                plateMass += (plate->GetType() == PlateType::Continental) ? 0.5f : 0.2f;
-            }
+            plateMasses[plateId] += thicknessColumn[vertexIndex];
         }
-        plate->SetTotalMass(plateMass);
+    }
+
+    for (auto& plate : m_plates) {
+        plate->SetTotalMass(plate->GetVertexIndices().empty() ? 0.0f : plateMasses[plate->GetId()]);
     }
     // std::cout << "Finished recalculating plate masses." << std::endl; // Less verbose
 }
@@ -1,121 +1,209 @@
 #include "ProgressTracker.h"
 #include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <string_view>
 
 namespace WorldGen {
 
+namespace {
+
+// Templates for the messages the tracker reports itself
+const char* const kPhaseStartedTemplate = "Starting {phase}";
+const char* const kPhaseCompletedTemplate = "Completed {phase}";
+const char* const kErrorTemplate = "Error: {error}";
+
+} // namespace
+
 ProgressTracker::ProgressTracker()
-    : currentPhaseIndex(-1)
+    : phaseCount(0)
+    , unphasedProgress(0.0f)
+    , currentPhaseIndex(-1)
+    , messageTemplate("")
+    , messageCurrent(0)
+    , messageTotal(0)
+    , updateCount(0)
     , startTime(std::chrono::steady_clock::now())
 {
+    for (auto& progress : phaseProgress) {
+        progress.store(0.0f, std::memory_order_relaxed);
+    }
 }
 
 ProgressTracker::~ProgressTracker()
 {
 }
 
-void ProgressTracker::SetCallback(ProgressCallback callback)
-{
-    this->callback = callback;
-}
-
 void ProgressTracker::AddPhase(const std::string& name, float weight)
 {
-    phases.push_back({name, weight, 0.0f});
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    if (phases.size() >= kMaxPhases) {
+        std::cerr << "Warning: ProgressTracker can only hold " << kMaxPhases << " phases, ignoring " << name << std::endl;
+        return;
+    }
+    phaseProgress[phases.size()].store(0.0f, std::memory_order_relaxed);
+    phases.push_back({name, weight});
+    phaseCount.store(phases.size(), std::memory_order_relaxed);
 }
 
 void ProgressTracker::StartPhase(const std::string& phaseName)
 {
     // Find the phase by name
-    auto it = std::find_if(phases.begin(), phases.end(),
-        [&phaseName](const PhaseInfo& phase) { return phase.name == phaseName; });
-    
-    if (it != phases.end()) {
-        currentPhaseIndex = std::distance(phases.begin(), it);
-        phases[currentPhaseIndex].progress = 0.0f;
-        currentMessage = "Starting " + phaseName;
-        
-        if (callback) {
-            callback(GetOverallProgress(), currentMessage);
+    int phaseIndex = -1;
+    {
+        std::lock_guard<std::mutex> lock(phaseMutex);
+        auto it = std::find_if(phases.begin(), phases.end(),
+            [&phaseName](const PhaseInfo& phase) { return phase.name == phaseName; });
+        if (it != phases.end()) {
+            phaseIndex = static_cast<int>(std::distance(phases.begin(), it));
         }
     }
+
+    if (phaseIndex >= 0) {
+        phaseProgress[phaseIndex].store(0.0f, std::memory_order_relaxed);
+        currentPhaseIndex.store(phaseIndex, std::memory_order_relaxed);
+        Publish(kPhaseStartedTemplate, 0, 0);
+    }
 }
 
-void ProgressTracker::UpdateProgress(float progress, const std::string& message)
+void ProgressTracker::UpdateProgress(float progress, const char* messageTemplate, uint64_t current, uint64_t total)
 {
-    if (currentPhaseIndex >= 0 && currentPhaseIndex < phases.size()) {
-        phases[currentPhaseIndex].progress = std::clamp(progress, 0.0f, 1.0f);
-        currentMessage = message;
-
-        // std::cout << message << std::endl; // Debug output
-        
-        if (callback) {
-            callback(GetOverallProgress(), currentMessage);
+    progress = std::clamp(progress, 0.0f, 1.0f);
+    if (phaseCount.load(std::memory_order_relaxed) == 0) {
+        unphasedProgress.store(progress, std::memory_order_relaxed);
+    } else {
+        int phaseIndex = currentPhaseIndex.load(std::memory_order_relaxed);
+        if (phaseIndex < 0) {
+            return;
         }
+        phaseProgress[phaseIndex].store(progress, std::memory_order_relaxed);
     }
+    Publish(messageTemplate ? messageTemplate : "", current, total);
 }
 
 void ProgressTracker::CompletePhase()
 {
-    if (currentPhaseIndex >= 0 && currentPhaseIndex < phases.size()) {
-        phases[currentPhaseIndex].progress = 1.0f;
-        currentMessage = "Completed " + phases[currentPhaseIndex].name;
-        
-        if (callback) {
-            callback(GetOverallProgress(), currentMessage);
-        }
+    int phaseIndex = currentPhaseIndex.load(std::memory_order_relaxed);
+    if (phaseIndex >= 0) {
+        phaseProgress[phaseIndex].store(1.0f, std::memory_order_relaxed);
+        Publish(kPhaseCompletedTemplate, 0, 0);
+    }
+}
+
+void ProgressTracker::ReportError(const std::string& message)
+{
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errorMessage = message;
     }
+    Publish(kErrorTemplate, 0, 0);
+}
+
+void ProgressTracker::Publish(const char* messageTemplate, uint64_t current, uint64_t total)
+{
+    this->messageTemplate.store(messageTemplate, std::memory_order_relaxed);
+    messageCurrent.store(current, std::memory_order_relaxed);
+    messageTotal.store(total, std::memory_order_relaxed);
+    updateCount.fetch_add(1, std::memory_order_release);
 }
 
 float ProgressTracker::GetOverallProgress() const
 {
-    if (phases.empty()) return 0.0f;
-    
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    if (phases.empty()) return unphasedProgress.load(std::memory_order_relaxed);
+
     float totalWeight = 0.0f;
     float weightedProgress = 0.0f;
-    
-    for (const auto& phase : phases) {
-        totalWeight += phase.weight;
-        weightedProgress += phase.weight * phase.progress;
+
+    for (size_t i = 0; i < phases.size(); ++i) {
+        totalWeight += phases[i].weight;
+        weightedProgress += phases[i].weight * phaseProgress[i].load(std::memory_order_relaxed);
     }
-    
+
     return totalWeight > 0.0f ? weightedProgress / totalWeight : 0.0f;
 }
 
 int ProgressTracker::GetEstimatedSecondsRemaining() const
 {
-    if (phases.empty() || currentPhaseIndex < 0) return 0;
-    
+    if (phaseCount.load(std::memory_order_relaxed) == 0 || currentPhaseIndex.load(std::memory_order_relaxed) < 0) return 0;
+
+    std::chrono::time_point<std::chrono::steady_clock> start;
+    {
+        std::lock_guard<std::mutex> lock(phaseMutex);
+        start = startTime;
+    }
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
-    
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - start).count();
+
     float progress = GetOverallProgress();
     if (progress <= 0.0f) return 0;
-    
+
     float estimatedTotal = elapsed / progress;
     return static_cast<int>(estimatedTotal - elapsed);
 }
 
-const std::string& ProgressTracker::GetCurrentPhase() const
+std::string ProgressTracker::GetCurrentPhase() const
 {
-    if (currentPhaseIndex >= 0 && currentPhaseIndex < phases.size()) {
-        return phases[currentPhaseIndex].name;
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    int phaseIndex = currentPhaseIndex.load(std::memory_order_relaxed);
+    if (phaseIndex >= 0 && phaseIndex < static_cast<int>(phases.size())) {
+        return phases[phaseIndex].name;
     }
-    static const std::string empty;
-    return empty;
+    return std::string();
 }
 
-const std::string& ProgressTracker::GetCurrentMessage() const
+std::string ProgressTracker::GetCurrentMessage() const
 {
-    return currentMessage;
+    const char* text = messageTemplate.load(std::memory_order_relaxed);
+    const uint64_t current = messageCurrent.load(std::memory_order_relaxed);
+    const uint64_t total = messageTotal.load(std::memory_order_relaxed);
+
+    // Fill in the placeholders
+    std::string message;
+    while (const char* open = std::strchr(text, '{')) {
+        message.append(text, open);
+        const char* close = std::strchr(open, '}');
+        if (!close) {
+            text = open;
+            break;
+        }
+        std::string_view name(open + 1, close - open - 1);
+        if (name == "current") {
+            message += std::to_string(current);
+        } else if (name == "total") {
+            message += std::to_string(total);
+        } else if (name == "phase") {
+            message += GetCurrentPhase();
+        } else if (name == "error") {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            message += errorMessage;
+        } else {
+            message.append(open, close + 1);
+        }
+        text = close + 1;
+    }
+    message += text;
+    return message;
 }
 
 void ProgressTracker::Reset()
 {
+    std::lock_guard<std::mutex> lock(phaseMutex);
     phases.clear();
-    currentPhaseIndex = -1;
-    currentMessage.clear();
+    phaseCount.store(0, std::memory_order_relaxed);
+    for (auto& progress : phaseProgress) {
+        progress.store(0.0f, std::memory_order_relaxed);
+    }
+    unphasedProgress.store(0.0f, std::memory_order_relaxed);
+    currentPhaseIndex.store(-1, std::memory_order_relaxed);
+    messageTemplate.store("", std::memory_order_relaxed);
+    messageCurrent.store(0, std::memory_order_relaxed);
+    messageTotal.store(0, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errorMessage.clear();
+    }
     startTime = std::chrono::steady_clock::now();
 }
 
-} // namespace WorldGen 
\ No newline at end of file
+} // namespace WorldGen
@@ -1,56 +1,107 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
-#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace WorldGen {
 
 /**
  * @brief Tracks progress of world generation phases
- * 
+ *
  * This class manages the progress tracking for the world generation process,
  * providing real-time feedback on the current phase and overall progress.
+ *
+ * Reporting is lock-free and allocation-free so it can be called from
+ * generation inner loops: an update stores the progress, a message template
+ * and two counters in atomics and bumps an update counter. The UI thread
+ * polls GetUpdateCount and formats the message only when it shows it.
+ * Message templates must be string literals (or otherwise outlive the
+ * tracker); their address is what identifies them. Concurrent updates from
+ * several threads may be combined in one snapshot, which only affects the
+ * label for a frame.
+ *
+ * Phase configuration (AddPhase, StartPhase, Reset, which generators call a
+ * few times per run) and the status getters (called by the UI once per
+ * frame) share a mutex; UpdateProgress only touches atomics.
  */
 class ProgressTracker {
 public:
-    using ProgressCallback = std::function<void(float progress, const std::string& message)>;
-
     struct PhaseInfo {
         std::string name;
         float weight;
-        float progress;
     };
 
+    // Most phases a tracker can hold
+    static constexpr size_t kMaxPhases = 16;
+
     ProgressTracker();
     ~ProgressTracker();
 
     // Configuration
-    void SetCallback(ProgressCallback callback);
     void AddPhase(const std::string& name, float weight);
 
     // Progress tracking
     void StartPhase(const std::string& phaseName);
-    void UpdateProgress(float progress, const std::string& message = "");
+
+    /**
+     * @brief Report progress of the current phase (or of the whole run if no phases are configured)
+     *
+     * @param progress Progress from 0 to 1
+     * @param messageTemplate Status text; may contain {current} and {total}, filled in from the counters
+     * @param current Value for {current}
+     * @param total Value for {total}
+     */
+    void UpdateProgress(float progress, const char* messageTemplate = "", uint64_t current = 0, uint64_t total = 0);
     void CompletePhase();
 
+    /**
+     * @brief Report a failure; the message is shown as "Error: <message>"
+     *
+     * Takes a lock and copies the message, so it is for error paths only.
+     */
+    void ReportError(const std::string& message);
+
     // Status information
     float GetOverallProgress() const;
     int GetEstimatedSecondsRemaining() const;
-    const std::string& GetCurrentPhase() const;
-    const std::string& GetCurrentMessage() const;
+    std::string GetCurrentPhase() const;
+
+    /**
+     * @brief Format the current message (call from the UI thread, not from generation loops)
+     */
+    std::string GetCurrentMessage() const;
+
+    /**
+     * @brief Number of updates so far; poll it to see whether anything changed
+     */
+    uint64_t GetUpdateCount() const { return updateCount.load(std::memory_order_acquire); }
 
     // Reset
     void Reset();
 
 private:
+    void Publish(const char* messageTemplate, uint64_t current, uint64_t total);
+
+    mutable std::mutex phaseMutex; ///< Guards phases and startTime
     std::vector<PhaseInfo> phases;
-    int currentPhaseIndex;
-    ProgressCallback callback;
+    std::atomic<size_t> phaseCount;
+    std::array<std::atomic<float>, kMaxPhases> phaseProgress;
+    std::atomic<float> unphasedProgress;
+    std::atomic<int> currentPhaseIndex;
+    std::atomic<const char*> messageTemplate;
+    std::atomic<uint64_t> messageCurrent;
+    std::atomic<uint64_t> messageTotal;
+    std::atomic<uint64_t> updateCount;
     std::chrono::time_point<std::chrono::steady_clock> startTime;
-    std::string currentMessage;
+
+    mutable std::mutex errorMutex;
+    std::string errorMessage;
 };
 
-} // namespace WorldGen 
\ No newline at end of file
+} // namespace WorldGen
@@ -19,8 +19,13 @@ namespace Renderers {
 World::World()
     : world(nullptr)
     , vao(0)
-    , vbo(0)
+    , positionVbo(0)
+    , tileDataVbo(0)
     , ebo(0)
+    , radius(1.0f)
+    , positionFloatsUploaded(0)
+    , tileDataFloatsUploaded(0)
+    , positionsFlat(false)
     , dataGenerated(false)
     , visualizationMode(WorldGen::VisualizationMode::Terrain)
 {
@@ -33,8 +38,12 @@ World::~World()
         glDeleteVertexArrays(1, &vao);
     }
     
-    if (vbo != 0) {
-        glDeleteBuffers(1, &vbo);
+    if (positionVbo != 0) {
+        glDeleteBuffers(1, &positionVbo);
+    }
+    
+    if (tileDataVbo != 0) {
+        glDeleteBuffers(1, &tileDataVbo);
     }
     
     if (ebo != 0) {
@@ -47,23 +56,46 @@ World::~World()
 void World::SetWorld(const Generators::World* world)
 {
     this->world = world;
-    dataGenerated = false; // Need to regenerate rendering data
     
-    // When world is set, regenerate vertex data with proper elevations
+    // When world is set, update vertex data with proper elevations
     if (world) {
-        GenerateRenderingData();
+        const auto& tiles = world->GetTiles();
+        std::vector<float> elevations(tiles.size());
+        std::vector<int> plateIds(tiles.size());
+        std::vector<TerrainType> terrainTypes(tiles.size());
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            elevations[i] = tiles[i].GetElevation();
+            plateIds[i] = tiles[i].GetPlateId();
+            terrainTypes[i] = tiles[i].GetTerrainType();
+        }
+        radius = world->GetRadius();
+        GenerateRenderingData(tiles, elevations, plateIds, terrainTypes);
     }
 }
 
+void World::SetPreview(std::shared_ptr<const Generators::WorldPreview> preview)
+{
+    if (!preview || !preview->geometry) {
+        return;
+    }
+    
+    world = nullptr;
+    radius = preview->radius;
+    if (!preview->plates->empty()) {
+        SetPlateData(*preview->plates);
+    }
+    GenerateRenderingData(*preview->geometry, *preview->elevations, *preview->plateIds, *preview->terrainTypes);
+}
+
 void World::SetVisualizationMode(WorldGen::VisualizationMode mode)
 {
     if (visualizationMode != mode) {
         visualizationMode = mode;
-        // When switching to/from plate mode, regenerate vertex data
-        // because plate mode should be flat while other modes show terrain
-        dataGenerated = false;
-        if (world) {
-            GenerateRenderingData();
+        // Plate mode is drawn flat while other modes show terrain, so
+        // switching to or from it only changes the vertex positions
+        bool flat = visualizationMode == WorldGen::VisualizationMode::TectonicPlates;
+        if (dataGenerated && flat != positionsFlat) {
+            UpdatePositions();
         }
     }
 }
@@ -125,12 +157,7 @@ void World::SetPlateData(const std::vector<Generators::Plate>& plates)
 
 void World::Render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix)
 {
-    if (!world) { return; }
-
-    // Generate rendering data if needed
-    if (!dataGenerated) {
-        GenerateRenderingData();
-    }
+    if (!dataGenerated) { return; }
     
     // Save current OpenGL state
     GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
@@ -229,31 +256,63 @@ void World::ValidateTileGeometry()
       // Debug logging removed
 }
 
-void World::GenerateRenderingData()
+void World::GenerateRenderingData(std::span<const Generators::Tile> tiles, std::span<const float> elevations,
+                                  std::span<const int> plateIds, std::span<const TerrainType> terrainTypes)
 {
-    if (!world) {
-        return;
+    // Work out which streams differ from what is on the GPU; previews and
+    // the finished world of one run share their geometry
+    bool geometryChanged = !dataGenerated ||
+        !std::equal(tiles.begin(), tiles.end(), topologyCenters.begin(), topologyCenters.end(),
+                    [](const Generators::Tile& tile, const glm::vec3& center) { return tile.GetCenter() == center; });
+    bool elevationsChanged = geometryChanged || !std::ranges::equal(elevations, tileElevations);
+    bool plateIdsChanged = geometryChanged || !std::ranges::equal(plateIds, tilePlateIds);
+    bool terrainChanged = geometryChanged || !std::ranges::equal(terrainTypes, tileTerrainTypes);
+    
+    CreateBuffers();
+    
+    if (geometryChanged) {
+        // Validate the tile geometry to catch any issues early
+        if (world) {
+            ValidateTileGeometry();
+        }
+        BuildTopology(tiles);
+    }
+    
+    tileElevations.assign(elevations.begin(), elevations.end());
+    tilePlateIds.assign(plateIds.begin(), plateIds.end());
+    tileTerrainTypes.assign(terrainTypes.begin(), terrainTypes.end());
+    
+    if (elevationsChanged) {
+        UpdatePositions();
+    }
+    if (elevationsChanged || plateIdsChanged || terrainChanged) {
+        UpdateTileData();
     }
-
-    // Debug logging removed
     
-    // Validate the tile geometry to catch any issues early
-    ValidateTileGeometry();
+    // Load shaders if not already loaded
+    if (shader.getProgram() == 0) {
+        if (!shader.loadFromFile("Planet/PlanetVertex.glsl", "Planet/PlanetFragment.glsl")) {
+            std::cerr << "Failed to load planet shaders" << std::endl;
+        }
+    }
+    
+    dataGenerated = true;
+}
 
+void World::BuildTopology(std::span<const Generators::Tile> tiles)
+{
     // Clear previous data
-    vertexData.clear();
     indices.clear();
     tileFanInfo.clear();
+    unitPositions.clear();
+    vertexTiles.clear();
+    vertexTileOffsets.assign(1, 0);
+    topologyCenters.resize(tiles.size());
     
-    // Get the tiles
-    const auto& tiles = world->GetTiles();
-      // Use the terrain colors defined in TerrainTypes.h
-    // We'll convert vec4 to vec3 as needed
-    
-    // NEW APPROACH:
     // 1. Put all vertices for all tiles in a single array
     // 2. For each tile, create indices that point ONLY to its own vertices
-    // 3. Assign a unique color to each tile for easier debugging
+    // 3. Record which tiles' elevations each vertex averages, so elevation
+    //    changes only need the positions recomputed
     
     unsigned int vertexOffset = 0; // Running count of vertices in the buffer
     
@@ -261,6 +320,7 @@ void World::GenerateRenderingData()
     for (size_t tileIdx = 0; tileIdx < tiles.size(); ++tileIdx) {
         const auto& tile = tiles[tileIdx];
         const auto& tileVertices = tile.GetVertices();
+        topologyCenters[tileIdx] = tile.GetCenter();
         
         // Skip invalid tiles
         if (tileVertices.size() < 3) {
@@ -270,53 +330,21 @@ void World::GenerateRenderingData()
         
         // Number of vertices for this tile (center + perimeter)
         unsigned int vertexCount = static_cast<unsigned int>(tileVertices.size() + 1);
-          // Index where this tile's indices start in the indices array
+        // Index where this tile's indices start in the indices array
         unsigned int indexOffset = static_cast<unsigned int>(indices.size());
-        // No color calculation needed - shader will handle it
-        
-        // Get the center position with elevation
-        glm::vec3 centerPos = glm::normalize(tile.GetCenter());
-        
-        // Apply elevation-based scaling
-        float centerElevationScale;
-        if (visualizationMode == WorldGen::VisualizationMode::TectonicPlates) {
-            // Keep plates flat for better visualization
-            centerElevationScale = 1.001f;
-        } else {
-            // Show 3D terrain for other modes
-            // Convert physical meter elevation to normalized scale for vertex positioning
-            float planetRadius = PlanetParameters().physicalRadiusMeters;
-            float normalizedElevation = (tile.GetElevation() - planetRadius) / 10000.0f; // Normalize to ±10km range
-            normalizedElevation = glm::clamp(normalizedElevation, -1.0f, 1.0f); // Clamp to safe range
-            // Scale: -1.0 = deep ocean (radius 0.9), 0.0 = sea level (radius 1.0), 1.0 = high mountains (radius 1.1)
-            centerElevationScale = 1.0f + (normalizedElevation * 0.1f);
-        }
-        centerPos *= centerElevationScale;
-          // Store vertex data
-        // First the center vertex
-        unsigned int centerVertexIndex = vertexOffset;
-          vertexData.push_back(centerPos.x);
-        vertexData.push_back(centerPos.y);
-        vertexData.push_back(centerPos.z);
-        vertexData.push_back(centerPos.x); 
-        vertexData.push_back(centerPos.y);
-        vertexData.push_back(centerPos.z);
-        // Instead of color, store tile data as floats
-        vertexData.push_back(static_cast<float>(tile.GetTerrainType())); // Terrain type
-        vertexData.push_back(static_cast<float>(tile.GetPlateId()));     // Plate ID
-        vertexData.push_back(tile.GetElevation());                       // Elevation
         
+        // First the center vertex, which only takes its own tile's elevation
+        glm::vec3 normal = glm::normalize(tile.GetCenter());
+        unitPositions.push_back(normal);
+        vertexTiles.push_back(static_cast<unsigned int>(tileIdx));
+        vertexTileOffsets.push_back(static_cast<unsigned int>(vertexTiles.size()));
+        indices.push_back(vertexOffset);
         vertexOffset++;
         
-        // Store indices for the triangle fan
-        // First is the center vertex
-        indices.push_back(centerVertexIndex);
-        
         // Sort the perimeter vertices to ensure they form a proper polygon when connected
         std::vector<std::pair<float, glm::vec3>> sortedVertices;
         
         // Define two orthogonal vectors in the tangent plane of the sphere at the center point
-        glm::vec3 normal = glm::normalize(centerPos);
         glm::vec3 tangent1 = glm::vec3(1.0f, 0.0f, 0.0f);
         // If the normal is too close to the x-axis, use a different tangent
         if (glm::abs(glm::dot(normal, tangent1)) > 0.9f) {
@@ -347,67 +375,29 @@ void World::GenerateRenderingData()
             [](const std::pair<float, glm::vec3>& a, const std::pair<float, glm::vec3>& b) {
                 return a.first < b.first;
             });
-          // Next, add all sorted perimeter vertices with same color as the tile
+        
+        // Next, add all sorted perimeter vertices
         unsigned int firstPerimeterIndex = vertexOffset;
         
         for (size_t i = 0; i < sortedVertices.size(); ++i) {
-            // Get the vertex and normalize it
             glm::vec3 vertex = sortedVertices[i].second;
-            glm::vec3 vertexPos = glm::normalize(vertex);
-            
-            // Calculate interpolated elevation for this vertex by averaging tiles that share it
-            float vertexElevation = tile.GetElevation(); // Start with current tile's elevation
-            int elevationCount = 1;
+            unitPositions.push_back(glm::normalize(vertex));
             
-            // Find neighboring tiles that share this vertex
-            const auto& neighbors = tile.GetNeighbors();
-            for (int neighborIdx : neighbors) {
+            // The vertex elevation is the average of this tile and the neighbors that share the vertex
+            vertexTiles.push_back(static_cast<unsigned int>(tileIdx));
+            for (int neighborIdx : tile.GetNeighbors()) {
                 if (neighborIdx >= 0 && neighborIdx < tiles.size()) {
-                    const auto& neighborTile = tiles[neighborIdx];
-                    const auto& neighborVertices = neighborTile.GetVertices();
-                    
                     // Check if this neighbor shares this vertex
-                    for (const auto& nv : neighborVertices) {
+                    for (const auto& nv : tiles[neighborIdx].GetVertices()) {
                         float dist = glm::length(vertex - nv);
                         if (dist < 0.001f) { // Vertices match within tolerance
-                            vertexElevation += neighborTile.GetElevation();
-                            elevationCount++;
+                            vertexTiles.push_back(static_cast<unsigned int>(neighborIdx));
                             break;
                         }
                     }
                 }
             }
-            
-            // Average the elevations
-            vertexElevation /= elevationCount;
-            
-            // Apply elevation scaling based on visualization mode
-            float vertexElevationScale;
-            if (visualizationMode == WorldGen::VisualizationMode::TectonicPlates) {
-                // Keep plates flat for better visualization
-                vertexElevationScale = 1.001f;
-            } else {
-                // Show 3D terrain for other modes
-                // Convert physical meter elevation to normalized scale for vertex positioning
-                float planetRadius = PlanetParameters().physicalRadiusMeters;
-                float normalizedElevation = (vertexElevation - planetRadius) / 10000.0f; // Normalize to ±10km range
-                normalizedElevation = glm::clamp(normalizedElevation, -1.0f, 1.0f); // Clamp to safe range
-                // Scale: -1.0 = deep ocean (radius 0.9), 0.0 = sea level (radius 1.0), 1.0 = high mountains (radius 1.1)
-                vertexElevationScale = 1.0f + (normalizedElevation * 0.1f);
-            }
-            vertexPos *= vertexElevationScale;
-            
-            // Add vertex
-            vertexData.push_back(vertexPos.x);
-            vertexData.push_back(vertexPos.y);
-            vertexData.push_back(vertexPos.z);
-            vertexData.push_back(vertexPos.x); // Normal = position for a sphere
-            vertexData.push_back(vertexPos.y);
-            vertexData.push_back(vertexPos.z);
-            // Instead of color, store tile data as floats
-            vertexData.push_back(static_cast<float>(tile.GetTerrainType())); // Terrain type
-            vertexData.push_back(static_cast<float>(tile.GetPlateId()));     // Plate ID
-            vertexData.push_back(tile.GetElevation());                       // Elevation
+            vertexTileOffsets.push_back(static_cast<unsigned int>(vertexTiles.size()));
             
             // Add this vertex to the indices
             indices.push_back(vertexOffset);
@@ -425,54 +415,113 @@ void World::GenerateRenderingData()
         tileInfo.startIndex = indexOffset;   // Offset in the indices array
         tileInfo.vertexCount = vertexCount;  // How many vertices in this tile
         tileInfo.indexCount = indexCount;    // How many indices for the fan
-          tileFanInfo.push_back(tileInfo);
+        tileFanInfo.push_back(tileInfo);
     }
     
+    // The element buffer is part of the vertex array state
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+}
+
+void World::UpdatePositions()
+{
+    const bool flat = visualizationMode == WorldGen::VisualizationMode::TectonicPlates;
+    const float planetRadius = PlanetParameters().physicalRadiusMeters;
     
-    // Set up OpenGL objects
-    // Create and bind VAO
-    if (vao == 0) {
-        glGenVertexArrays(1, &vao);
+    positionData.resize(unitPositions.size() * 6);
+    for (size_t v = 0; v < unitPositions.size(); ++v) {
+        float elevationScale;
+        if (flat) {
+            // Keep plates flat for better visualization
+            elevationScale = 1.001f;
+        } else {
+            // Average the elevations of the tiles meeting at this vertex
+            float elevation = 0.0f;
+            for (unsigned int k = vertexTileOffsets[v]; k < vertexTileOffsets[v + 1]; ++k) {
+                elevation += tileElevations[vertexTiles[k]];
+            }
+            elevation /= static_cast<float>(vertexTileOffsets[v + 1] - vertexTileOffsets[v]);
+            
+            // Convert physical meter elevation to normalized scale for vertex positioning
+            float normalizedElevation = (elevation - planetRadius) / 10000.0f; // Normalize to ±10km range
+            normalizedElevation = glm::clamp(normalizedElevation, -1.0f, 1.0f); // Clamp to safe range
+            // Scale: -1.0 = deep ocean (radius 0.9), 0.0 = sea level (radius 1.0), 1.0 = high mountains (radius 1.1)
+            elevationScale = 1.0f + (normalizedElevation * 0.1f);
+        }
+        glm::vec3 position = unitPositions[v] * elevationScale;
+        
+        float* out = &positionData[v * 6];
+        out[0] = position.x;
+        out[1] = position.y;
+        out[2] = position.z;
+        out[3] = position.x; // Normal = position for a sphere
+        out[4] = position.y;
+        out[5] = position.z;
     }
-    glBindVertexArray(vao);
     
-    // Create and bind VBO
-    if (vbo == 0) {
-        glGenBuffers(1, &vbo);
+    UploadStream(positionVbo, positionData, positionFloatsUploaded);
+    positionsFlat = flat;
+}
+
+void World::UpdateTileData()
+{
+    // Instead of color, store tile data as floats; the shader picks the colors
+    tileData.resize(unitPositions.size() * 3);
+    for (size_t v = 0; v < unitPositions.size(); ++v) {
+        unsigned int tileIdx = vertexTiles[vertexTileOffsets[v]];
+        float* out = &tileData[v * 3];
+        out[0] = static_cast<float>(tileTerrainTypes[tileIdx]); // Terrain type
+        out[1] = static_cast<float>(tilePlateIds[tileIdx]);     // Plate ID
+        out[2] = tileElevations[tileIdx];                       // Elevation
     }
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_STATIC_DRAW);
     
-    // Create and bind EBO
-    if (ebo == 0) {
-        glGenBuffers(1, &ebo);
+    UploadStream(tileDataVbo, tileData, tileDataFloatsUploaded);
+}
+
+void World::CreateBuffers()
+{
+    if (vao != 0) {
+        return;
     }
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &positionVbo);
+    glGenBuffers(1, &tileDataVbo);
+    glGenBuffers(1, &ebo);
+    
+    glBindVertexArray(vao);
     
     // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, positionVbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     
     // Normal attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    // Color attribute
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
+    // Tile data attribute (terrain type, plate id, elevation)
+    glBindBuffer(GL_ARRAY_BUFFER, tileDataVbo);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(2);
     
     // Unbind
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
-      // Load shaders if not already loaded
-    if (shader.getProgram() == 0) {
-        if (!shader.loadFromFile("Planet/PlanetVertex.glsl", "Planet/PlanetFragment.glsl")) {
-            std::cerr << "Failed to load planet shaders" << std::endl;
-        }
+}
+
+void World::UploadStream(unsigned int buffer, const std::vector<float>& data, size_t& uploadedFloats)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (uploadedFloats == data.size()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, data.size() * sizeof(float), data.data());
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_DYNAMIC_DRAW);
+        uploadedFloats = data.size();
     }
-    
-    dataGenerated = true;
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 
@@ -493,7 +542,7 @@ void World::RenderTiles(const glm::mat4& viewMatrix, const glm::mat4& projection
     shader.use();
     
     // Set up model matrix
-    float scale = world->GetRadius();
+    float scale = radius;
     glm::mat4 modelMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale));
       // Set the shader uniforms
     GLint useColorAttribLoc = glGetUniformLocation(shader.getProgram(), "useColorAttrib");
@@ -624,9 +673,9 @@ void World::RenderTile(const TileFanInfo& tileInfo,
 {
     // Get the center vertex for visibility check
     unsigned int centerVertexIdx = indices[tileInfo.startIndex];
-    glm::vec3 center(vertexData[centerVertexIdx * 9], 
-                     vertexData[centerVertexIdx * 9 + 1], 
-                     vertexData[centerVertexIdx * 9 + 2]);
+    glm::vec3 center(positionData[centerVertexIdx * 6], 
+                     positionData[centerVertexIdx * 6 + 1], 
+                     positionData[centerVertexIdx * 6 + 2]);
                       
     // Check if this tile has at least one visible vertex
     bool anyVertexVisible = isVisible(center);
@@ -634,9 +683,9 @@ void World::RenderTile(const TileFanInfo& tileInfo,
         // If center isn't visible, check perimeter vertices
         for (unsigned int i = 1; i < tileInfo.indexCount; ++i) {
             unsigned int vertexIdx = indices[tileInfo.startIndex + i];
-            glm::vec3 vertex(vertexData[vertexIdx * 9], 
-                             vertexData[vertexIdx * 9 + 1], 
-                             vertexData[vertexIdx * 9 + 2]);
+            glm::vec3 vertex(positionData[vertexIdx * 6], 
+                             positionData[vertexIdx * 6 + 1], 
+                             positionData[vertexIdx * 6 + 2]);
             if (isVisible(vertex)) {
                 anyVertexVisible = true;
                 break;
@@ -656,13 +705,13 @@ void World::RenderTile(const TileFanInfo& tileInfo,
 }
 
 void World::RenderPlateArrows(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
-    if (plateData.empty() || !world) return;
+    if (plateData.empty() || !dataGenerated) return;
     
     // Use the same shader
     shader.use();
     
     // Set up model matrix
-    float scale = world->GetRadius();
+    float scale = radius;
     glm::mat4 modelMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale));
     
     // Set uniforms
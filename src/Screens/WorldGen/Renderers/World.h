@@ -3,8 +3,10 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <span>
 #include <glm/glm.hpp>
 #include "../Generators/World.h"
+#include "../Generators/WorldPreview.h"
 #include "../Generators/TectonicPlates.h" // For Plate struct
 #include "../../../Shader.h"
 #include "../UI/WorldGenUI.h" // For VisualizationMode enum
@@ -17,6 +19,11 @@ namespace Renderers {
  * 
  * This class provides visualization for the World object,
  * including options to visualize the mesh in different ways.
+ *
+ * Vertex positions and per-tile data are separate buffers. Setting a new
+ * world or preview compares it with what is on the GPU and re-uploads only
+ * the streams that changed; the tile fans are rebuilt only when the tile
+ * geometry itself changes.
  */
 class World {
 public:    // Visualization options are now handled internally
@@ -38,6 +45,16 @@ public:    // Visualization options are now handled internally
      */
     void SetWorld(const Generators::World* world);
     
+    /**
+     * @brief Show a snapshot of a world that is still being generated.
+     * 
+     * Replaces the current world until the next SetWorld call. The snapshot
+     * is not kept; its columns are copied into the render data.
+     * 
+     * @param preview The snapshot to show.
+     */
+    void SetPreview(std::shared_ptr<const Generators::WorldPreview> preview);
+    
     /**
      * @brief Set the visualization mode for tile coloring.
      * 
@@ -69,9 +86,40 @@ public:    // Visualization options are now handled internally
     const Shader& getShader() const { return shader; }
 
 private:    /**
-     * @brief Generate rendering data for the world.
+     * @brief Bring the rendering data up to date with a world's tiles and attribute columns.
+     * 
+     * @param tiles Tile geometry (centers, corners and neighbors).
+     * @param elevations Elevation per tile.
+     * @param plateIds Plate per tile.
+     * @param terrainTypes Terrain type per tile.
+     */
+    void GenerateRenderingData(std::span<const Generators::Tile> tiles, std::span<const float> elevations,
+                               std::span<const int> plateIds, std::span<const TerrainType> terrainTypes);
+    
+    /**
+     * @brief Build the tile fans and the unit-sphere vertex positions.
+     */
+    void BuildTopology(std::span<const Generators::Tile> tiles);
+    
+    /**
+     * @brief Recompute and upload vertex positions and normals from the elevations.
      */
-    void GenerateRenderingData();
+    void UpdatePositions();
+    
+    /**
+     * @brief Recompute and upload the per-vertex tile data (terrain type, plate id, elevation).
+     */
+    void UpdateTileData();
+    
+    /**
+     * @brief Create the vertex array and its buffers.
+     */
+    void CreateBuffers();
+    
+    /**
+     * @brief Upload a vertex stream, reusing the buffer storage when the size is unchanged.
+     */
+    void UploadStream(unsigned int buffer, const std::vector<float>& data, size_t& uploadedFloats);
       struct TileFanInfo {
         unsigned int startIndex;    ///< Starting index in the vertex buffer
         unsigned int vertexCount;   ///< Number of vertices in this tile (center + perimeter)
@@ -101,8 +149,10 @@ private:    /**
       const Generators::World* world;    ///< The world to render
     // OpenGL rendering data
     unsigned int vao;                  ///< Vertex array object
-    unsigned int vbo;                  ///< Vertex buffer object
+    unsigned int positionVbo;          ///< Vertex positions and normals
+    unsigned int tileDataVbo;          ///< Per-vertex tile data
     unsigned int ebo;                  ///< Element buffer object
+    float radius;                      ///< Radius of the world being shown
     Shader shader;                     ///< Shader object
     std::vector<TileFanInfo> tileFanInfo; ///< Triangle fan information for each tile
     
@@ -114,8 +164,23 @@ private:    /**
     std::vector<glm::vec3> plateColors; // Pre-calculated colors for each plate
 
     // Render data for different modes    // Render data for different modes
-    std::vector<float> vertexData;     ///< Vertex data for rendering
+    std::vector<float> positionData;   ///< Position and normal per vertex (6 floats)
+    std::vector<float> tileData;       ///< Terrain type, plate id and elevation per vertex (3 floats)
     std::vector<unsigned int> indices; ///< Indices for rendering
+    size_t positionFloatsUploaded;     ///< Size of the position buffer storage
+    size_t tileDataFloatsUploaded;     ///< Size of the tile data buffer storage
+    bool positionsFlat;                ///< Whether the uploaded positions ignore elevation
+    
+    // Topology, kept so attribute changes do not rebuild the tile fans
+    std::vector<glm::vec3> topologyCenters;           ///< Tile centers the fans were built from
+    std::vector<glm::vec3> unitPositions;             ///< Vertex positions on the unit sphere
+    std::vector<unsigned int> vertexTileOffsets;      ///< Start of each vertex's range in vertexTiles
+    std::vector<unsigned int> vertexTiles;            ///< Tiles whose elevations a vertex averages; its own tile first
+    
+    // Attribute columns currently on the GPU
+    std::vector<float> tileElevations;
+    std::vector<int> tilePlateIds;
+    std::vector<TerrainType> tileTerrainTypes;
       bool dataGenerated;                ///< Whether rendering data has been generated
 };
 
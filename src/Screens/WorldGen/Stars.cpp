@@ -1,12 +1,19 @@
 #include "Stars.h"
-#include <random>
 #include "../../Camera.h"
 #include <GLFW/glfw3.h>
 #include "../../Rendering/Layer.h"
 #include "../../Rendering/Shapes/Rectangle.h"
+#include "Generators/CounterRandom.h"
 
 namespace WorldGen {
 
+namespace {
+
+// Fixed so the star field keeps its layout when the window is resized
+constexpr uint64_t kStarfieldSeed = 0x5747415253ull;
+
+} // namespace
+
 Stars::Stars(Camera* camera, GLFWwindow* window)
     : camera(camera), window(window) {
     
@@ -19,18 +26,13 @@ void Stars::generate(int width, int height) {
     starLayer->clearItems();
     
     // Create star background
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> disX(0.0f, static_cast<float>(width));
-    std::uniform_real_distribution<float> disY(0.0f, static_cast<float>(height));
-    std::uniform_real_distribution<float> disSize(1.0f, 3.0f);
-    std::uniform_real_distribution<float> disAlpha(0.5f, 1.0f);
+    const Generators::CounterRandom random(kStarfieldSeed, Generators::RandomStream::Stars);
     
     for (int i = 0; i < 200; ++i) {
-        float x = disX(gen);
-        float y = disY(gen);
-        float size = disSize(gen);
-        float alpha = disAlpha(gen);
+        float x = random.Uniform(i, 0, 0.0f, static_cast<float>(width));
+        float y = random.Uniform(i, 1, 0.0f, static_cast<float>(height));
+        float size = random.Uniform(i, 2, 1.0f, 3.0f);
+        float alpha = random.Uniform(i, 3, 0.5f, 1.0f);
         
         auto star = std::make_shared<Rendering::Shapes::Rectangle>(
             Rendering::Shapes::Rectangle::Args{
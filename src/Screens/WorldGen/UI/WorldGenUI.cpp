@@ -170,6 +170,23 @@ WorldGenUI::WorldGenUI(Camera* camera, GLFWwindow* window)
     );
     sidebarLayer->addItem(seedInput);
     
+    // Reroll picks a new random seed and generates it right away
+    rerollButton = std::make_shared<Rendering::Components::Button>(
+        Rendering::Components::Button::Args{
+            .label = "Reroll",
+            .position = glm::vec2(labelX + 80.0f, startY + 3 * lineHeight),
+            .size = glm::vec2(70.0f, 25.0f),
+            .type = Rendering::Components::Button::Type::Secondary,
+            .onClick = [this]() {
+                auto it = eventHandlers.find(UIEvent::RerollWorld);
+                if (it != eventHandlers.end()) {
+                    it->second();
+                }
+            }
+        }
+    );
+    sidebarLayer->addItem(rerollButton);
+    
     // Initialize with config defaultSeed if provided, otherwise random seed
     auto& config = ConfigManager::getInstance();
     auto defaultSeed = config.getDefaultSeed();
@@ -374,29 +391,35 @@ void WorldGenUI::setState(UIState newState) {
             case UIState::Generating:
                 std::cout << "Generating";
                 generateButton->setDisabled(true);
+                rerollButton->setDisabled(true);
                 landButton->setDisabled(true);
                 break;
             case UIState::Viewing:
                 generateButton->setDisabled(false);
+                rerollButton->setDisabled(false);
                 std::cout << "Viewing";
                 break;
             case UIState::Landing:
                 generateButton->setDisabled(false);
+                rerollButton->setDisabled(false);
                 landButton->setDisabled(false);
                 std::cout << "Landing";
                 break;
             case UIState::Saving:
                 generateButton->setDisabled(true);
+                rerollButton->setDisabled(true);
                 landButton->setDisabled(true);
                 std::cout << "Saving";
                 break;
             case UIState::Loading:
                 generateButton->setDisabled(true);
+                rerollButton->setDisabled(true);
                 landButton->setDisabled(true);
                 std::cout << "Loading";
                 break;
             case UIState::LoadingGameWorld:
                 generateButton->setDisabled(true);
+                rerollButton->setDisabled(true);
                 landButton->setDisabled(true);
                 std::cout << "Loading Game World";
                 break;
@@ -558,6 +581,12 @@ void WorldGenUI::randomizeSeed() {
     seedInput->setValue(std::to_string(newSeed));
 }
 
+void WorldGenUI::setSeed(unsigned int seed) {
+    std::string seedStr = std::to_string(seed);
+    seedInput->setValue(seedStr);
+    validateSeedInput(seedStr);
+}
+
 unsigned int WorldGenUI::getCurrentSeed() const {
     std::string seedText = seedInput->getValue();
     
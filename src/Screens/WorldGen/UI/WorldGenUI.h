@@ -25,7 +25,8 @@ enum class UIEvent {
     GenerateWorld,
     GoToLand,
     Back,
-    ChangeVisualization
+    ChangeVisualization,
+    RerollWorld
 };
 
 // Visualization modes
@@ -103,6 +104,7 @@ private:
     std::shared_ptr<Rendering::Shapes::Text> waterValue;
     std::shared_ptr<Rendering::Shapes::Text> seedLabel;
     std::shared_ptr<Rendering::Components::Form::Text> seedInput;
+    std::shared_ptr<Rendering::Components::Button> rerollButton;
 
     // Buttons
     std::shared_ptr<Rendering::Components::Button> generateButton;
@@ -138,6 +140,7 @@ private:
 public:
     // Seed management
     void randomizeSeed();
+    void setSeed(unsigned int seed);
     unsigned int getCurrentSeed() const;
 
 private:
@@ -11,6 +11,9 @@
 #include "VectorGraphics.h"
 #include <algorithm> // Keep algorithm include
 #include "../../CoordinateSystem.h"
+#include "../../ConfigManager.h"
+#include "Generators/GeometryCache.h"
+#include "Generators/Classification.h"
 
 // Define M_PI if not already defined
 #ifndef M_PI
@@ -53,7 +56,7 @@ WorldGenScreen::WorldGenScreen(Camera* camera, GLFWwindow* window):
 
 WorldGenScreen::~WorldGenScreen() {
     // Signal threads to stop
-    shouldStopGeneration = true;
+    generationCancellation.Cancel();
     shouldStopGameWorldCreation = true;
     
     // Wait for threads to finish
@@ -65,6 +68,10 @@ WorldGenScreen::~WorldGenScreen() {
         gameWorldThread.join();
     }
     
+    // Cancels the speculative build in flight and deletes the pool's snapshots
+    // (after the join, since the generation thread resumes the pool when it ends)
+    worldPool.reset();
+    
     // Remove scroll callback
     if (window) {
         glfwSetScrollCallback(window, nullptr);
@@ -80,13 +87,21 @@ bool WorldGenScreen::initialize() {
         return false;
     }
     
-    // Set up the progress tracker callback now that UI is initialized
-    progressTracker->SetCallback([this](float progress, const std::string& message) {
-        std::lock_guard<std::mutex> lock(progressMutex);
-        latestProgress.progress = progress;
-        latestProgress.message = message;
-        latestProgress.hasUpdate = true;
-    });
+    // Base geometry is cached in memory; also keep it on disk when a directory is configured
+    auto& config = ConfigManager::getInstance();
+    WorldGen::Generators::GeometryCache::GetInstance().SetDiskDirectory(config.getGeometryCacheDirectory());
+    
+    // Optionally build worlds for the next rerolls in the background
+    if (config.getPregeneratedWorlds() > 0) {
+        WorldGen::Generators::SpeculativeWorldPoolSettings poolSettings;
+        poolSettings.worldCount = static_cast<size_t>(config.getPregeneratedWorlds());
+        poolSettings.memoryLimitMB = static_cast<size_t>(std::max(0, config.getPregenerationMemoryMB()));
+        poolSettings.threadCount = static_cast<size_t>(std::max(1, config.getPregenerationThreads()));
+        poolSettings.snapshotDirectory = config.getPregenerationSnapshotDirectory();
+        worldPool = std::make_unique<WorldGen::Generators::SpeculativeWorldPool>(poolSettings, planetParams);
+        std::cout << "Pregenerating " << poolSettings.worldCount << " worlds for rerolls (memory limit "
+                  << poolSettings.memoryLimitMB << " MB)" << std::endl;
+    }
     
     // Set up OpenGL blending for transparency
     glEnable(GL_BLEND);
@@ -128,22 +143,25 @@ bool WorldGenScreen::initialize() {
         
         // Get seed from UI (seed is no longer part of PlanetParameters)
         currentSeed = worldGenUI->getCurrentSeed();
+        startWorldGeneration();
+    });
+    
+    // Reroll event: generate the next random seed, which the pool may already have built
+    worldGenUI->addEventListener(WorldGen::UIEvent::RerollWorld, [this]() {
+        std::cout << "Reroll button clicked" << std::endl;
+        worldGenUI->setState(WorldGen::UIState::Generating);
         
-        // Reset the progress tracker
-        progressTracker->Reset();
-        
-        // Stop any existing generation thread
-        if (isGenerating) {
-            shouldStopGeneration = true;
-            if (generationThread.joinable()) {
-                generationThread.join();
-            }
-            shouldStopGeneration = false;
+        if (worldPool) {
+            worldPool->SetParameters(planetParams);
+            auto candidate = worldPool->TakeNext();
+            currentSeed = candidate.seed;
+            worldGenUI->setSeed(static_cast<unsigned int>(currentSeed));
+            startWorldGeneration(std::move(candidate.world));
+        } else {
+            worldGenUI->randomizeSeed();
+            currentSeed = worldGenUI->getCurrentSeed();
+            startWorldGeneration();
         }
-        
-        // Start a new generation thread
-        isGenerating = true;
-        generationThread = std::thread(&WorldGenScreen::worldGenerationThreadFunc, this);
     });
     
     // Visualization mode change event
@@ -310,7 +328,21 @@ void WorldGenScreen::render() {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     stars->render();    // --- Render the icosahedron world if generated ---
 
-    if (worldGenerated && world && worldRenderer) {
+    // While the world is being generated, show the newest preview of it
+    if (!worldGenerated && worldRenderer) {
+        std::shared_ptr<const WorldGen::Generators::WorldPreview> preview;
+        {
+            std::lock_guard<std::mutex> lock(previewMutex);
+            preview = std::move(pendingPreview);
+        }
+        if (preview) {
+            worldRenderer->SetPreview(std::move(preview));
+            showingPreview = true;
+        }
+    }
+
+    const bool showWorld = worldGenerated && world;
+    if ((showWorld || showingPreview) && worldRenderer) {
         // Enable depth testing for 3D rendering
         glEnable(GL_DEPTH_TEST);
         glDepthFunc(GL_LESS);
@@ -337,17 +369,19 @@ void WorldGenScreen::render() {
         );        // Update renderer with current visualization mode
         worldRenderer->SetVisualizationMode(currentVisualizationMode);
         
-        // Pass plate data if available
-        const auto& plates = world->GetPlates();
-        if (!plates.empty()) {
-            worldRenderer->SetPlateData(plates);
+        // Pass plate data if available (previews carry their own)
+        if (showWorld) {
+            const auto& plates = world->GetPlates();
+            if (!plates.empty()) {
+                worldRenderer->SetPlateData(plates);
+            }
         }
         
         // Render the world with adjusted projection
         worldRenderer->Render(viewMatrix, adjustedProjection);
         
         // Render the landing location indicator
-        if (landingLocation) {
+        if (landingLocation && showWorld) {
             // std::cout << "Rendering landing location indicator" << std::endl;
             landingLocation->Render(viewMatrix, adjustedProjection);
         }
@@ -561,6 +595,8 @@ void WorldGenScreen::convertWorldToTerrainData() {
     // Track progress
     size_t totalTiles = tiles.size();
     
+    const WorldGen::Generators::TerrainClassifier terrainClassifier(waterLevel, WorldGen::Generators::kNormalizedTerrainBands);
+    
     // Project tiles onto a 2D grid based on spherical coordinates
     for (size_t i = 0; i < tiles.size(); ++i) {
         const auto& tile = tiles[i];
@@ -581,26 +617,10 @@ void WorldGenScreen::convertWorldToTerrainData() {
         // For example, use the elevation for terrain type
         float elevation = tile.GetElevation();
         
-        if (elevation < waterLevel - 0.2f) {
-            terrainData.type = WorldGen::TerrainType::Ocean;
-            waterTileCount++;
-        } else if (elevation < waterLevel - 0.05f) {
-            terrainData.type = WorldGen::TerrainType::Shallow;
+        terrainData.type = terrainClassifier.Classify(elevation);
+        if (terrainData.type == WorldGen::TerrainType::Ocean || terrainData.type == WorldGen::TerrainType::Shallow) {
             waterTileCount++;
-        } else if (elevation < waterLevel + 0.05f) {
-            terrainData.type = WorldGen::TerrainType::Beach;
-            landTileCount++;
-        } else if (elevation < waterLevel + 0.3f) {
-            terrainData.type = WorldGen::TerrainType::Lowland;
-            landTileCount++;
-        } else if (elevation < waterLevel + 0.6f) {
-            terrainData.type = WorldGen::TerrainType::Highland;
-            landTileCount++;
-        } else if (elevation < waterLevel + 0.8f) {
-            terrainData.type = WorldGen::TerrainType::Mountain;
-            landTileCount++;
         } else {
-            terrainData.type = WorldGen::TerrainType::Peak;
             landTileCount++;
         }
         
@@ -645,10 +665,8 @@ void WorldGenScreen::convertWorldToTerrainData() {
         // Update progress every 1000 tiles
         if (progressTracker && i % 1000 == 0) {
             float progress = 0.1f + (static_cast<float>(i) / totalTiles) * 0.8f;
-            std::string message = "Converting tiles to terrain data (" + 
-                                 std::to_string(i) + " of " + 
-                                 std::to_string(totalTiles) + ")";
-            progressTracker->UpdateProgress(progress, message);
+            progressTracker->UpdateProgress(progress, "Converting tiles to terrain data ({current} of {total})",
+                                            i, totalTiles);
         }
     }
     
@@ -698,16 +716,70 @@ void WorldGenScreen::convertWorldToTerrainData() {
     }
 }
 
+void WorldGenScreen::startWorldGeneration(std::unique_ptr<WorldGen::Generators::World> readyWorld) {
+    // Stop any existing generation thread
+    // (cancelled generation unwinds within milliseconds, so this join is short)
+    if (isGenerating) {
+        generationCancellation.Cancel();
+    }
+    if (generationThread.joinable()) {
+        generationThread.join();
+    }
+    generationCancellation.Reset();
+    {
+        std::lock_guard<std::mutex> lock(previewMutex);
+        pendingPreview.reset();
+    }
+    
+    // Reset the progress tracker (no generation thread is using it now)
+    progressTracker->Reset();
+    worldGenerated = false;
+    
+    // A seed typed in by hand may be one the pool has built too
+    if (worldPool) {
+        worldPool->SetParameters(planetParams);
+        if (!readyWorld) {
+            readyWorld = worldPool->Take(currentSeed);
+        }
+    }
+    if (readyWorld) {
+        // Swap the pooled world in; processProgressMessages hands it to the renderer
+        std::cout << "Using pregenerated world for seed " << currentSeed << std::endl;
+        world = std::move(readyWorld);
+        worldGenerated = true;
+        progressTracker->UpdateProgress(1.0f, "World generation complete!");
+        return;
+    }
+    
+    // Keep the pool from starting new builds while the foreground generates
+    if (worldPool) {
+        worldPool->SetPaused(true);
+    }
+    
+    // Start a new generation thread
+    isGenerating = true;
+    generationThread = std::thread(&WorldGenScreen::worldGenerationThreadFunc, this);
+}
+
 void WorldGenScreen::worldGenerationThreadFunc() {
     try {
         // Generate the world in this background thread
-        world = WorldGen::Generators::Generator::CreateWorld(planetParams, currentSeed, progressTracker);
-        
-        // Check if we should stop
-        if (shouldStopGeneration) {
+        auto generatedWorld = WorldGen::Generators::Generator::CreateWorld(
+            planetParams, currentSeed, progressTracker, &generationCancellation,
+            [this](std::shared_ptr<const WorldGen::Generators::WorldPreview> preview) {
+                std::lock_guard<std::mutex> lock(previewMutex);
+                pendingPreview = std::move(preview);
+            });
+        
+        // Check if we should stop (a cancelled run returns no world and has already freed its data)
+        if (!generatedWorld || generationCancellation.IsCancelled()) {
+            if (worldPool) {
+                worldPool->SetPaused(false);
+            }
             isGenerating = false;
             return;
         }
+        world = std::move(generatedWorld);
         
         // The complete world generation pipeline is now handled by Generator::CreateWorld
         // which includes geometry, plates, mountains, and future features
@@ -716,19 +788,16 @@ void WorldGenScreen::worldGenerationThreadFunc() {
         worldGenerated = true;
         
         // Set final completion progress
-        std::lock_guard<std::mutex> lock(progressMutex);
-        latestProgress.progress = 1.0f;
-        latestProgress.message = "World generation complete!";
-        latestProgress.hasUpdate = true;
+        progressTracker->UpdateProgress(1.0f, "World generation complete!");
     }
     catch (const std::exception& e) {
         // Handle any exceptions
-        std::lock_guard<std::mutex> lock(progressMutex);
-        latestProgress.progress = 0.0f;
-        latestProgress.message = std::string("Error: ") + e.what();
-        latestProgress.hasUpdate = true;
+        progressTracker->ReportError(e.what());
     }
     
+    if (worldPool) {
+        worldPool->SetPaused(false);
+    }
     isGenerating = false;
 }
 
@@ -747,10 +816,7 @@ void WorldGenScreen::gameWorldCreationThreadFunc() {
         
         // Check if we should stop
         if (shouldStopGameWorldCreation) {
-            std::lock_guard<std::mutex> lock(progressMutex);
-            latestProgress.progress = 0.0f;
-            latestProgress.message = "Game world creation canceled";
-            latestProgress.hasUpdate = true;
+            progressTracker->UpdateProgress(0.0f, "Game world creation canceled");
             isCreatingGameWorld = false;
             return;
         }
@@ -774,10 +840,7 @@ void WorldGenScreen::gameWorldCreationThreadFunc() {
         
         // Check if we should stop
         if (shouldStopGameWorldCreation) {
-            std::lock_guard<std::mutex> lock(progressMutex);
-            latestProgress.progress = 0.0f;
-            latestProgress.message = "Game world creation canceled";
-            latestProgress.hasUpdate = true;
+            progressTracker->UpdateProgress(0.0f, "Game world creation canceled");
             isCreatingGameWorld = false;
             newWorld = nullptr; // Clean up if we're stopping
             return;
@@ -785,20 +848,14 @@ void WorldGenScreen::gameWorldCreationThreadFunc() {
         
         // Check if game world creation was successful
         if (!newWorld) {
-            std::lock_guard<std::mutex> lock(progressMutex);
-            latestProgress.progress = 0.0f;
-            latestProgress.message = "Failed to create game world";
-            latestProgress.hasUpdate = true;
+            progressTracker->ReportError("Failed to create game world");
             isCreatingGameWorld = false;
             return;
         }
         
         // Initialize the world (loads tiles into rendering system)
         if (!newWorld->initialize()) {
-            std::lock_guard<std::mutex> lock(progressMutex);
-            latestProgress.progress = 0.0f;
-            latestProgress.message = "Failed to initialize game world";
-            latestProgress.hasUpdate = true;
+            progressTracker->ReportError("Failed to initialize game world");
             isCreatingGameWorld = false;
             newWorld = nullptr;
             return;
@@ -808,24 +865,17 @@ void WorldGenScreen::gameWorldCreationThreadFunc() {
         progressTracker->CompletePhase();
         progressTracker->StartPhase("Finalizing");
         
-        std::lock_guard<std::mutex> lock(progressMutex);
-        latestProgress.progress = 1.0f;
-        latestProgress.message = "Game world creation complete!";
-        latestProgress.hasUpdate = true;
+        // Clear the flag before the final update, so the UI sees both together
+        isCreatingGameWorld = false;
+        progressTracker->UpdateProgress(1.0f, "Game world creation complete!");
     }
     catch (const std::exception& e) {
         // Handle any exceptions
-        std::lock_guard<std::mutex> lock(progressMutex);
-        latestProgress.progress = 0.0f;
-        latestProgress.message = std::string("Error: ") + e.what();
-        latestProgress.hasUpdate = true;
+        progressTracker->ReportError(e.what());
     }
     catch (...) {
         // Handle unknown exceptions
-        std::lock_guard<std::mutex> lock(progressMutex);
-        latestProgress.progress = 0.0f;
-        latestProgress.message = "Unknown error during game world creation";
-        latestProgress.hasUpdate = true;
+        progressTracker->ReportError("Unknown error during game world creation");
     }
     
     isCreatingGameWorld = false;
@@ -838,18 +888,17 @@ void WorldGenScreen::processProgressMessages() {
     std::string message;
     bool gameWorldComplete = false; // Flag to check if game world creation is complete
     
-    {
-        std::lock_guard<std::mutex> lock(progressMutex);
-        if (latestProgress.hasUpdate) {
-            hasUpdate = true;
-            progress = latestProgress.progress;
-            message = latestProgress.message;
-            latestProgress.hasUpdate = false; // Reset the flag
-            
-            // Check if game world creation is complete
-            if (progress == 1.0f && isCreatingGameWorld == false && newWorld != nullptr) {
-                gameWorldComplete = true;
-            }
+    // Poll the tracker; the message is only formatted when something changed
+    uint64_t updateCount = progressTracker->GetUpdateCount();
+    if (updateCount != lastProgressUpdate) {
+        lastProgressUpdate = updateCount;
+        hasUpdate = true;
+        progress = progressTracker->GetOverallProgress();
+        message = progressTracker->GetCurrentMessage();
+        
+        // Check if game world creation is complete
+        if (progress == 1.0f && isCreatingGameWorld == false && newWorld != nullptr) {
+            gameWorldComplete = true;
         }
     }
     
@@ -860,8 +909,14 @@ void WorldGenScreen::processProgressMessages() {
         
         // Special handling for world generation completion message
         if (progress == 1.0f && worldGenerated && !isCreatingGameWorld && !gameWorldComplete) {
-            // Update the world renderer now that generation is complete
+            // Update the world renderer now that generation is complete; after
+            // a preview this only uploads the attributes that changed
             worldRenderer->SetWorld(world.get());
+            showingPreview = false;
+            {
+                std::lock_guard<std::mutex> lock(previewMutex);
+                pendingPreview.reset();
+            }
             worldGenUI->setState(WorldGen::UIState::Viewing);
             
             // Update UI and stars
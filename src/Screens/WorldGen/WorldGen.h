@@ -11,6 +11,8 @@
 #include "UI/WorldGenUI.h" // Updated path
 #include "Generators/World.h"
 #include "Generators/Generator.h"
+#include "Generators/TaskGraph.h"
+#include "Generators/SpeculativeWorldPool.h"
 #include "Generators/TectonicPlates.h" // Add tectonic plates
 #include "Renderers/World.h"
 #include "Renderers/LandingLocation.h" // Add LandingLocation
@@ -88,7 +90,15 @@ private:
     static std::unordered_map<GLFWwindow*, WorldGenScreen*> instances;    // Thread management
     std::thread generationThread;
     std::atomic<bool> isGenerating{false};
-    std::atomic<bool> shouldStopGeneration{false};
+    WorldGen::Generators::CancellationToken generationCancellation; // Stops CreateWorld at its next check
+    
+    // Newest snapshot published by the generation thread, picked up by render()
+    std::mutex previewMutex;
+    std::shared_ptr<const WorldGen::Generators::WorldPreview> pendingPreview;
+    bool showingPreview = false; // Whether the renderer shows a preview rather than the finished world
+    
+    // Worlds built ahead of time for the next rerolls (null unless enabled in the config)
+    std::unique_ptr<WorldGen::Generators::SpeculativeWorldPool> worldPool;
 
     // Game world creation thread
     std::thread gameWorldThread;
@@ -106,14 +116,11 @@ private:
     };
     GameWorldCreationParams gameWorldParams;
     
-    // Replace queue with single latest update
-    struct ProgressMessage {
-        float progress;
-        std::string message;
-        bool hasUpdate = false;  // Flag to indicate if there's a new update
-    };
-    ProgressMessage latestProgress;
-    std::mutex progressMutex;
+    // Update count of the progress tracker when the UI last showed it
+    uint64_t lastProgressUpdate = 0;
+    
+    // Generate the world for currentSeed, or show readyWorld if it was already built for that seed
+    void startWorldGeneration(std::unique_ptr<WorldGen::Generators::World> readyWorld = nullptr);
     
     // Thread worker methods
     void worldGenerationThreadFunc();
@@ -0,0 +1,122 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/Screens/WorldGen/Generators/Biome.h"
+#include "../../src/Screens/WorldGen/Generators/TaskGraph.h"
+
+using namespace WorldGen;
+using namespace WorldGen::Generators;
+
+namespace {
+
+constexpr size_t kTerrainBins = static_cast<size_t>(TerrainType::Volcano) + 1;
+constexpr size_t kBiomeBins = static_cast<size_t>(BiomeType::Reef) + 1;
+constexpr float kSeaLevel = 6371000.0f;
+
+// Attribute columns for a synthetic planet
+struct TileColumns {
+    std::vector<float> elevation;
+    std::vector<float> temperature;
+    std::vector<float> moisture;
+    std::vector<TerrainType> terrain;
+    std::vector<BiomeType> biome;
+};
+
+struct ClassificationHistograms {
+    Histogram<kTerrainBins> terrain;
+    Histogram<kBiomeBins> biome;
+};
+
+TileColumns createTileColumns(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> height(-6000.0f, 6000.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    TileColumns columns;
+    columns.elevation.resize(count);
+    columns.temperature.resize(count);
+    columns.moisture.resize(count);
+    columns.terrain.resize(count);
+    columns.biome.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        columns.elevation[i] = kSeaLevel + height(rng);
+        columns.temperature[i] = unit(rng);
+        columns.moisture[i] = unit(rng);
+    }
+    return columns;
+}
+
+// The classification pass from GenerateBiomes, over flat columns
+ClassificationHistograms classifyTiles(ThreadPool& pool, TileColumns& columns) {
+    return pool.ParallelReduce(columns.elevation.size(), ClassificationHistograms{},
+        [&](size_t begin, size_t end, ClassificationHistograms& local) {
+            for (size_t i = begin; i < end; ++i) {
+                TerrainType terrain = DetermineTerrainType(columns.elevation[i], kSeaLevel);
+                BiomeType biome = DetermineBiomeType(columns.elevation[i], columns.temperature[i], columns.moisture[i], terrain);
+                columns.terrain[i] = terrain;
+                columns.biome[i] = biome;
+                local.terrain.Add(static_cast<size_t>(terrain));
+                local.biome.Add(static_cast<size_t>(biome));
+            }
+        },
+        [](ClassificationHistograms& total, const ClassificationHistograms& range) {
+            total.terrain += range.terrain;
+            total.biome += range.biome;
+        });
+}
+
+// Thread counts to measure: 1, 2, 4, ... up to the hardware thread count
+std::vector<size_t> threadCounts() {
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+} // namespace
+
+TEST_CASE("Parallel classification matches a serial pass", "[worldgen][parallel]") {
+    TileColumns columns = createTileColumns(100000);
+
+    ThreadPool serialPool(0);
+    ClassificationHistograms expected = classifyTiles(serialPool, columns);
+    std::vector<TerrainType> expectedTerrain = columns.terrain;
+    std::vector<BiomeType> expectedBiome = columns.biome;
+
+    size_t total = 0;
+    for (size_t count : expected.terrain.counts) {
+        total += count;
+    }
+    REQUIRE(total == columns.elevation.size());
+
+    for (size_t threads : {2, 3, 8}) {
+        DYNAMIC_SECTION("Threads: " << threads) {
+            ThreadPool pool(threads - 1);
+            ClassificationHistograms result = classifyTiles(pool, columns);
+
+            REQUIRE(result.terrain.counts == expected.terrain.counts);
+            REQUIRE(result.biome.counts == expected.biome.counts);
+            REQUIRE(columns.terrain == expectedTerrain);
+            REQUIRE(columns.biome == expectedBiome);
+        }
+    }
+}
+
+TEST_CASE("Parallel classification scaling", "[benchmark][scaling][worldgen]") {
+    // About the tile count of a level 9 planet
+    TileColumns columns = createTileColumns(2621442);
+
+    for (size_t threads : threadCounts()) {
+        ThreadPool pool(threads - 1);
+        BENCHMARK("Classify " + std::to_string(columns.elevation.size()) + " tiles on " + std::to_string(threads) + " threads") {
+            return classifyTiles(pool, columns).terrain[0];
+        };
+    }
+}
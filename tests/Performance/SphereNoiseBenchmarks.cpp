@@ -0,0 +1,139 @@
+#include <catch.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "../../src/Screens/WorldGen/Generators/SphereNoise.h"
+#include "../../src/Screens/WorldGen/Generators/TerrainGenerator.h"
+
+using namespace WorldGen::Generators;
+
+namespace {
+
+std::vector<glm::vec3> createSpherePoints(size_t count) {
+    std::mt19937 rng(99);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<glm::vec3> points(count);
+    for (auto& point : points) {
+        point = glm::normalize(glm::vec3(normal(rng), normal(rng), normal(rng)));
+    }
+    return points;
+}
+
+const char* backendName(NoiseBackend backend) {
+    switch (backend) {
+        case NoiseBackend::SSE41: return "SSE4.1";
+        case NoiseBackend::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+std::vector<NoiseBackend> supportedBackends() {
+    std::vector<NoiseBackend> backends;
+    for (NoiseBackend backend : {NoiseBackend::Scalar, NoiseBackend::SSE41, NoiseBackend::AVX2}) {
+        if (IsNoiseBackendSupported(backend)) {
+            backends.push_back(backend);
+        }
+    }
+    return backends;
+}
+
+// Samples per second for one call of work over count samples, best of a few runs
+template <typename Work>
+double samplesPerSecond(size_t count, Work&& work) {
+    double bestSeconds = 1e30;
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::high_resolution_clock::now();
+        work();
+        auto end = std::chrono::high_resolution_clock::now();
+        bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(end - start).count());
+    }
+    return count / bestSeconds;
+}
+
+} // namespace
+
+TEST_CASE("Noise backends match the scalar samples", "[worldgen][noise]") {
+    // An odd count so every backend also runs its padded tail batch
+    std::vector<glm::vec3> points = createSpherePoints(10007);
+
+    for (NoiseBasis basis : {NoiseBasis::Simplex, NoiseBasis::Value}) {
+        for (NoiseFractal fractal : {NoiseFractal::None, NoiseFractal::FBm, NoiseFractal::Ridged}) {
+            NoiseSettings settings;
+            settings.basis = basis;
+            settings.fractal = fractal;
+            settings.frequency = 3.0f;
+            settings.seed = 17;
+
+            std::vector<float> expected(points.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                expected[i] = SampleNoise(points[i], settings);
+            }
+
+            for (NoiseBackend backend : supportedBackends()) {
+                DYNAMIC_SECTION("Basis " << static_cast<int>(basis) << ", fractal " << static_cast<int>(fractal)
+                                << ", " << backendName(backend)) {
+                    std::vector<float> values(points.size(), NAN);
+                    FillNoise(points, settings, values, backend);
+                    for (size_t i = 0; i < points.size(); ++i) {
+                        REQUIRE(values[i] == expected[i]);
+                    }
+                }
+            }
+
+            float low = fractal == NoiseFractal::Ridged ? 0.0f : -1.1f;
+            for (float value : expected) {
+                REQUIRE(value >= low);
+                REQUIRE(value <= 1.1f);
+            }
+        }
+    }
+}
+
+TEST_CASE("Sphere noise throughput", "[benchmark][noise]") {
+    const size_t count = 1 << 20;
+    std::vector<glm::vec3> points = createSpherePoints(count);
+    std::vector<float> values(count);
+
+    NoiseSettings settings;
+    settings.octaves = 4;
+    settings.frequency = 4.0f;
+
+    SECTION("Samples per second") {
+        // The existing 2D scalar fBm, sampled on longitude/latitude
+        double legacyRate = samplesPerSecond(count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                float longitude = std::atan2(points[i].z, points[i].x);
+                float latitude = std::asin(points[i].y);
+                values[i] = TerrainGenerator::fbm(longitude * 4.0f, latitude * 4.0f, settings.octaves, 0.5f, 0);
+            }
+        });
+        WARN("TerrainGenerator::fbm (2D scalar): " << legacyRate / 1e6 << " M samples/s");
+
+        for (NoiseBackend backend : supportedBackends()) {
+            double rate = samplesPerSecond(count, [&]() { FillNoise(points, settings, values, backend); });
+            WARN("FillNoise 3D simplex fBm (" << backendName(backend) << "): " << rate / 1e6 << " M samples/s, "
+                 << rate / legacyRate << "x the 2D scalar fBm");
+        }
+    }
+
+    SECTION("Benchmark each backend") {
+        BENCHMARK("TerrainGenerator::fbm, " + std::to_string(count) + " samples") {
+            float sum = 0.0f;
+            for (size_t i = 0; i < count; ++i) {
+                sum += TerrainGenerator::fbm(points[i].x * 4.0f, points[i].z * 4.0f, settings.octaves, 0.5f, 0);
+            }
+            return sum;
+        };
+
+        for (NoiseBackend backend : supportedBackends()) {
+            BENCHMARK(std::string("FillNoise (") + backendName(backend) + "), " + std::to_string(count) + " samples") {
+                FillNoise(points, settings, values, backend);
+                return values[0];
+            };
+        }
+    }
+}
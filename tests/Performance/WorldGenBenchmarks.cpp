@@ -0,0 +1,328 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../../src/Screens/WorldGen/Core/ChunkGenerator.h"
+#include "../../src/Screens/WorldGen/Core/MemoryUsage.h"
+#include "../../src/Screens/WorldGen/Generators/Generator.h"
+#include "../../src/Screens/WorldGen/Generators/GeometryCache.h"
+#include "../../src/Screens/WorldGen/Generators/PhaseCache.h"
+#include "../../src/Screens/WorldGen/Generators/TaskGraph.h"
+#include "../../src/Screens/WorldGen/Generators/TileOrdering.h"
+#include "../../src/Screens/WorldGen/ProgressTracker.h"
+
+using namespace WorldGen;
+using namespace WorldGen::Generators;
+
+namespace {
+
+constexpr uint64_t kSeed = 12345;
+constexpr int kChunkWorldLevel = 6;
+constexpr double kBytesPerMB = 1024.0 * 1024.0;
+
+using Clock = std::chrono::steady_clock;
+
+// Wall-time budgets of the erosion and climate phases. They always run to
+// completion (erosion all of its iterations, climate to convergence), so the
+// budgets are checked here rather than cut short at runtime.
+constexpr double kErosionBudgetMsPer1000Tiles = 2.0;
+constexpr double kClimateBudgetMsPer1000Tiles = 3.0;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// The resolution that asks for exactly this subdivision level (its tile count)
+int resolutionForLevel(int level) {
+    return 10 * (1 << (2 * level)) + 2;
+}
+
+// Fewer runs for the big levels, which take seconds each
+int runsForLevel(int level) {
+    return level <= 6 ? 5 : (level == 7 ? 3 : 1);
+}
+
+// Results of every [worldgen][benchmark] case, written out after each case
+// so a filtered run still leaves a complete file. Only the
+// run_worldgen_benchmarks target writes them, to the path it sets in
+// WORLDGEN_BENCHMARK_JSON.
+nlohmann::json& report() {
+    static nlohmann::json json = {
+        {"seed", kSeed},
+        {"threads", ThreadPool::GetInstance().GetConcurrency()},
+    };
+    return json;
+}
+
+void writeReport() {
+    const char* path = std::getenv("WORLDGEN_BENCHMARK_JSON");
+    if (!path || !*path) {
+        return;
+    }
+    std::ofstream file(path);
+    file << report().dump(2) << std::endl;
+}
+
+// Generate without the geometry and phase caches, which would otherwise skip
+// the work after the first run
+std::unique_ptr<World> generateCold(int level, double& totalMs) {
+    GeometryCache::GetInstance().Clear();
+    PhaseCache::GetInstance().Clear();
+
+    PlanetParameters params;
+    params.resolution = resolutionForLevel(level);
+    auto start = Clock::now();
+    auto world = Generator::CreateWorld(params, kSeed, std::make_shared<ProgressTracker>());
+    totalMs = elapsedMs(start);
+    return world;
+}
+
+double phaseWallMs(const std::vector<PhaseTiming>& timings, const std::string& name) {
+    auto timing = std::find_if(timings.begin(), timings.end(), [&](const PhaseTiming& t) { return t.name == name; });
+    return timing != timings.end() ? timing->wallMs : 0.0;
+}
+
+nlohmann::json phaseJson(const std::vector<PhaseTiming>& timings) {
+    nlohmann::json phases = nlohmann::json::array();
+    for (const PhaseTiming& timing : timings) {
+        phases.push_back({{"name", timing.name}, {"wallMs", timing.wallMs}, {"cpuMs", timing.cpuMs}});
+    }
+    return phases;
+}
+
+bool isWater(const Tile& tile) {
+    return tile.GetTerrainType() == TerrainType::Ocean || tile.GetTerrainType() == TerrainType::Shallow;
+}
+
+// A point on the border between two tiles, so the chunk there spans both
+glm::vec3 borderBetween(const World& world, int a, int b) {
+    return glm::normalize(world.GetTiles()[a].GetCenter() + world.GetTiles()[b].GetCenter());
+}
+
+struct ChunkLocation {
+    std::string name;
+    int worldTile = -1;
+    glm::vec3 center{0.0f};
+};
+
+// Open ocean (the deepest tile surrounded by ocean), a coastline (the first
+// land tile next to water) and mountains (the highest tile, on the border to
+// its highest neighbor)
+std::vector<ChunkLocation> findChunkLocations(const World& world) {
+    const auto& tiles = world.GetTiles();
+    int ocean = -1, coast = -1, coastWater = -1, peak = 0;
+    for (int i = 0; i < static_cast<int>(tiles.size()); ++i) {
+        const Tile& tile = tiles[i];
+        const auto neighbors = tile.GetNeighbors();
+        bool openOcean = tile.GetTerrainType() == TerrainType::Ocean &&
+                         std::all_of(neighbors.begin(), neighbors.end(), [&](int n) { return isWater(tiles[n]); });
+        if (openOcean && (ocean < 0 || tile.GetElevation() < tiles[ocean].GetElevation())) {
+            ocean = i;
+        }
+        if (coast < 0 && !isWater(tile)) {
+            auto water = std::find_if(neighbors.begin(), neighbors.end(), [&](int n) { return isWater(tiles[n]); });
+            if (water != neighbors.end()) {
+                coast = i;
+                coastWater = *water;
+            }
+        }
+        if (tile.GetElevation() > tiles[peak].GetElevation()) {
+            peak = i;
+        }
+    }
+
+    std::vector<ChunkLocation> locations;
+    if (ocean >= 0) {
+        locations.push_back({"ocean", ocean, tiles[ocean].GetCenter()});
+    }
+    if (coast >= 0) {
+        locations.push_back({"coast", coast, borderBetween(world, coast, coastWater)});
+    }
+    const auto peakNeighbors = tiles[peak].GetNeighbors();
+    int ridge = *std::max_element(peakNeighbors.begin(), peakNeighbors.end(), [&](int a, int b) {
+        return tiles[a].GetElevation() < tiles[b].GetElevation();
+    });
+    locations.push_back({"mountains", peak, borderBetween(world, peak, ridge)});
+    return locations;
+}
+
+std::vector<glm::vec3> createSpherePoints(size_t count) {
+    std::mt19937 rng(99);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<glm::vec3> points(count);
+    for (auto& point : points) {
+        point = glm::normalize(glm::vec3(normal(rng), normal(rng), normal(rng)));
+    }
+    return points;
+}
+
+} // namespace
+
+// The benchmarks generate worlds of up to 2.6M tiles, so they are hidden from
+// the default run; use the run_worldgen_benchmarks target or the [benchmark] tag
+TEST_CASE("World generation by subdivision level", "[.benchmark][worldgen]") {
+    nlohmann::json levels = nlohmann::json::array();
+
+    for (int level = 4; level <= 9; ++level) {
+        const int runs = runsForLevel(level);
+        double bestMs = 1e30;
+        size_t tiles = 0;
+        std::vector<PhaseTiming> bestPhases;
+        for (int run = 0; run < runs; ++run) {
+            double totalMs = 0.0;
+            auto world = generateCold(level, totalMs);
+            REQUIRE(world);
+            if (totalMs < bestMs) {
+                bestMs = totalMs;
+                bestPhases = world->GetPhaseTimings();
+            }
+            tiles = world->GetTileCount();
+        }
+        const double peakMB = Core::getPeakResidentMemoryBytes() / kBytesPerMB;
+
+        levels.push_back({
+            {"subdivisionLevel", level},
+            {"tiles", tiles},
+            {"runs", runs},
+            {"totalMs", bestMs},
+            {"msPer1000Tiles", bestMs * 1000.0 / tiles},
+            {"phases", phaseJson(bestPhases)},
+            {"peakResidentMB", peakMB}, // Process peak so far, so it follows the largest level generated
+        });
+        WARN("Level " << level << ": " << tiles << " tiles in " << bestMs << " ms (best of " << runs << "), peak RSS "
+             << peakMB << " MB");
+
+        const double erosionMs = phaseWallMs(bestPhases, "Erosion");
+        INFO("Level " << level << " erosion: " << erosionMs << " ms");
+        CHECK(erosionMs <= kErosionBudgetMsPer1000Tiles * tiles / 1000.0);
+        const double climateMs = phaseWallMs(bestPhases, "Climate");
+        INFO("Level " << level << " climate: " << climateMs << " ms");
+        CHECK(climateMs <= kClimateBudgetMsPer1000Tiles * tiles / 1000.0);
+    }
+
+    report()["generation"] = levels;
+    writeReport();
+}
+
+TEST_CASE("Tile renumbering along the Hilbert curve", "[.benchmark][worldgen]") {
+    nlohmann::json levels = nlohmann::json::array();
+
+    for (int level = 6; level <= 8; ++level) {
+        // Bare geometry, so the walk before renumbering sees the order TrianglesToTiles produces
+        PlanetParameters params;
+        auto progressTracker = std::make_shared<ProgressTracker>();
+        World world(params, kSeed, progressTracker);
+        world.Generate(level, params.distortionFactor, progressTracker);
+
+        const TileLocality before = MeasureTileLocality(world);
+        auto start = Clock::now();
+        RenumberTilesAlongHilbertCurve(&world);
+        const double renumberMs = elapsedMs(start);
+        const TileLocality after = MeasureTileLocality(world);
+
+        levels.push_back({
+            {"subdivisionLevel", level},
+            {"tiles", world.GetTileCount()},
+            {"renumberMs", renumberMs},
+            {"neighborWalkMsBefore", before.neighborWalkMs},
+            {"neighborWalkMsAfter", after.neighborWalkMs},
+            {"meanNeighborDistanceBefore", before.meanNeighborDistance},
+            {"meanNeighborDistanceAfter", after.meanNeighborDistance},
+        });
+        WARN("Level " << level << ": renumbered " << world.GetTileCount() << " tiles in " << renumberMs
+             << " ms, neighbour walk " << before.neighborWalkMs << " -> " << after.neighborWalkMs
+             << " ms, mean neighbour distance " << before.meanNeighborDistance << " -> "
+             << after.meanNeighborDistance);
+        CHECK(after.meanNeighborDistance < before.meanNeighborDistance);
+    }
+
+    report()["tileOrdering"] = levels;
+    writeReport();
+}
+
+TEST_CASE("Chunk generation at representative locations", "[.benchmark][worldgen]") {
+    double worldMs = 0.0;
+    auto world = generateCold(kChunkWorldLevel, worldMs);
+    REQUIRE(world);
+    std::vector<ChunkLocation> locations = findChunkLocations(*world);
+
+    SECTION("Chunks") {
+        nlohmann::json chunks = nlohmann::json::array();
+        for (const ChunkLocation& location : locations) {
+            auto start = Clock::now();
+            auto chunk = Core::ChunkGenerator::generateChunk(*world, location.center);
+            const double ms = elapsedMs(start);
+            REQUIRE(chunk);
+            REQUIRE(!chunk->tiles.empty());
+
+            const double samplesPerTile = static_cast<double>(chunk->sampleCount) / chunk->tiles.size();
+            chunks.push_back({
+                {"location", location.name},
+                {"worldTile", location.worldTile},
+                {"chunkTiles", chunk->tiles.size()},
+                {"samples", chunk->sampleCount},
+                {"samplesPerTile", samplesPerTile},
+                {"ms", ms},
+            });
+            WARN("Chunk (" << location.name << "): " << chunk->tiles.size() << " tiles, " << samplesPerTile
+                 << " samples per tile, " << ms << " ms");
+        }
+        report()["chunks"] = {{"worldTiles", world->GetTileCount()}, {"locations", chunks}};
+        writeReport();
+    }
+
+    SECTION("FindTileContainingPoint") {
+        // Global searches, then a walk of 100 m steps along a great circle, the
+        // way chunk sampling moves from one lookup to the next
+        std::vector<glm::vec3> points = createSpherePoints(2000);
+        auto start = Clock::now();
+        int found = 0;
+        for (const glm::vec3& point : points) {
+            found += world->FindTileContainingPoint(point) >= 0;
+        }
+        const double globalNs = elapsedMs(start) * 1e6 / points.size();
+        REQUIRE(found == static_cast<int>(points.size()));
+
+        const glm::vec3 origin = locations.back().center;
+        const glm::vec3 east = Core::ChunkGenerator::createLocalTangentBasis(origin)[0];
+        const float stepRadians = 100.0f / PlanetParameters().physicalRadiusMeters;
+        std::vector<glm::vec3> walk(100000);
+        for (size_t i = 0; i < walk.size(); ++i) {
+            float angle = static_cast<float>(i) * stepRadians;
+            walk[i] = std::cos(angle) * origin + std::sin(angle) * east;
+        }
+        start = Clock::now();
+        int tile = -1;
+        for (const glm::vec3& point : walk) {
+            tile = world->FindTileContainingPoint(point, tile);
+        }
+        const double walkNs = elapsedMs(start) * 1e6 / walk.size();
+        REQUIRE(tile >= 0);
+
+        report()["findTileContainingPoint"] = {
+            {"worldTiles", world->GetTileCount()},
+            {"globalNsPerLookup", globalNs},
+            {"walkNsPerLookup", walkNs},
+        };
+        writeReport();
+        WARN("FindTileContainingPoint: " << globalNs << " ns global, " << walkNs << " ns walking");
+
+        BENCHMARK("FindTileContainingPoint walk, " + std::to_string(walk.size()) + " points") {
+            int current = -1;
+            for (const glm::vec3& point : walk) {
+                current = world->FindTileContainingPoint(point, current);
+            }
+            return current;
+        };
+    }
+}
@@ -0,0 +1,190 @@
+#include <catch.hpp>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "../../src/Screens/WorldGen/Generators/Classification.h"
+
+using namespace WorldGen;
+using namespace WorldGen::Generators;
+
+namespace {
+
+// The if-ladders the classifiers replaced, kept here as the reference rules
+
+TerrainType referenceTerrainType(float elevation, float waterLevel, const std::array<float, 6>& offsets) {
+    if (elevation < waterLevel + offsets[0]) {
+        return TerrainType::Ocean;
+    } else if (elevation < waterLevel + offsets[1]) {
+        return TerrainType::Shallow;
+    } else if (elevation < waterLevel + offsets[2]) {
+        return TerrainType::Beach;
+    } else if (elevation < waterLevel + offsets[3]) {
+        return TerrainType::Lowland;
+    } else if (elevation < waterLevel + offsets[4]) {
+        return TerrainType::Highland;
+    } else if (elevation < waterLevel + offsets[5]) {
+        return TerrainType::Mountain;
+    } else {
+        return TerrainType::Peak;
+    }
+}
+
+BiomeType referenceBiomeType(float elevation, float temperature, float moisture, TerrainType terrainType) {
+    if (terrainType == TerrainType::Ocean) {
+        return BiomeType::DeepOcean;
+    } else if (terrainType == TerrainType::Shallow) {
+        if (temperature > 0.8f && moisture > 0.7f) {
+            return BiomeType::Reef;
+        }
+        return BiomeType::Ocean;
+    }
+
+    if (temperature < 0.2f) {
+        if (elevation > 0.8f) {
+            return BiomeType::AlpineTundra;
+        } else if (moisture < 0.2f) {
+            return BiomeType::PolarDesert;
+        } else {
+            return BiomeType::ArcticTundra;
+        }
+    }
+
+    if (temperature < 0.4f) {
+        return moisture > 0.4f ? BiomeType::BorealForest : BiomeType::ColdDesert;
+    }
+
+    if (temperature < 0.6f) {
+        if (moisture > 0.7f) {
+            return BiomeType::TemperateRainforest;
+        } else if (moisture > 0.4f) {
+            return BiomeType::TemperateDeciduousForest;
+        } else if (moisture > 0.2f) {
+            return BiomeType::TemperateGrassland;
+        } else {
+            return BiomeType::XericShrubland;
+        }
+    }
+
+    if (temperature < 0.8f) {
+        if (moisture > 0.6f) {
+            return BiomeType::TropicalSeasonalForest;
+        } else if (moisture > 0.3f) {
+            return BiomeType::TropicalSavanna;
+        } else if (moisture > 0.1f) {
+            return BiomeType::SemiDesert;
+        } else {
+            return BiomeType::HotDesert;
+        }
+    }
+
+    if (moisture > 0.7f) {
+        return BiomeType::TropicalRainforest;
+    } else if (moisture > 0.4f) {
+        return BiomeType::TropicalSeasonalForest;
+    } else if (moisture > 0.2f) {
+        return BiomeType::TropicalSavanna;
+    } else {
+        return BiomeType::HotDesert;
+    }
+}
+
+// Each threshold plus the floats on either side of it
+std::vector<float> thresholdProbes(std::initializer_list<float> thresholds) {
+    std::vector<float> probes = {-1.0f, 0.0f, 0.5f, 1.0f, 2.0f};
+    for (float threshold : thresholds) {
+        probes.push_back(std::nextafter(threshold, -INFINITY));
+        probes.push_back(threshold);
+        probes.push_back(std::nextafter(threshold, INFINITY));
+    }
+    return probes;
+}
+
+} // namespace
+
+TEST_CASE("Terrain classifier matches the elevation ladder", "[worldgen][classification]") {
+    SECTION("Meters around a planet radius") {
+        const float waterLevel = 6371000.0f;
+        TerrainClassifier classifier(waterLevel, kMeterTerrainBands);
+
+        for (float offset : kMeterTerrainBands.offsets) {
+            float bound = waterLevel + offset;
+            for (float elevation : {std::nextafter(bound, -INFINITY), bound, std::nextafter(bound, INFINITY)}) {
+                REQUIRE(classifier.Classify(elevation) == referenceTerrainType(elevation, waterLevel, kMeterTerrainBands.offsets));
+            }
+        }
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> elevation(waterLevel - 10000.0f, waterLevel + 10000.0f);
+        for (int i = 0; i < 100000; ++i) {
+            float value = elevation(rng);
+            REQUIRE(classifier.Classify(value) == referenceTerrainType(value, waterLevel, kMeterTerrainBands.offsets));
+        }
+    }
+
+    SECTION("Normalized elevations") {
+        for (float waterLevel : {0.3f, 0.4f, 0.5f}) {
+            TerrainClassifier classifier(waterLevel, kNormalizedTerrainBands);
+
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> elevation(-0.5f, 1.5f);
+            std::vector<float> elevations(10000);
+            for (float& value : elevations) {
+                value = elevation(rng);
+            }
+            for (float offset : kNormalizedTerrainBands.offsets) {
+                elevations.push_back(waterLevel + offset);
+            }
+
+            std::vector<TerrainType> terrainTypes(elevations.size());
+            classifier.Classify(elevations, terrainTypes);
+            for (size_t i = 0; i < elevations.size(); ++i) {
+                REQUIRE(terrainTypes[i] == referenceTerrainType(elevations[i], waterLevel, kNormalizedTerrainBands.offsets));
+            }
+        }
+    }
+}
+
+TEST_CASE("Biome classifier matches the biome rules", "[worldgen][classification]") {
+    const BiomeClassifier& classifier = BiomeClassifier::GetInstance();
+
+    SECTION("Every threshold and its neighbors") {
+        std::vector<float> elevations = thresholdProbes({0.8f});
+        std::vector<float> temperatures = thresholdProbes({0.2f, 0.4f, 0.6f, 0.8f});
+        std::vector<float> moistures = thresholdProbes({0.1f, 0.2f, 0.3f, 0.4f, 0.6f, 0.7f});
+
+        for (int terrain = 0; terrain <= static_cast<int>(TerrainType::Volcano); ++terrain) {
+            TerrainType terrainType = static_cast<TerrainType>(terrain);
+            for (float elevation : elevations) {
+                for (float temperature : temperatures) {
+                    for (float moisture : moistures) {
+                        REQUIRE(classifier.Classify(elevation, temperature, moisture, terrainType) ==
+                                referenceBiomeType(elevation, temperature, moisture, terrainType));
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Random columns") {
+        const size_t count = 100000;
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_int_distribution<int> terrain(0, static_cast<int>(TerrainType::Volcano));
+
+        std::vector<float> elevations(count), temperatures(count), moistures(count);
+        std::vector<TerrainType> terrainTypes(count);
+        for (size_t i = 0; i < count; ++i) {
+            elevations[i] = unit(rng);
+            temperatures[i] = unit(rng);
+            moistures[i] = unit(rng);
+            terrainTypes[i] = static_cast<TerrainType>(terrain(rng));
+        }
+
+        std::vector<BiomeType> biomeTypes(count);
+        classifier.Classify(elevations, temperatures, moistures, terrainTypes, biomeTypes);
+        for (size_t i = 0; i < count; ++i) {
+            REQUIRE(biomeTypes[i] == referenceBiomeType(elevations[i], temperatures[i], moistures[i], terrainTypes[i]));
+        }
+    }
+}
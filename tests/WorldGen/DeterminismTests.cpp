@@ -0,0 +1,295 @@
+#include <catch.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../../src/ConfigManager.h"
+#include "../../src/Screens/WorldGen/Core/ChunkGenerator.h"
+#include "../../src/Screens/WorldGen/Generators/Generator.h"
+#include "../../src/Screens/WorldGen/Generators/GeometryCache.h"
+#include "../../src/Screens/WorldGen/Generators/PhaseCache.h"
+#include "../../src/Screens/WorldGen/Generators/Plate.h"
+#include "../../src/Screens/WorldGen/Generators/TaskGraph.h"
+#include "../../src/Screens/WorldGen/Generators/WorldPreview.h"
+#include "../../src/Screens/WorldGen/ProgressTracker.h"
+
+using namespace WorldGen;
+using namespace WorldGen::Generators;
+
+namespace {
+
+// Output columns in the order the pipeline writes them, so the first column
+// that differs names the phase where a divergence starts
+enum Column {
+    GeometryColumn,         // Tile centers, corners and neighbors
+    PlatesColumn,           // Plates and the plate of every tile
+    UpliftColumn,           // Elevations after margins and mountains (from the elevation preview)
+    ElevationColumn,        // Elevations after erosion
+    ClimateColumn,          // Temperature and moisture
+    ClassificationColumn,   // Terrain and biome types
+    HydrologyColumn,        // Flow directions, discharge and lakes
+    ColumnCount
+};
+
+const char* const kColumnNames[ColumnCount] = {
+    "geometry", "plates", "uplift", "elevation", "climate", "classification", "hydrology"
+};
+
+using WorldHashes = std::array<uint64_t, ColumnCount>;
+
+// Generated worlds and their expected column hashes
+struct WorldGolden {
+    int resolution;
+    uint64_t seed;
+    WorldHashes hashes;
+};
+
+// Where a chunk is generated: the center of a world tile, or the point halfway
+// to its first neighbor. Chunks on a border span two tiles, so they sample
+// every game tile instead of filling from the perimeter.
+struct ChunkGolden {
+    int tileIndex;
+    bool onBorder;
+    uint64_t hash;
+};
+
+// The hashes cover exact float bits, so they only hold for the toolchain
+// they were recorded with (GCC on x86-64 Linux). A failing case prints its
+// actual row; paste it here when a change to the output is intended.
+const WorldGolden kWorldGoldens[] = {
+    {1000, 12345, {0xee378d0db333050full, 0x548f6f13bb5addccull, 0x7c986281f1e44358ull, 0xf265714acdba62e2ull,
+                   0x3fb2ee097a4aea96ull, 0xacaddeab4661a0cfull, 0xdfb9eaf99a0b2230ull}},
+    {10000, 12345, {0xc1a98fe3569a0619ull, 0x371d9dbbf2b76812ull, 0xad0d31fa6223cd33ull, 0x236c17ce5484ad21ull,
+                    0x25cf109e1a63db6dull, 0x9f90bb4cf3c39cf8ull, 0xc415f4c58a088665ull}},
+    {10000, 987654, {0xc1a98fe3569a0619ull, 0xe3d59907199e39deull, 0x83edf29c509adf00ull, 0xef25011d5b374fffull,
+                     0x4aa91cddc7774f2bull, 0x4a4b5ea9bbc74e23ull, 0x35a27e567366c8d9ull}},
+    {40000, 12345, {0x3738549fef1dfd0cull, 0xe7f356d71b578d21ull, 0x15b1e9568b2a9e35ull, 0x4fee40db5319ebaaull,
+                    0x55be270ab6e84017ull, 0xb1475823e31fdd29ull, 0xf7e9ab9ccaad9fa7ull}},
+};
+
+// Chunks of the 10000-tile world for seed 12345, at the default chunk configuration
+constexpr int kChunkWorldResolution = 10000;
+constexpr uint64_t kChunkWorldSeed = 12345;
+const ChunkGolden kChunkGoldens[] = {
+    {0, false, 0x618a42c71cea5b99ull},
+    {1234, false, 0x37ca5f6046b3ab9dull},
+    {1234, true, 0x88f5b18bc6226602ull},
+};
+
+// 64-bit FNV-1a over the bytes of plain values
+class Fnv1a {
+public:
+    template <typename T>
+    void Add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Fnv1a hashes plain values only");
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (unsigned char byte : bytes) {
+            hash = (hash ^ byte) * 1099511628211ull;
+        }
+    }
+
+    uint64_t Get() const { return hash; }
+
+private:
+    uint64_t hash = 14695981039346656037ull;
+};
+
+uint64_t hashElevations(const std::vector<float>& elevations) {
+    Fnv1a hash;
+    for (float elevation : elevations) {
+        hash.Add(elevation);
+    }
+    return hash.Get();
+}
+
+WorldHashes hashWorld(const World& world, const WorldPreview* upliftPreview) {
+    const auto& tiles = world.GetTiles();
+    Fnv1a geometry, plates, elevation, climate, classification, hydrology;
+    for (const Tile& tile : tiles) {
+        geometry.Add(tile.GetCenter());
+        for (const glm::vec3& vertex : tile.GetVertices()) {
+            geometry.Add(vertex);
+        }
+        for (int neighbor : tile.GetNeighbors()) {
+            geometry.Add(neighbor);
+        }
+        plates.Add(tile.GetPlateId());
+        elevation.Add(tile.GetElevation());
+        climate.Add(tile.GetTemperature());
+        climate.Add(tile.GetMoisture());
+        classification.Add(tile.GetTerrainType());
+        classification.Add(tile.GetBiomeType());
+    }
+    for (const Plate& plate : world.GetPlates()) {
+        plates.Add(plate.center);
+        plates.Add(plate.movement);
+        plates.Add(plate.rotationRate);
+        plates.Add(plate.isOceanic);
+        plates.Add(plate.size);
+    }
+    const HydrologyData& water = world.GetHydrology();
+    for (size_t i = 0; i < water.flowDirection.size(); ++i) {
+        hydrology.Add(water.flowDirection[i]);
+        hydrology.Add(water.discharge[i]);
+        hydrology.Add(water.lakeId[i]);
+        hydrology.Add(water.waterSurface[i]);
+    }
+    hydrology.Add(water.lakeCount);
+
+    WorldHashes hashes{};
+    hashes[GeometryColumn] = geometry.Get();
+    hashes[PlatesColumn] = plates.Get();
+    hashes[UpliftColumn] = upliftPreview ? hashElevations(*upliftPreview->elevations) : 0;
+    hashes[ElevationColumn] = elevation.Get();
+    hashes[ClimateColumn] = climate.Get();
+    hashes[ClassificationColumn] = classification.Get();
+    hashes[HydrologyColumn] = hydrology.Get();
+    return hashes;
+}
+
+// Generate a world, from scratch unless asked to reuse what the process-wide
+// caches kept from the last world
+std::unique_ptr<World> generateWorld(int resolution, uint64_t seed, WorldHashes& hashes, bool useCaches = false) {
+    if (!useCaches) {
+        GeometryCache::GetInstance().Clear();
+        PhaseCache::GetInstance().Clear();
+    }
+
+    PlanetParameters params;
+    params.resolution = resolution;
+    std::shared_ptr<const WorldPreview> upliftPreview;
+    auto world = Generator::CreateWorld(params, seed, std::make_shared<ProgressTracker>(), nullptr,
+        [&upliftPreview](std::shared_ptr<const WorldPreview> preview) {
+            if (preview->stage == WorldPreview::Stage::Elevation) {
+                upliftPreview = std::move(preview);
+            }
+        });
+    REQUIRE(world);
+    REQUIRE(upliftPreview);
+    hashes = hashWorld(*world, upliftPreview.get());
+    return world;
+}
+
+uint64_t hashChunk(const Core::ChunkData& chunk, int chunkSize) {
+    Fnv1a hash;
+    for (int y = 0; y < chunkSize; ++y) {
+        for (int x = 0; x < chunkSize; ++x) {
+            auto it = chunk.tiles.find({x, y});
+            if (it == chunk.tiles.end()) {
+                hash.Add(-2); // Missing tile
+                continue;
+            }
+            const TerrainData& tile = it->second;
+            hash.Add(tile.type);
+            hash.Add(tile.height);
+            hash.Add(tile.resource);
+            hash.Add(tile.elevation);
+            hash.Add(tile.humidity);
+            hash.Add(tile.temperature);
+            hash.Add(tile.sourceWorldTileIndex);
+            hash.Add(tile.gamePosition);
+        }
+    }
+    return hash.Get();
+}
+
+std::string hex(uint64_t value) {
+    std::ostringstream out;
+    out << "0x" << std::hex << std::setw(16) << std::setfill('0') << value << "ull";
+    return out.str();
+}
+
+// Which columns differ, where the divergence starts, and the row to paste if it is intended
+std::string describeMismatch(const WorldGolden& golden, const WorldHashes& actual) {
+    std::ostringstream report;
+    int firstDivergent = -1;
+    for (int column = 0; column < ColumnCount; ++column) {
+        bool same = actual[column] == golden.hashes[column];
+        if (!same && firstDivergent < 0) {
+            firstDivergent = column;
+        }
+        report << "  " << std::left << std::setw(15) << kColumnNames[column] << hex(actual[column])
+               << (same ? "" : "  (expected " + hex(golden.hashes[column]) + ")") << "\n";
+    }
+    if (firstDivergent >= 0) {
+        report << "Divergence starts at: " << kColumnNames[firstDivergent] << "\n";
+    }
+    report << "Actual row: {" << golden.resolution << ", " << golden.seed << ", {";
+    for (int column = 0; column < ColumnCount; ++column) {
+        report << (column ? ", " : "") << hex(actual[column]);
+    }
+    report << "}},";
+    return report.str();
+}
+
+} // namespace
+
+TEST_CASE("World generation is repeatable and independent of thread count", "[worldgen][determinism]") {
+    WorldHashes expected;
+    generateWorld(10000, 4242, expected);
+
+    SECTION("Generating again") {
+        WorldHashes actual;
+        generateWorld(10000, 4242, actual);
+        REQUIRE(actual == expected);
+    }
+
+    SECTION("Generating on a single thread") {
+        ThreadPool serialPool(0);
+        ThreadPoolScope scope(&serialPool);
+        WorldHashes actual;
+        generateWorld(10000, 4242, actual);
+        REQUIRE(actual == expected);
+    }
+
+    SECTION("Generating from the caches") {
+        // Same parameters and seed, so every phase restores its cached output
+        WorldHashes actual;
+        generateWorld(10000, 4242, actual, true);
+        REQUIRE(actual == expected);
+    }
+}
+
+// Hidden from the default run because the hashes are toolchain-specific;
+// run it with the run_determinism target or the [determinism] tag
+TEST_CASE("World generation matches the golden hashes", "[worldgen][.determinism]") {
+    for (const WorldGolden& golden : kWorldGoldens) {
+        DYNAMIC_SECTION("Resolution " << golden.resolution << ", seed " << golden.seed) {
+            WorldHashes actual;
+            generateWorld(golden.resolution, golden.seed, actual);
+            INFO(describeMismatch(golden, actual));
+            CHECK(actual == golden.hashes);
+        }
+    }
+}
+
+TEST_CASE("Chunk generation matches the golden hashes", "[worldgen][.determinism]") {
+    WorldHashes worldHashes;
+    auto world = generateWorld(kChunkWorldResolution, kChunkWorldSeed, worldHashes);
+    const int chunkSize = ConfigManager::getInstance().getChunkSize();
+
+    for (const ChunkGolden& golden : kChunkGoldens) {
+        DYNAMIC_SECTION("Tile " << golden.tileIndex << (golden.onBorder ? " border" : " center")) {
+            REQUIRE(golden.tileIndex < static_cast<int>(world->GetTileCount()));
+            const Tile& tile = world->GetTiles()[golden.tileIndex];
+            glm::vec3 center = tile.GetCenter();
+            if (golden.onBorder) {
+                center += world->GetTiles()[tile.GetNeighbors()[0]].GetCenter();
+            }
+
+            auto chunk = Core::ChunkGenerator::generateChunk(*world, glm::normalize(center));
+            REQUIRE(chunk);
+            uint64_t actual = hashChunk(*chunk, chunkSize);
+            INFO("Actual row: {" << golden.tileIndex << ", " << (golden.onBorder ? "true" : "false") << ", "
+                                 << hex(actual) << "},");
+            CHECK(actual == golden.hash);
+        }
+    }
+}
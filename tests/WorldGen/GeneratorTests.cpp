@@ -0,0 +1,37 @@
+#include <catch.hpp>
+#include <memory>
+#include <stdexcept>
+
+#include "../../src/Screens/WorldGen/Core/WorldGenParameters.h"
+#include "../../src/Screens/WorldGen/Generators/Generator.h"
+#include "../../src/Screens/WorldGen/Generators/Plate.h"
+#include "../../src/Screens/WorldGen/ProgressTracker.h"
+
+using namespace WorldGen;
+using namespace WorldGen::Generators;
+
+TEST_CASE("Generation refuses resolutions over the memory target", "[worldgen]") {
+    constexpr int kTargetMB = 4;
+    const int maxLevel = Generator::GetMaxSubdivisionLevel(kTargetMB);
+    REQUIRE(maxLevel >= 0);
+    REQUIRE(Generator::EstimatePeakMemoryBytes(maxLevel) <= kTargetMB * 1024 * 1024);
+    REQUIRE(Generator::EstimatePeakMemoryBytes(maxLevel + 1) > kTargetMB * 1024 * 1024);
+
+    PlanetParameters params;
+    params.peakMemoryTargetMB = kTargetMB;
+
+    SECTION("A level over the target is an error, not a coarser world") {
+        params.resolution = Generator::CalculateTileCount(maxLevel + 1);
+        REQUIRE(Generator::GetSubdivisionLevel(params.resolution) == maxLevel + 1);
+        REQUIRE_THROWS_AS(Generator::CreateWorld(params, 12345, std::make_shared<ProgressTracker>()),
+                          std::invalid_argument);
+    }
+
+    SECTION("The highest level that fits is generated as asked") {
+        params.resolution = Generator::CalculateTileCount(maxLevel);
+        auto world = Generator::CreateWorld(params, 12345, std::make_shared<ProgressTracker>());
+        REQUIRE(world);
+        // Subdividing n times gives 10 * 4^n + 2 tiles
+        REQUIRE(world->GetTileCount() == (static_cast<size_t>(10) << (2 * maxLevel)) + 2);
+    }
+}
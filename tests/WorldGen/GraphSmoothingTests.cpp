@@ -0,0 +1,52 @@
+#include <catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/Screens/WorldGen/Generators/GraphSmoothing.h"
+
+using namespace WorldGen::Generators;
+
+// World::SmoothTerrainData used to average each tile with its neighbours
+// directly; the kernel's default options must reproduce that exactly
+TEST_CASE("Default smoothing is the plain neighbour average", "[worldgen][smoothing]") {
+    constexpr size_t kTileCount = 20000;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> degree(0, 6);
+    std::uniform_int_distribution<int> neighbor(0, static_cast<int>(kTileCount) - 1);
+    std::uniform_real_distribution<float> mantissa(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> exponent(-12, 12);
+
+    TileAdjacency adjacency;
+    adjacency.offsets.push_back(0);
+    for (size_t i = 0; i < kTileCount; ++i) {
+        for (int n = degree(random); n > 0; --n) {
+            adjacency.neighbors.push_back(neighbor(random));
+        }
+        adjacency.offsets.push_back(static_cast<uint32_t>(adjacency.neighbors.size()));
+    }
+
+    // Values of very different magnitudes, where rounding shows up
+    std::vector<float> values(kTileCount);
+    for (float& value : values) {
+        value = std::ldexp(mantissa(random), exponent(random));
+    }
+
+    std::vector<float> expected(kTileCount);
+    for (size_t i = 0; i < kTileCount; ++i) {
+        float sum = values[i];
+        int count = 1;
+        for (int n : adjacency.GetNeighbors(i)) {
+            sum += values[n];
+            count++;
+        }
+        expected[i] = sum / count;
+    }
+
+    SmoothTileValues(adjacency, values);
+    for (size_t i = 0; i < kTileCount; ++i) {
+        INFO("Tile " << i);
+        REQUIRE(values[i] == expected[i]);
+    }
+}
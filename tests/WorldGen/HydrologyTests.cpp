@@ -0,0 +1,80 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../../src/Screens/WorldGen/Core/WorldGenParameters.h"
+#include "../../src/Screens/WorldGen/Generators/Generator.h"
+#include "../../src/Screens/WorldGen/Generators/Hydrology.h"
+#include "../../src/Screens/WorldGen/Generators/Plate.h"
+#include "../../src/Screens/WorldGen/ProgressTracker.h"
+
+using namespace WorldGen;
+using namespace WorldGen::Generators;
+
+TEST_CASE("Hydrology drains every land tile to the sea", "[worldgen][hydrology]") {
+    PlanetParameters params;
+    params.resolution = 10000;
+    auto world = Generator::CreateWorld(params, 12345, std::make_shared<ProgressTracker>());
+    REQUIRE(world);
+
+    const auto& tiles = world->GetTiles();
+    const HydrologyData& hydrology = world->GetHydrology();
+    const size_t tileCount = tiles.size();
+    REQUIRE(hydrology.flowDirection.size() == tileCount);
+    REQUIRE(hydrology.discharge.size() == tileCount);
+
+    const float seaLevel = params.physicalRadiusMeters;
+    size_t landTiles = 0;
+    size_t oceanTiles = 0;
+    for (const Tile& tile : tiles) {
+        (tile.GetElevation() < seaLevel ? oceanTiles : landTiles)++;
+    }
+    // Both invariants are vacuous on a world that is all land or all ocean
+    REQUIRE(landTiles > 0);
+    REQUIRE(oceanTiles > 0);
+
+    SECTION("Every receiver is a neighbor") {
+        for (size_t i = 0; i < tileCount; ++i) {
+            int receiver = hydrology.flowDirection[i];
+            if (receiver < 0) {
+                continue;
+            }
+            const auto& neighbors = tiles[i].GetNeighbors();
+            REQUIRE(std::find(neighbors.begin(), neighbors.end(), receiver) != neighbors.end());
+        }
+    }
+
+    SECTION("Following the flow from any land tile reaches the ocean without a cycle") {
+        // A walk longer than the tile count must revisit a tile
+        for (size_t i = 0; i < tileCount; ++i) {
+            int tile = static_cast<int>(i);
+            size_t steps = 0;
+            while (hydrology.flowDirection[tile] >= 0 && steps <= tileCount) {
+                tile = hydrology.flowDirection[tile];
+                steps++;
+            }
+            INFO("Flow from tile " << i << " ends at tile " << tile << " after " << steps << " steps");
+            REQUIRE(steps <= tileCount);
+            REQUIRE(tiles[tile].GetElevation() < seaLevel);
+        }
+    }
+
+    SECTION("Ocean outflow equals land runoff") {
+        // Each land tile contributes its moisture, and all of it ends up in
+        // the ocean tiles the rivers flow into
+        double runoff = 0.0;
+        double outflow = 0.0;
+        for (size_t i = 0; i < tileCount; ++i) {
+            if (hydrology.flowDirection[i] >= 0) {
+                runoff += tiles[i].GetMoisture();
+            } else {
+                outflow += hydrology.discharge[i];
+            }
+        }
+        REQUIRE(runoff > 0.0);
+        REQUIRE(outflow == Approx(runoff).epsilon(1e-4));
+    }
+}
@@ -0,0 +1,123 @@
+#include <catch.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "../../src/Screens/WorldGen/Generators/TaskGraph.h"
+
+using namespace WorldGen::Generators;
+
+// Run under ASan or TSan: a helper task still running (or not yet started)
+// after its ParallelFor returned would touch the phase's CPU account and
+// cancellation token after TaskGraph::Run freed them.
+TEST_CASE("Short parallel loops inside task graph phases", "[worldgen][parallel]") {
+    ThreadPool pool(3);
+    CancellationToken token;
+    CancellationScope cancellationScope(&token);
+
+    for (int run = 0; run < 200; ++run) {
+        std::vector<std::atomic<size_t>> sums(4);
+        TaskGraph graph;
+        TaskGraph::PhaseId first = graph.AddPhase("First", [&]() {
+            for (int loop = 0; loop < 20; ++loop) {
+                pool.ParallelFor(64, [&](size_t begin, size_t end) { sums[0].fetch_add(end - begin); }, nullptr, 1);
+            }
+        });
+        for (size_t phase = 1; phase < sums.size(); ++phase) {
+            graph.AddPhase("Dependent", [&, phase]() {
+                for (int loop = 0; loop < 20; ++loop) {
+                    pool.ParallelFor(64, [&](size_t begin, size_t end) { sums[phase].fetch_add(end - begin); }, nullptr, 1);
+                }
+            }, {first});
+        }
+        graph.Run(pool);
+
+        for (const auto& sum : sums) {
+            REQUIRE(sum.load() == 20 * 64);
+        }
+        REQUIRE(graph.GetTimings().size() == sums.size());
+    }
+}
+
+TEST_CASE("Parallel loops return only after every helper has exited", "[worldgen][parallel]") {
+    ThreadPool pool(3);
+    for (int loop = 0; loop < 2000; ++loop) {
+        // Nothing the loop queued may still be in the pool when it returns
+        pool.ParallelFor(8, [](size_t, size_t) {}, nullptr, 1);
+        REQUIRE_FALSE(pool.RunPendingTask());
+    }
+}
+
+TEST_CASE("Parallel float sums do not depend on the thread count", "[worldgen][parallel]") {
+    // Values spanning many magnitudes, so any change in summation order changes the result
+    std::vector<float> values(100000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<float>((i * 7919) % 1000) * (i % 3 == 0 ? 1e-3f : 1e3f);
+    }
+    auto sum = [&](ThreadPool& pool) {
+        return pool.ParallelReduce(values.size(), 0.0f, [&](size_t begin, size_t end, float& total) {
+            for (size_t i = begin; i < end; ++i) {
+                total += values[i];
+            }
+        }, [](float& total, float range) { total += range; }, nullptr, 256);
+    };
+
+    ThreadPool serial(0);
+    const float expected = sum(serial);
+    for (size_t workers : {1, 3, 7}) {
+        ThreadPool pool(workers);
+        for (int run = 0; run < 20; ++run) {
+            REQUIRE(sum(pool) == expected);
+        }
+    }
+}
+
+TEST_CASE("A throwing phase skips its dependents and is rethrown by Run", "[worldgen][parallel]") {
+    ThreadPool pool(3);
+    for (int run = 0; run < 200; ++run) {
+        std::atomic<bool> dependentRan{false};
+        std::atomic<bool> independentRan{false};
+        TaskGraph graph;
+        TaskGraph::PhaseId failing = graph.AddPhase("Failing", []() { throw std::runtime_error("phase failed"); });
+        TaskGraph::PhaseId dependent = graph.AddPhase("Dependent", [&]() { dependentRan = true; }, {failing});
+        graph.AddPhase("Downstream", [&]() { dependentRan = true; }, {dependent});
+        graph.AddPhase("Independent", [&]() {
+            pool.ParallelFor(64, [](size_t, size_t) {}, nullptr, 1);
+            independentRan = true;
+        });
+
+        REQUIRE_THROWS_WITH(graph.Run(pool), "phase failed");
+        REQUIRE_FALSE(dependentRan.load());
+        REQUIRE(independentRan.load());
+        REQUIRE_FALSE(pool.RunPendingTask());
+    }
+}
+
+TEST_CASE("A throwing parallel range is rethrown on the calling thread", "[worldgen][parallel]") {
+    ThreadPool pool(3);
+    for (int loop = 0; loop < 500; ++loop) {
+        std::atomic<size_t> ranges{0};
+        REQUIRE_THROWS_WITH(pool.ParallelFor(64, [&](size_t begin, size_t end) {
+            ranges++;
+            if (begin <= 32 && 32 < end) {
+                throw std::runtime_error("range failed");
+            }
+        }, nullptr, 1), "range failed");
+        // Nothing the loop queued may still be in the pool when it throws
+        REQUIRE(ranges.load() <= 64);
+        REQUIRE_FALSE(pool.RunPendingTask());
+    }
+
+    SECTION("Inside a task graph phase") {
+        TaskGraph graph;
+        graph.AddPhase("Looping", [&]() {
+            pool.ParallelFor(64, [](size_t begin, size_t end) {
+                if (begin <= 7 && 7 < end) {
+                    throw std::runtime_error("range failed");
+                }
+            }, nullptr, 1);
+        });
+        REQUIRE_THROWS_WITH(graph.Run(pool), "range failed");
+        REQUIRE_FALSE(pool.RunPendingTask());
+    }
+}
@@ -0,0 +1,160 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../src/Screens/WorldGen/Core/WorldGenParameters.h"
+#include "../../src/Screens/WorldGen/Generators/Generator.h"
+#include "../../src/Screens/WorldGen/Generators/Plate.h"
+#include "../../src/Screens/WorldGen/Generators/World.h"
+#include "../../src/Screens/WorldGen/Generators/WorldSnapshot.h"
+#include "../../src/Screens/WorldGen/ProgressTracker.h"
+
+using namespace WorldGen;
+using namespace WorldGen::Generators;
+
+namespace {
+
+std::string snapshotPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Overwrite entry index of a section with value
+template <typename T>
+void poke(std::vector<char>& bytes, WorldSnapshotSection section, size_t index, T value) {
+    WorldSnapshotHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const size_t offset = header.sectionOffsets[static_cast<size_t>(section)] + index * sizeof(T);
+    REQUIRE(offset + sizeof(T) <= bytes.size());
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+} // namespace
+
+TEST_CASE("World snapshots round-trip the generated world", "[worldgen][snapshot]") {
+    PlanetParameters params;
+    params.resolution = 1000;
+    params.distortionFactor = 0.1f;
+    params.distortionSeed = 42;
+    params.peakMemoryTargetMB = 2048;
+    auto world = Generator::CreateWorld(params, 12345, std::make_shared<ProgressTracker>());
+    REQUIRE(world);
+    REQUIRE_FALSE(world->GetHydrology().IsEmpty());
+
+    const std::string path = snapshotPath("colonysim_roundtrip.world");
+    REQUIRE(SaveWorldSnapshot(*world, params, path));
+    auto snapshot = MappedWorldSnapshot::Open(path);
+    REQUIRE(snapshot);
+    auto restored = CreateWorldFromSnapshot(*snapshot);
+    REQUIRE(restored);
+
+    const auto& tiles = world->GetTiles();
+    const auto& restoredTiles = restored->GetTiles();
+    REQUIRE(restoredTiles.size() == tiles.size());
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        REQUIRE(restoredTiles[i].GetElevation() == tiles[i].GetElevation());
+        REQUIRE(restoredTiles[i].GetMoisture() == tiles[i].GetMoisture());
+        REQUIRE(restoredTiles[i].GetPlateId() == tiles[i].GetPlateId());
+        // Exact, so a world loaded from a snapshot continues exactly like the original
+        REQUIRE(restoredTiles[i].GetCenter() == tiles[i].GetCenter());
+        const auto vertices = tiles[i].GetVertices();
+        const auto restoredVertices = restoredTiles[i].GetVertices();
+        REQUIRE(std::equal(vertices.begin(), vertices.end(), restoredVertices.begin(), restoredVertices.end()));
+    }
+
+    SECTION("Parameters survive the round trip") {
+        REQUIRE(snapshot->GetParameters() == params);
+    }
+
+    SECTION("Hydrology survives the round trip") {
+        const HydrologyData& original = world->GetHydrology();
+        const HydrologyData& loaded = restored->GetHydrology();
+        REQUIRE(loaded.flowDirection == original.flowDirection);
+        REQUIRE(loaded.discharge == original.discharge);
+        REQUIRE(loaded.lakeId == original.lakeId);
+        REQUIRE(loaded.waterSurface == original.waterSurface);
+        REQUIRE(loaded.lakeCount == original.lakeCount);
+    }
+
+    snapshot.reset();
+    std::filesystem::remove(path);
+}
+
+// The checksum is optional, so Open itself must reject files whose indices
+// would send CreateWorldFromSnapshot out of bounds
+TEST_CASE("Corrupted world snapshots are rejected", "[worldgen][snapshot]") {
+    PlanetParameters params;
+    params.resolution = 1000;
+    auto world = Generator::CreateWorld(params, 12345, std::make_shared<ProgressTracker>());
+    REQUIRE(world);
+
+    const std::string path = snapshotPath("colonysim_corrupted.world");
+    REQUIRE(SaveWorldSnapshot(*world, params, path));
+    const std::vector<char> original = readFile(path);
+    std::vector<char> bytes = original;
+    WorldSnapshotHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const int32_t tileCount = static_cast<int32_t>(header.tileCount);
+    REQUIRE(header.hydrologyTileCount == header.tileCount);
+
+    SECTION("Intact") {
+        REQUIRE(MappedWorldSnapshot::Open(path, false));
+    }
+    SECTION("Older format version") {
+        header.version = kWorldSnapshotVersion - 1;
+        std::memcpy(bytes.data(), &header, sizeof(header));
+    }
+    SECTION("Truncated") {
+        bytes.resize(bytes.size() - 64);
+    }
+    SECTION("Section past the end of the file") {
+        header.sectionOffsets[static_cast<size_t>(WorldSnapshotSection::Vertices)] = header.fileSize;
+        std::memcpy(bytes.data(), &header, sizeof(header));
+    }
+    SECTION("Neighbor offsets decreasing") {
+        poke<uint32_t>(bytes, WorldSnapshotSection::NeighborOffsets, 1, header.neighborCount);
+    }
+    SECTION("Vertex offsets not starting at zero") {
+        poke<uint32_t>(bytes, WorldSnapshotSection::VertexOffsets, 0, 1);
+    }
+    SECTION("Neighbor outside the tiles") {
+        poke<int32_t>(bytes, WorldSnapshotSection::Neighbors, 0, tileCount);
+    }
+    SECTION("Negative neighbor") {
+        poke<int32_t>(bytes, WorldSnapshotSection::Neighbors, 7, -1);
+    }
+    SECTION("Tile on a plate that does not exist") {
+        poke<int32_t>(bytes, WorldSnapshotSection::PlateIds, 0, static_cast<int32_t>(header.plateCount));
+    }
+    SECTION("Plate tile outside the tiles") {
+        poke<int32_t>(bytes, WorldSnapshotSection::PlateTileIds, 0, tileCount + 5);
+    }
+    SECTION("Flow into a tile that does not exist") {
+        poke<int32_t>(bytes, WorldSnapshotSection::FlowDirections, 0, tileCount);
+    }
+    SECTION("Lake that does not exist") {
+        poke<int32_t>(bytes, WorldSnapshotSection::LakeIds, 0, header.lakeCount);
+    }
+
+    if (bytes != original) {
+        writeFile(path, bytes);
+        REQUIRE_FALSE(MappedWorldSnapshot::Open(path, false));
+    }
+    std::filesystem::remove(path);
+}